@@ -0,0 +1,17 @@
+int Matrix[100];
+
+void main() {
+  int i, j, k;
+  for (i = 0; i < 10; i = i + 1) {
+    j = 0;
+    while (j < 10) {
+      k = i;
+      while (k > 0) {
+        Matrix[i * 10 + j] = Matrix[i * 10 + j] + k;
+        k = k - 1;
+      }
+      j = j + 1;
+    }
+  }
+  printf(Matrix[99]);
+}
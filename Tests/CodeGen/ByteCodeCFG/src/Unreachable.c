@@ -0,0 +1,17 @@
+int Sign(int n) {
+  if (n > 0) {
+    return (1);
+  } else {
+    if (n < 0) {
+      return (-1);
+    } else {
+      return (0);
+    }
+  }
+}
+
+void main() {
+  printf(Sign(-5));
+  return;
+  printf("unreachable");
+}
@@ -1,7 +1,7 @@
 
    0: "string"
-   2: "\n\r\a\f\v\\\'"
    1: ""
+   2: "\n\r\a\f\v\\\'"
 
 main:
 0   LOAD_STRING              0         
@@ -1,6 +1,6 @@
 
-   1: "string "
    0: "string"
+   1: "string "
 
 test1:
 SymbolEntry(charvar, Variable, Local, Location(2, 7))
@@ -0,0 +1,6 @@
+void main() {
+  int I;
+  I = 7;
+  scanf(I);
+  printf("Read ", I);
+}
@@ -0,0 +1,12 @@
+int Divide(int a, int b) {
+  return (a / b);
+}
+
+void main() {
+  int zero;
+  zero = 0;
+  printf("Expect 3: ", Divide(7, 2) + 0);
+  printf("Expect an error");
+  printf(Divide(7, zero));
+  printf("Not printed");
+}
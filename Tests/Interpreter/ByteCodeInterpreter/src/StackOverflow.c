@@ -0,0 +1,14 @@
+int Depth;
+
+void Recurse(int n) {
+  int Locals[100];
+  Locals[0] = n;
+  Depth = n;
+  Recurse(n + 1);
+}
+
+void main() {
+  printf("Expect an error");
+  Recurse(0);
+  printf("Not printed");
+}
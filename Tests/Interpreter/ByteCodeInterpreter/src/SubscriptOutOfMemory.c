@@ -0,0 +1,11 @@
+int Array[10];
+
+void main() {
+  int i;
+  i = 9;
+  Array[i] = 1;
+  printf("Expect 1: ", Array[i]);
+  i = 100000000;
+  Array[i] = 2;
+  printf("Not printed");
+}
@@ -2,11 +2,11 @@
 # Global objects
 
 # String literals
-string_4: .asciiz "Expect b: "
-string_3: .asciiz "Expect a: "
-string_2: .asciiz "Expect 2: "
 string_0: .asciiz "Dump Arguments:"
 string_1: .asciiz "Expect 1: "
+string_2: .asciiz "Expect 2: "
+string_3: .asciiz "Expect a: "
+string_4: .asciiz "Expect b: "
 # End of data segment
 
 .text
@@ -18,202 +18,77 @@ syscall
 # User defined functions
 testargumentpassing:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
-
-# Passing Arguments
-lw $t0, 16 ($fp)
-sw $t0, 0 ($sp)
-lw $t0, 12 ($fp)
-sw $t0, -4 ($sp)
-lw $t0, 8 ($fp)
-sw $t0, -8 ($sp)
-lw $t0, 4 ($fp)
-sw $t0, -12 ($sp)
-
-# Make room for local objects
-addiu $sp, $sp, -16
+lw $t2, 0($sp)
+lw $t3, 4($sp)
+lw $t4, 8($sp)
+lw $t5, 12($sp)
 
-# LOAD_STRING
-la $t0, string_0
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+testargumentpassing_label_0:
+la $a0, string_0
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_1
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_LOCAL
-lw $t0, -8 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $a0, $t2
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_2
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_LOCAL
-lw $t0, -12 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $a0, $t3
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_3
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_3
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_LOCAL
-lw $t0, -16 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_CHARACTER
+move $a0, $t4
 li $v0, 11
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_4
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_4
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_LOCAL
-lw $t0, -20 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_CHARACTER
+move $a0, $t5
 li $v0, 11
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# RETURN_NONE
-j testargumentpassing_return
-
 # Epilogue
 testargumentpassing_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
 jr $ra
 
 main:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
+addiu $sp, $sp, -20
+sw $ra, 16($sp)
 
-# LOAD_CONST
+main_label_0:
 li $t0, 1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 0($sp)
 li $t0, 2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 4($sp)
 li $t0, 97
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 8($sp)
 li $t0, 98
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $t0, 12($sp)
 jal testargumentpassing
-addiu $sp, $sp 16
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# POP_TOP
-addiu $sp, $sp, 4
-
-# RETURN_NONE
-j main_return
-
 # Epilogue
 main_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
+lw $ra, 16($sp)
+addiu $sp, $sp, 20
 jr $ra
 
 # End of text segment
@@ -2,10 +2,10 @@
 # Global objects
 
 # String literals
-string_3: .asciiz "Expect 10: "
-string_2: .asciiz "Expect 6: "
 string_0: .asciiz "Expect 1: "
 string_1: .asciiz "Expect 3: "
+string_2: .asciiz "Expect 6: "
+string_3: .asciiz "Expect 10: "
 # End of data segment
 
 .text
@@ -17,404 +17,151 @@ syscall
 # User defined functions
 function_1:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
-
-# Passing Arguments
-lw $t0, 4 ($fp)
-sw $t0, 0 ($sp)
-
-# Make room for local objects
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -8 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# RETURN_VALUE
-addiu $sp, $sp, 4
-lw $v0 , 0($sp)
-j function_1_return
-
-# RETURN_NONE
-j function_1_return
+lw $t2, 0($sp)
 
+function_1_label_0:
+move $v0, $t2
 # Epilogue
 function_1_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
 jr $ra
 
 function_2:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
 addiu $sp, $sp, -8
+sw $ra, 4($sp)
+lw $t2, 8($sp)
+lw $t3, 12($sp)
 
-# Passing Arguments
-lw $t0, 8 ($fp)
-sw $t0, 0 ($sp)
-lw $t0, 4 ($fp)
-sw $t0, -4 ($sp)
-
-# Make room for local objects
-addiu $sp, $sp, -8
-
-# LOAD_LOCAL
-lw $t0, -8 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+function_2_label_0:
+sw $t2, 0($sp)
 jal function_1
-addiu $sp, $sp 4
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -12 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# BINARY_ADD
-addiu $sp, $sp, 4
-lw $t0 , 0($sp)
-addiu $sp, $sp, 4
-lw $t1 , 0($sp)
-addu $t2, $t1, $t0
-sw $t2 , 0($sp)
-addiu $sp, $sp, -4
-
-# RETURN_VALUE
-addiu $sp, $sp, 4
-lw $v0 , 0($sp)
-j function_2_return
-
-# RETURN_NONE
-j function_2_return
-
+move $t2, $v0
+addu $t2, $t2, $t3
+move $v0, $t2
 # Epilogue
 function_2_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
+lw $ra, 4($sp)
+addiu $sp, $sp, 8
 jr $ra
 
 function_3:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
-
-# Passing Arguments
-lw $t0, 12 ($fp)
-sw $t0, 0 ($sp)
-lw $t0, 8 ($fp)
-sw $t0, -4 ($sp)
-lw $t0, 4 ($fp)
-sw $t0, -8 ($sp)
-
-# Make room for local objects
 addiu $sp, $sp, -12
-
-# LOAD_LOCAL
-lw $t0, -8 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -12 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $ra, 8($sp)
+lw $t2, 12($sp)
+lw $t3, 16($sp)
+lw $t4, 20($sp)
+
+function_3_label_0:
+sw $t2, 0($sp)
+sw $t3, 4($sp)
 jal function_2
-addiu $sp, $sp 8
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -16 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# BINARY_ADD
-addiu $sp, $sp, 4
-lw $t0 , 0($sp)
-addiu $sp, $sp, 4
-lw $t1 , 0($sp)
-addu $t2, $t1, $t0
-sw $t2 , 0($sp)
-addiu $sp, $sp, -4
-
-# RETURN_VALUE
-addiu $sp, $sp, 4
-lw $v0 , 0($sp)
-j function_3_return
-
-# RETURN_NONE
-j function_3_return
-
+move $t2, $v0
+addu $t2, $t2, $t4
+move $v0, $t2
 # Epilogue
 function_3_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
+lw $ra, 8($sp)
+addiu $sp, $sp, 12
 jr $ra
 
 function_4:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
-
-# Passing Arguments
-lw $t0, 16 ($fp)
-sw $t0, 0 ($sp)
-lw $t0, 12 ($fp)
-sw $t0, -4 ($sp)
-lw $t0, 8 ($fp)
-sw $t0, -8 ($sp)
-lw $t0, 4 ($fp)
-sw $t0, -12 ($sp)
-
-# Make room for local objects
 addiu $sp, $sp, -16
-
-# LOAD_LOCAL
-lw $t0, -8 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -12 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -16 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $ra, 12($sp)
+lw $t2, 16($sp)
+lw $t3, 20($sp)
+lw $t4, 24($sp)
+lw $t5, 28($sp)
+
+function_4_label_0:
+sw $t2, 0($sp)
+sw $t3, 4($sp)
+sw $t4, 8($sp)
 jal function_3
-addiu $sp, $sp 12
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_LOCAL
-lw $t0, -20 ($fp)
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# BINARY_ADD
-addiu $sp, $sp, 4
-lw $t0 , 0($sp)
-addiu $sp, $sp, 4
-lw $t1 , 0($sp)
-addu $t2, $t1, $t0
-sw $t2 , 0($sp)
-addiu $sp, $sp, -4
-
-# RETURN_VALUE
-addiu $sp, $sp, 4
-lw $v0 , 0($sp)
-j function_4_return
-
-# RETURN_NONE
-j function_4_return
-
+move $t2, $v0
+addu $t2, $t2, $t5
+move $v0, $t2
 # Epilogue
 function_4_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
+lw $ra, 12($sp)
+addiu $sp, $sp, 16
 jr $ra
 
 main:
 # Prologue
-sw $ra, 0($sp)
-sw $fp, -4($sp)
-move $fp, $sp
-addiu $sp, $sp, -8
-
-# LOAD_STRING
-la $t0, string_0
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
+addiu $sp, $sp, -20
+sw $ra, 16($sp)
 
-# PRINT_STRING
+main_label_0:
+la $a0, string_0
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_CONST
 li $t0, 1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $t0, 0($sp)
 jal function_1
-addiu $sp, $sp 4
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $t2, $v0
+move $a0, $t2
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_1
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_CONST
 li $t0, 1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 0($sp)
 li $t0, 2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $t0, 4($sp)
 jal function_2
-addiu $sp, $sp 8
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $t2, $v0
+move $a0, $t2
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_2
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_CONST
 li $t0, 1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 0($sp)
 li $t0, 2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 4($sp)
 li $t0, 3
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $t0, 8($sp)
 jal function_3
-addiu $sp, $sp 12
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $t2, $v0
+move $a0, $t2
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# LOAD_STRING
-la $t0, string_3
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_STRING
+la $a0, string_3
 li $v0, 4
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# LOAD_CONST
 li $t0, 1
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 0($sp)
 li $t0, 2
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 4($sp)
 li $t0, 3
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# LOAD_CONST
+sw $t0, 8($sp)
 li $t0, 4
-sw $t0 , 0($sp)
-addiu $sp, $sp, -4
-
-# CALL_FUNCTION
+sw $t0, 12($sp)
 jal function_4
-addiu $sp, $sp 16
-sw $v0 , 0($sp)
-addiu $sp, $sp, -4
-
-# PRINT_INTEGER
+move $t2, $v0
+move $a0, $t2
 li $v0, 1
-addiu $sp, $sp, 4
-lw $a0 , 0($sp)
 syscall
-
-# PRINT_NEWLINE
 li $a0, 10
 li $v0, 11
 syscall
-
-# RETURN_NONE
-j main_return
-
 # Epilogue
 main_return:
-lw $ra, 0($fp)
-move $sp, $fp
-lw $fp, -4($fp)
+lw $ra, 16($sp)
+addiu $sp, $sp, 20
 jr $ra
 
 # End of text segment
@@ -0,0 +1,176 @@
+.data
+# Global objects
+
+# String literals
+string_0: .asciiz "Expect 4: "
+string_1: .asciiz "Expect 9: "
+string_2: .asciiz "Expect 55: "
+string_3: .asciiz "Expect 385: "
+# End of data segment
+
+.text
+.globl main
+jal main
+li $v0, 10
+syscall
+
+# User defined functions
+square:
+# Prologue
+lw $t2, 0($sp)
+
+square_label_0:
+addiu $t3, $t2, 1
+addiu $t4, $t2, 2
+addiu $t5, $t2, 3
+mul $t2, $t2, $t2
+addu $t2, $t2, $t3
+subu $t2, $t2, $t3
+addu $t2, $t2, $t4
+subu $t2, $t2, $t4
+addu $t2, $t2, $t5
+subu $t2, $t2, $t5
+move $v0, $t2
+# Epilogue
+square_return:
+jr $ra
+
+main:
+# Prologue
+addiu $sp, $sp, -48
+sw $ra, 44($sp)
+sw $s0, 12($sp)
+sw $s1, 16($sp)
+sw $s2, 20($sp)
+sw $s3, 24($sp)
+sw $s4, 28($sp)
+sw $s5, 32($sp)
+sw $s6, 36($sp)
+sw $s7, 40($sp)
+
+main_label_0:
+li $s0, 1
+li $s1, 2
+li $s2, 3
+li $s3, 4
+li $s4, 5
+li $s5, 6
+li $s6, 7
+li $s7, 8
+li $t0, 9
+sw $t0, 4($sp)
+li $t0, 10
+sw $t0, 8($sp)
+la $a0, string_0
+li $v0, 4
+syscall
+li $t0, 2
+sw $t0, 0($sp)
+jal square
+move $t2, $v0
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_1
+li $v0, 4
+syscall
+li $t0, 3
+sw $t0, 0($sp)
+jal square
+move $t2, $v0
+addu $t2, $t2, $s0
+subu $t2, $t2, $s0
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_2
+li $v0, 4
+syscall
+addu $t2, $s0, $s1
+addu $t2, $t2, $s2
+addu $t2, $t2, $s3
+addu $t2, $t2, $s4
+addu $t2, $t2, $s5
+addu $t2, $t2, $s6
+addu $t2, $t2, $s7
+lw $t1, 4($sp)
+addu $t2, $t2, $t1
+lw $t1, 8($sp)
+addu $t2, $t2, $t1
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_3
+li $v0, 4
+syscall
+sw $s0, 0($sp)
+jal square
+move $s0, $v0
+sw $s1, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s2, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s3, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s4, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s5, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s6, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+sw $s7, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+lw $t0, 4($sp)
+sw $t0, 0($sp)
+jal square
+move $t2, $v0
+addu $s0, $s0, $t2
+lw $t0, 8($sp)
+sw $t0, 0($sp)
+jal square
+move $t2, $v0
+addu $t2, $s0, $t2
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+# Epilogue
+main_return:
+lw $s0, 12($sp)
+lw $s1, 16($sp)
+lw $s2, 20($sp)
+lw $s3, 24($sp)
+lw $s4, 28($sp)
+lw $s5, 32($sp)
+lw $s6, 36($sp)
+lw $s7, 40($sp)
+lw $ra, 44($sp)
+addiu $sp, $sp, 48
+jr $ra
+
+# End of text segment
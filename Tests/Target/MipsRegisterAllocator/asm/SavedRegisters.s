@@ -0,0 +1,128 @@
+.data
+# Global objects
+
+# String literals
+string_0: .asciiz "Expect 55: "
+string_1: .asciiz "Expect 210: "
+string_2: .asciiz "Expect 30: "
+# End of data segment
+
+.text
+.globl main
+jal main
+li $v0, 10
+syscall
+
+# User defined functions
+fibonacci:
+# Prologue
+addiu $sp, $sp, -16
+sw $ra, 12($sp)
+sw $s0, 4($sp)
+sw $s1, 8($sp)
+lw $s0, 16($sp)
+
+fibonacci_label_0:
+li $t1, 2
+bge $s0, $t1, fibonacci_label_2
+fibonacci_label_1:
+move $v0, $s0
+j fibonacci_return
+fibonacci_label_2:
+addiu $t2, $s0, -1
+sw $t2, 0($sp)
+jal fibonacci
+move $s1, $v0
+addiu $t2, $s0, -2
+sw $t2, 0($sp)
+jal fibonacci
+move $t2, $v0
+addu $t2, $s1, $t2
+move $v0, $t2
+# Epilogue
+fibonacci_return:
+lw $s0, 4($sp)
+lw $s1, 8($sp)
+lw $ra, 12($sp)
+addiu $sp, $sp, 16
+jr $ra
+
+sum:
+# Prologue
+addiu $sp, $sp, -12
+sw $ra, 8($sp)
+sw $s0, 4($sp)
+lw $s0, 12($sp)
+
+sum_label_0:
+bne $s0, $zero, sum_label_2
+sum_label_1:
+li $v0, 0
+j sum_return
+sum_label_2:
+addiu $t2, $s0, -1
+sw $t2, 0($sp)
+jal sum
+move $t2, $v0
+addu $t2, $s0, $t2
+move $v0, $t2
+# Epilogue
+sum_return:
+lw $s0, 4($sp)
+lw $ra, 8($sp)
+addiu $sp, $sp, 12
+jr $ra
+
+main:
+# Prologue
+addiu $sp, $sp, -16
+sw $ra, 12($sp)
+sw $s0, 4($sp)
+sw $s1, 8($sp)
+
+main_label_0:
+li $s0, 10
+li $s1, 20
+la $a0, string_0
+li $v0, 4
+syscall
+sw $s0, 0($sp)
+jal fibonacci
+move $t2, $v0
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_1
+li $v0, 4
+syscall
+sw $s1, 0($sp)
+jal sum
+move $t2, $v0
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_2
+li $v0, 4
+syscall
+addu $t2, $s0, $s1
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+# Epilogue
+main_return:
+lw $s0, 4($sp)
+lw $s1, 8($sp)
+lw $ra, 12($sp)
+addiu $sp, $sp, 16
+jr $ra
+
+# End of text segment
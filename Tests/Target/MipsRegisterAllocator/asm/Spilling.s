@@ -0,0 +1,200 @@
+.data
+# Global objects
+
+# String literals
+string_0: .asciiz "Expect 210: "
+string_1: .asciiz "Expect 2870: "
+string_2: .asciiz "Expect 29: "
+# End of data segment
+
+.text
+.globl main
+jal main
+li $v0, 10
+syscall
+
+# User defined functions
+main:
+# Prologue
+addiu $sp, $sp, -56
+sw $s0, 24($sp)
+sw $s1, 28($sp)
+sw $s2, 32($sp)
+sw $s3, 36($sp)
+sw $s4, 40($sp)
+sw $s5, 44($sp)
+sw $s6, 48($sp)
+sw $s7, 52($sp)
+
+main_label_0:
+li $t0, 1
+sw $t0, 0($sp)
+li $t0, 2
+sw $t0, 4($sp)
+li $t0, 3
+sw $t0, 8($sp)
+li $t0, 4
+sw $t0, 16($sp)
+li $t0, 5
+sw $t0, 20($sp)
+li $t7, 6
+li $t8, 7
+li $t9, 8
+li $s0, 9
+li $s1, 10
+li $s2, 11
+li $s3, 12
+li $s4, 13
+li $s5, 14
+li $s6, 15
+li $s7, 16
+li $t2, 17
+li $t3, 18
+li $t4, 19
+li $t0, 20
+sw $t0, 12($sp)
+la $a0, string_0
+li $v0, 4
+syscall
+lw $t0, 0($sp)
+lw $t1, 4($sp)
+addu $t5, $t0, $t1
+lw $t1, 8($sp)
+addu $t5, $t5, $t1
+lw $t1, 16($sp)
+addu $t5, $t5, $t1
+lw $t1, 20($sp)
+addu $t5, $t5, $t1
+addu $t5, $t5, $t7
+addu $t5, $t5, $t8
+addu $t5, $t5, $t9
+addu $t5, $t5, $s0
+addu $t5, $t5, $s1
+addu $t5, $t5, $s2
+addu $t5, $t5, $s3
+addu $t5, $t5, $s4
+addu $t5, $t5, $s5
+addu $t5, $t5, $s6
+addu $t5, $t5, $s7
+addu $t5, $t5, $t2
+addu $t5, $t5, $t3
+addu $t5, $t5, $t4
+lw $t1, 12($sp)
+addu $t5, $t5, $t1
+move $a0, $t5
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_1
+li $v0, 4
+syscall
+lw $t0, 0($sp)
+lw $t1, 0($sp)
+mul $t5, $t0, $t1
+lw $t0, 4($sp)
+lw $t1, 4($sp)
+mul $t6, $t0, $t1
+addu $t5, $t5, $t6
+lw $t0, 8($sp)
+lw $t1, 8($sp)
+mul $t6, $t0, $t1
+addu $t5, $t5, $t6
+lw $t0, 16($sp)
+lw $t1, 16($sp)
+mul $t6, $t0, $t1
+addu $t5, $t5, $t6
+lw $t0, 20($sp)
+lw $t1, 20($sp)
+mul $t6, $t0, $t1
+addu $t5, $t5, $t6
+mul $t6, $t7, $t7
+addu $t5, $t5, $t6
+mul $t6, $t8, $t8
+addu $t5, $t5, $t6
+mul $t6, $t9, $t9
+addu $t5, $t5, $t6
+mul $t6, $s0, $s0
+addu $t5, $t5, $t6
+mul $t6, $s1, $s1
+addu $t5, $t5, $t6
+mul $t6, $s2, $s2
+addu $t5, $t5, $t6
+mul $t6, $s3, $s3
+addu $t5, $t5, $t6
+mul $t6, $s4, $s4
+addu $t5, $t5, $t6
+mul $t6, $s5, $s5
+addu $t5, $t5, $t6
+mul $t6, $s6, $s6
+addu $t5, $t5, $t6
+mul $t6, $s7, $s7
+addu $t5, $t5, $t6
+mul $t6, $t2, $t2
+addu $t5, $t5, $t6
+mul $t6, $t3, $t3
+addu $t5, $t5, $t6
+mul $t6, $t4, $t4
+addu $t5, $t5, $t6
+lw $t0, 12($sp)
+lw $t1, 12($sp)
+mul $t6, $t0, $t1
+addu $t5, $t5, $t6
+move $a0, $t5
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+la $a0, string_2
+li $v0, 4
+syscall
+lw $t0, 12($sp)
+subu $t4, $t0, $t4
+addu $t3, $t4, $t3
+subu $t2, $t3, $t2
+addu $t2, $t2, $s7
+subu $t2, $t2, $s6
+addu $t2, $t2, $s5
+subu $t2, $t2, $s4
+addu $t2, $t2, $s3
+subu $t2, $t2, $s2
+addu $t2, $t2, $s1
+subu $t2, $t2, $s0
+addu $t2, $t2, $t9
+subu $t2, $t2, $t8
+addu $t2, $t2, $t7
+lw $t1, 20($sp)
+subu $t2, $t2, $t1
+lw $t1, 16($sp)
+addu $t2, $t2, $t1
+lw $t1, 8($sp)
+subu $t2, $t2, $t1
+lw $t1, 4($sp)
+addu $t2, $t2, $t1
+lw $t1, 0($sp)
+subu $t2, $t2, $t1
+lw $t1, 12($sp)
+addu $t2, $t2, $t1
+addiu $t2, $t2, -1
+move $a0, $t2
+li $v0, 1
+syscall
+li $a0, 10
+li $v0, 11
+syscall
+# Epilogue
+main_return:
+lw $s0, 24($sp)
+lw $s1, 28($sp)
+lw $s2, 32($sp)
+lw $s3, 36($sp)
+lw $s4, 40($sp)
+lw $s5, 44($sp)
+lw $s6, 48($sp)
+lw $s7, 52($sp)
+addiu $sp, $sp, 56
+jr $ra
+
+# End of text segment
@@ -0,0 +1,27 @@
+int Square(int x) {
+  int a, b, c;
+  a = x + 1;
+  b = x + 2;
+  c = x + 3;
+  return (x * x + a - a + b - b + c - c);
+}
+
+void main() {
+  int a, b, c, d, e, f, g, h, i, j;
+  a = 1;
+  b = 2;
+  c = 3;
+  d = 4;
+  e = 5;
+  f = 6;
+  g = 7;
+  h = 8;
+  i = 9;
+  j = 10;
+  printf("Expect 4: ", Square(2));
+  printf("Expect 9: ", Square(3) + a - a);
+  printf("Expect 55: ", a + b + c + d + e + f + g + h + i + j);
+  printf("Expect 385: ", Square(a) + Square(b) + Square(c) + Square(d) +
+                             Square(e) + Square(f) + Square(g) + Square(h) +
+                             Square(i) + Square(j));
+}
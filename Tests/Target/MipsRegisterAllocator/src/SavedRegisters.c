@@ -0,0 +1,27 @@
+int Fibonacci(int n) {
+  int x, y;
+  if (n < 2) {
+    return (n);
+  }
+  x = Fibonacci(n - 1);
+  y = Fibonacci(n - 2);
+  return (x + y);
+}
+
+int Sum(int n) {
+  int Result;
+  if (n == 0) {
+    return (0);
+  }
+  Result = n + Sum(n - 1);
+  return (Result);
+}
+
+void main() {
+  int k, l;
+  k = 10;
+  l = 20;
+  printf("Expect 55: ", Fibonacci(k));
+  printf("Expect 210: ", Sum(l));
+  printf("Expect 30: ", k + l);
+}
@@ -0,0 +1,31 @@
+void main() {
+  int a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t;
+  a = 1;
+  b = 2;
+  c = 3;
+  d = 4;
+  e = 5;
+  f = 6;
+  g = 7;
+  h = 8;
+  i = 9;
+  j = 10;
+  k = 11;
+  l = 12;
+  m = 13;
+  n = 14;
+  o = 15;
+  p = 16;
+  q = 17;
+  r = 18;
+  s = 19;
+  t = 20;
+  printf("Expect 210: ", a + b + c + d + e + f + g + h + i + j + k + l + m + n
+                         + o + p + q + r + s + t);
+  printf("Expect 2870: ", a * a + b * b + c * c + d * d + e * e + f * f
+                          + g * g + h * h + i * i + j * j + k * k + l * l
+                          + m * m + n * n + o * o + p * p + q * q + r * r
+                          + s * s + t * t);
+  printf("Expect 29: ", t - s + r - q + p - o + n - m + l - k + j - i + h - g
+                        + f - e + d - c + b - a + t - 1);
+}
@@ -0,0 +1,128 @@
+/// @file Benchmark of the passes that walk the AST with a visitor.
+/// It parses and analyses one input once and then runs each pass over the
+/// same AST a number of times, printing the average time of one walk.
+/// Usage: simplecc-visitor-benchmark <file> [iterations]
+#include "simplecc/AST/ASTVerifier.h"
+#include "simplecc/AST/ChildrenVisitor.h"
+#include "simplecc/Analysis/AnalysisManager.h"
+#include "simplecc/Analysis/ArrayBoundChecker.h"
+#include "simplecc/Analysis/TypeChecker.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/CodeGen/CodeGen.h"
+#include "simplecc/Lex/Lexer.h"
+#include "simplecc/Lex/SourceBuffer.h"
+#include "simplecc/Parse/Parse.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+
+using namespace simplecc;
+
+namespace {
+/// Visit every node and do nothing else, which measures the dispatch alone.
+class NodeCounter : ChildrenVisitor<NodeCounter> {
+  friend class ChildrenVisitor<NodeCounter>;
+  friend class VisitorBase<NodeCounter>;
+  size_t NumNodes = 0;
+
+  void visitDecl(DeclAST *D) {
+    ++NumNodes;
+    ChildrenVisitor::visitDecl(D);
+  }
+  void visitStmt(StmtAST *S) {
+    ++NumNodes;
+    ChildrenVisitor::visitStmt(S);
+  }
+  void visitExpr(ExprAST *E) {
+    ++NumNodes;
+    ChildrenVisitor::visitExpr(E);
+  }
+
+public:
+  size_t Count(ProgramAST *P) {
+    NumNodes = 0;
+    visitProgram(P);
+    return NumNodes;
+  }
+};
+
+/// A streambuf that throws away everything written to it.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int C) override { return C; }
+  std::streamsize xsputn(const char *, std::streamsize N) override {
+    return N;
+  }
+};
+
+/// Run Fn Iterations times and print the average time of one run.
+void Measure(const char *Name, unsigned Iterations,
+             const std::function<void()> &Fn) {
+  using Clock = std::chrono::steady_clock;
+  auto Start = Clock::now();
+  for (unsigned I = 0; I < Iterations; ++I)
+    Fn();
+  std::chrono::duration<double, std::milli> Elapsed = Clock::now() - Start;
+  std::cout << std::left << std::setw(20) << Name << std::right
+            << std::fixed << std::setprecision(2) << std::setw(10)
+            << Elapsed.count() / Iterations << " ms\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <file> [iterations]\n";
+    return 1;
+  }
+  std::string Filename(argv[1]);
+  unsigned Iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+  if (Iterations == 0)
+    Iterations = 1;
+
+  SourceBuffer Source;
+  if (Source.ReadFile(Filename)) {
+    std::cerr << "Cannot read " << Filename << "\n";
+    return 1;
+  }
+  Lexer L(Source);
+  auto Program = BuildAST(Filename, L);
+  if (!Program)
+    return 1;
+  AnalysisManager AM;
+  if (AM.runAllAnalyses(Program.get()))
+    return 1;
+  ProgramAST *P = Program.get();
+  SymbolTable &S = AM.getSymbolTable();
+
+  std::cout << "Nodes: " << NodeCounter().Count(P)
+            << ", iterations: " << Iterations << "\n";
+
+  Measure("ChildrenVisitor", Iterations, [P]() { NodeCounter().Count(P); });
+  Measure("ASTVerifier", Iterations, [P]() { ASTVerifier().Check(P); });
+  Measure("TypeChecker", Iterations,
+          [P, &S]() { TypeChecker().Check(P, S); });
+  Measure("ArrayBoundChecker", Iterations,
+          [P, &S]() { ArrayBoundChecker().Check(P, S); });
+  NullBuffer Null;
+  std::ostream NullStream(&Null);
+  Measure("ASTPrettyPrinter", Iterations,
+          [P, &NullStream]() { PrettyPrintAST(*P, NullStream); });
+  Measure("ByteCodeCompiler", Iterations, [P, &S]() {
+    ByteCodeModule M;
+    CompileToByteCode(P, S, M);
+  });
+
+  // All the analyses, as separate passes and fused.
+  Measure("SeparateAnalyses", Iterations, [P]() {
+    AnalysisManager Separate;
+    Separate.setFusedAnalysis(false);
+    Separate.runAllAnalyses(P);
+  });
+  Measure("FusedAnalyses", Iterations,
+          [P]() { AnalysisManager().runAllAnalyses(P); });
+  return 0;
+}
@@ -6,9 +6,12 @@
 #define SIMPLECC_AST_AST_H
 #include "simplecc/Support/Macros.h"
 #include "simplecc/Lex/Location.h"
+#include "simplecc/AST/ASTContext.h"
 #include "simplecc/AST/Enums.h"
+#include "simplecc/Support/Identifier.h"
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -34,9 +37,10 @@ namespace simplecc {
 /// list to others.
 /// Both of the above may also support rvalue-getter on the their expression children that
 /// again transfers ownership.
-/// AST nodes are created on the heap and referenced mostly via pointer (if not via reference). Each instance of
-/// an AST owns their children unless they get stolen. Use deleteAST() to dispose them or
-/// better, use the specialized version of ``std::unique_ptr`` -- UniquePtrToAST.
+/// AST nodes are created in the ASTContext of their ProgramAST and referenced mostly via pointer (if not via
+/// reference). Each instance of an AST owns their children unless they get stolen. Use deleteAST() to dispose them
+/// or better, use the specialized version of ``std::unique_ptr`` -- UniquePtrToAST. Disposing a node runs its
+/// destructor while its memory is released together with the ASTContext.
 class AST {
   unsigned SubclassID;
   Location Loc;
@@ -48,6 +52,17 @@ protected:
   /// Protected. Use deleteAST() instead.
   ~AST() = default;
 public:
+  /// Create an AST node in an ASTContext, like ``new (Context) NumExpr(...)``.
+  void *operator new(size_t Bytes, ASTContext &C) {
+    return C.Allocate(Bytes, alignof(std::max_align_t));
+  }
+  /// Only called when a constructor throws. The memory belongs to the ASTContext.
+  void operator delete(void *, ASTContext &) noexcept {}
+  /// Called by deleteAST() after the destructor. The memory belongs to the ASTContext.
+  void operator delete(void *) noexcept {}
+  /// Nodes can only be created in an ASTContext.
+  void *operator new(size_t) = delete;
+
   enum ASTKind : unsigned {
 #define HANDLE_AST(CLASS) CLASS##Kind,
 #include "AST.def"
@@ -111,18 +126,18 @@ class DeclAST : public AST {
   /// Declaration always has a type.
   BasicTypeKind Type;
   /// Declaration always has a name.
-  std::string Name;
+  Identifier Name;
 
 protected:
   /// Protected, use subclass constructors.
-  DeclAST(unsigned int Kind, BasicTypeKind Ty, std::string name, Location loc)
-      : AST(Kind, loc), Type(Ty), Name(std::move(name)) {}
+  DeclAST(unsigned int Kind, BasicTypeKind Ty, Identifier name, Location loc)
+      : AST(Kind, loc), Type(Ty), Name(name) {}
   /// Return the type of this declaration.
   BasicTypeKind getType() const { return Type; }
   void setType(BasicTypeKind Ty) { Type = Ty; }
 public:
   /// Return the name of this declaration.
-  const std::string &getName() const &{ return Name; }
+  Identifier getName() const { return Name; }
   static bool InstanceCheck(const AST *A);
 };
 
@@ -140,6 +155,11 @@ public:
 
 /// This is the base class for all expression nodes.
 class ExprAST : public AST {
+  /// The type recorded by type checking, valid if HasType is true.
+  /// Both fit in the padding after AST so the nodes don't grow.
+  unsigned char Type = 0;
+  bool HasType = false;
+
 protected:
   /// Protected, use subclass constructors.
   ExprAST(unsigned Kind, Location loc) : AST(Kind, loc) {}
@@ -157,6 +177,9 @@ protected:
   }
 
 public:
+  /// The symbol slot of a name that is not resolved yet.
+  static constexpr unsigned NoSymbolSlot = ~0U;
+
   /// Return true if this node is mostly a literal value and can be evaluated to int
   /// What is mostly a literal value?
   /// 1. CharExpr or NumExpr.
@@ -173,6 +196,20 @@ public:
   /// Return true if this is constant one.
   bool isOneVal() const { return isConstant() && 1 == getConstantValue(); }
 
+  /// Return true if the type of this expression has been recorded.
+  /// Nodes created after type checking have no type recorded.
+  bool hasType() const { return HasType; }
+  /// Return the type recorded by type checking.
+  BasicTypeKind getType() const {
+    assert(HasType && "Type not recorded");
+    return static_cast<BasicTypeKind>(Type);
+  }
+  /// Record the type of this expression, which is done by type checking.
+  void setType(BasicTypeKind Ty) {
+    Type = static_cast<unsigned char>(Ty);
+    HasType = true;
+  }
+
   static bool InstanceCheck(const AST *A);
 };
 
@@ -184,7 +221,7 @@ class ConstDecl : public DeclAST {
   ~ConstDecl() = default;
 
 public:
-  ConstDecl(BasicTypeKind type, std::string name, ExprAST *value, Location loc);
+  ConstDecl(BasicTypeKind type, Identifier name, ExprAST *value, Location loc);
   ConstDecl(const ConstDecl &) = delete;
   ConstDecl(ConstDecl &&) = default;
 
@@ -211,7 +248,7 @@ class VarDecl : public DeclAST {
   ~VarDecl() = default;
 
 public:
-  VarDecl(BasicTypeKind Type, std::string Name, bool isArray, int size, Location loc);
+  VarDecl(BasicTypeKind Type, Identifier Name, bool isArray, int size, Location loc);
   VarDecl(const VarDecl &) = delete;
   VarDecl(VarDecl &&) = default;
 
@@ -237,7 +274,7 @@ public:
 
   FuncDef(BasicTypeKind return_type, std::vector<ArgDecl *> args,
           std::vector<DeclAST *> decls, StmtListType stmts,
-          std::string name, Location loc);
+          Identifier name, Location loc);
   FuncDef(const FuncDef &) = delete;
   FuncDef(FuncDef &&) = default;
 
@@ -288,7 +325,7 @@ class ArgDecl : public DeclAST {
   ~ArgDecl() = default;
 
 public:
-  ArgDecl(BasicTypeKind type, std::string name, Location loc);
+  ArgDecl(BasicTypeKind type, Identifier name, Location loc);
   ArgDecl(const ArgDecl &) = delete;
   ArgDecl(ArgDecl &&) = default;
 
@@ -640,18 +677,26 @@ public:
 
 /// This class represents a call expression.
 class CallExpr : public ExprAST {
-  std::string Callee;
+  Identifier Callee;
+  unsigned SymbolSlot = NoSymbolSlot;
   std::vector<ExprAST *> Args;
   friend class AST;
   ~CallExpr() { DeleteAST::apply(Args); }
 
 public:
-  CallExpr(std::string func, std::vector<ExprAST *> args, Location loc);
+  CallExpr(Identifier func, std::vector<ExprAST *> args, Location loc);
   CallExpr(const CallExpr &) = delete;
   CallExpr(CallExpr &&) = default;
 
   /// Return the name of function being called.
-  const std::string &getCallee() const { return Callee; }
+  Identifier getCallee() const { return Callee; }
+  /// Return the slot of the callee in the local symbol table.
+  unsigned getSymbolSlot() const {
+    assert(SymbolSlot != NoSymbolSlot && "Unresolved name");
+    return SymbolSlot;
+  }
+  /// Set the slot of the callee, which is done by name resolution.
+  void setSymbolSlot(unsigned Slot) { SymbolSlot = Slot; }
   /// Return the actual arguments passed to the function.
   const std::vector<ExprAST *> &getArgs() const { return Args; }
   std::vector<ExprAST *> &getArgs() { return Args; }
@@ -742,19 +787,27 @@ public:
 
 /// This class represents a subscript expression.
 class SubscriptExpr : public ExprAST {
-  std::string ArrayName;
+  Identifier ArrayName;
+  unsigned SymbolSlot = NoSymbolSlot;
   std::unique_ptr<ExprAST, DeleteAST> Index;
   ExprContextKind Context;
   ~SubscriptExpr() = default;
   friend class AST;
 
 public:
-  SubscriptExpr(std::string name, ExprAST *index, ExprContextKind ctx, Location loc);
+  SubscriptExpr(Identifier name, ExprAST *index, ExprContextKind ctx, Location loc);
   SubscriptExpr(const SubscriptExpr &) = delete;
   SubscriptExpr(SubscriptExpr &&) = default;
 
   /// Return the name of the array.
-  const std::string &getArrayName() const { return ArrayName; }
+  Identifier getArrayName() const { return ArrayName; }
+  /// Return the slot of the array in the local symbol table.
+  unsigned getSymbolSlot() const {
+    assert(SymbolSlot != NoSymbolSlot && "Unresolved name");
+    return SymbolSlot;
+  }
+  /// Set the slot of the array, which is done by name resolution.
+  void setSymbolSlot(unsigned Slot) { SymbolSlot = Slot; }
   /// Return the expression context.
   ExprContextKind getContext() const { return Context; }
   /// Return the index expression.
@@ -771,18 +824,26 @@ public:
 
 /// This class represents a name expression, which is effectively an identifier.
 class NameExpr : public ExprAST {
-  std::string TheName;
+  Identifier TheName;
+  unsigned SymbolSlot = NoSymbolSlot;
   ExprContextKind context;
   ~NameExpr() = default;
   friend class AST;
 
 public:
-  NameExpr(std::string id, ExprContextKind ctx, Location loc);
+  NameExpr(Identifier id, ExprContextKind ctx, Location loc);
   NameExpr(const NameExpr &) = delete;
   NameExpr(NameExpr &&) = default;
 
   /// Return the value of this name.
-  const std::string &getName() const { return TheName; }
+  Identifier getName() const { return TheName; }
+  /// Return the slot of this name in the local symbol table.
+  unsigned getSymbolSlot() const {
+    assert(SymbolSlot != NoSymbolSlot && "Unresolved name");
+    return SymbolSlot;
+  }
+  /// Set the slot of this name, which is done by name resolution.
+  void setSymbolSlot(unsigned Slot) { SymbolSlot = Slot; }
   /// Return the expression context of this name.
   ExprContextKind getContext() const { return context; }
 
@@ -793,16 +854,26 @@ public:
 
 /// This class represents the whole program as the top level AST node.
 class ProgramAST : public AST {
+  /// Declared first so that it is destroyed after the Decls it owns.
+  std::unique_ptr<ASTContext> Context;
   std::string Filename;
   std::vector<DeclAST *> Decls;
   friend class AST;
   ~ProgramAST() { DeleteAST::apply(Decls); }
 
 public:
-  ProgramAST(std::string Filename, std::vector<DeclAST *> decls);
+  /// ProgramAST owns its ASTContext so it cannot live inside it.
+  void *operator new(size_t Bytes) { return ::operator new(Bytes); }
+  void operator delete(void *Ptr) noexcept { ::operator delete(Ptr); }
+
+  ProgramAST(std::string Filename, std::vector<DeclAST *> decls,
+             std::unique_ptr<ASTContext> Context);
   ProgramAST(const ProgramAST &) = delete;
   ProgramAST(ProgramAST &&) = default;
 
+  /// Return the ASTContext that owns all the nodes of this program.
+  ASTContext &getContext() const { return *Context; }
+
   /// Return the declaration list.
   const std::vector<DeclAST *> &getDecls() const { return Decls; }
   std::vector<DeclAST *> &getDecls() { return Decls; }
@@ -0,0 +1,46 @@
+#ifndef SIMPLECC_AST_ASTCONTEXT_H
+#define SIMPLECC_AST_ASTCONTEXT_H
+#include "simplecc/Support/BumpPtrAllocator.h"
+#include <cstddef>
+
+namespace simplecc {
+/// This class owns the memory of all the nodes of a ProgramAST.
+/// Nodes are created in it with ``new (Context) NumExpr(...)``, which is
+/// a pointer bump. Deleting a node only runs its destructor, and the memory
+/// of all the nodes is released at once when the context is destroyed.
+/// The ProgramAST owns its context, so transforms that create new nodes
+/// can reach it through ProgramAST::getContext().
+class ASTContext {
+public:
+  ASTContext() = default;
+  ASTContext(const ASTContext &) = delete;
+  ASTContext &operator=(const ASTContext &) = delete;
+
+  /// Return memory for a node of Bytes bytes.
+  void *Allocate(size_t Bytes, size_t Alignment) {
+    ++NumNodes;
+    return Allocator.Allocate(Bytes, Alignment);
+  }
+
+  /// Take over the nodes of another context, which becomes empty.
+  /// A context is not thread-safe, so threads that create nodes do so in
+  /// contexts of their own, which are adopted by the program's afterwards.
+  void Adopt(ASTContext &Other) {
+    Allocator.Adopt(Other.Allocator);
+    NumNodes += Other.NumNodes;
+    Other.NumNodes = 0;
+  }
+
+  /// Return the number of nodes created in this context.
+  size_t getNumNodes() const { return NumNodes; }
+
+  /// Return the number of bytes used by the nodes.
+  size_t getBytesAllocated() const { return Allocator.getBytesAllocated(); }
+
+private:
+  BumpPtrAllocator Allocator;
+  size_t NumNodes = 0;
+};
+} // namespace simplecc
+
+#endif // SIMPLECC_AST_ASTCONTEXT_H
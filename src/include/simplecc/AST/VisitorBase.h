@@ -2,6 +2,7 @@
 #define SIMPLECC_AST_VISITORBASE_H
 #include "simplecc/AST/AST.h"
 #include "simplecc/Support/Casting.h"
+#include <cassert>
 
 namespace simplecc {
 
@@ -29,102 +30,112 @@ public:
 };
 
 // Methods of VisitorBase.
+// Each of them switches on the kind of the node, which compiles to a jump table,
+// so the cost of dispatch does not depend on the position of the subclass.
 template <typename Derived>
 template <typename RetTy>
 RetTy VisitorBase<Derived>::visitDecl(DeclAST *D) {
-  if (auto x = subclass_cast<ConstDecl>(D)) {
-    return static_cast<Derived *>(this)->visitConstDecl(x);
+  switch (D->getKind()) {
+  case AST::ConstDeclKind:
+    return static_cast<Derived *>(this)->visitConstDecl(
+        static_cast<ConstDecl *>(D));
+  case AST::VarDeclKind:
+    return static_cast<Derived *>(this)->visitVarDecl(
+        static_cast<VarDecl *>(D));
+  case AST::FuncDefKind:
+    return static_cast<Derived *>(this)->visitFuncDef(
+        static_cast<FuncDef *>(D));
+  case AST::ArgDeclKind:
+    return static_cast<Derived *>(this)->visitArgDecl(
+        static_cast<ArgDecl *>(D));
+  default:
+    assert(false && "Unhandled DeclAST subclasses");
   }
-  if (auto x = subclass_cast<VarDecl>(D)) {
-    return static_cast<Derived *>(this)->visitVarDecl(x);
-  }
-  if (auto x = subclass_cast<FuncDef>(D)) {
-    return static_cast<Derived *>(this)->visitFuncDef(x);
-  }
-  if (auto x = subclass_cast<ArgDecl>(D)) {
-    return static_cast<Derived *>(this)->visitArgDecl(x);
-  }
-  assert(false && "Unhandled DeclAST subclasses");
 }
 
 template <typename Derived>
 template <typename RetTy>
 RetTy VisitorBase<Derived>::visitStmt(StmtAST *S) {
-  if (auto x = subclass_cast<ReadStmt>(S)) {
-    return static_cast<Derived *>(this)->visitRead(x);
-  }
-  if (auto x = subclass_cast<WriteStmt>(S)) {
-    return static_cast<Derived *>(this)->visitWrite(x);
-  }
-  if (auto x = subclass_cast<AssignStmt>(S)) {
-    return static_cast<Derived *>(this)->visitAssign(x);
-  }
-  if (auto x = subclass_cast<ForStmt>(S)) {
-    return static_cast<Derived *>(this)->visitFor(x);
-  }
-  if (auto x = subclass_cast<WhileStmt>(S)) {
-    return static_cast<Derived *>(this)->visitWhile(x);
-  }
-  if (auto x = subclass_cast<ReturnStmt>(S)) {
-    return static_cast<Derived *>(this)->visitReturn(x);
-  }
-  if (auto x = subclass_cast<IfStmt>(S)) {
-    return static_cast<Derived *>(this)->visitIf(x);
-  }
-  if (auto x = subclass_cast<ExprStmt>(S)) {
-    return static_cast<Derived *>(this)->visitExprStmt(x);
+  switch (S->getKind()) {
+  case AST::ReadStmtKind:
+    return static_cast<Derived *>(this)->visitRead(static_cast<ReadStmt *>(S));
+  case AST::WriteStmtKind:
+    return static_cast<Derived *>(this)->visitWrite(
+        static_cast<WriteStmt *>(S));
+  case AST::AssignStmtKind:
+    return static_cast<Derived *>(this)->visitAssign(
+        static_cast<AssignStmt *>(S));
+  case AST::ForStmtKind:
+    return static_cast<Derived *>(this)->visitFor(static_cast<ForStmt *>(S));
+  case AST::WhileStmtKind:
+    return static_cast<Derived *>(this)->visitWhile(
+        static_cast<WhileStmt *>(S));
+  case AST::ReturnStmtKind:
+    return static_cast<Derived *>(this)->visitReturn(
+        static_cast<ReturnStmt *>(S));
+  case AST::IfStmtKind:
+    return static_cast<Derived *>(this)->visitIf(static_cast<IfStmt *>(S));
+  case AST::ExprStmtKind:
+    return static_cast<Derived *>(this)->visitExprStmt(
+        static_cast<ExprStmt *>(S));
+  default:
+    assert(false && "Unhandled StmtAST subclasses");
   }
-  assert(false && "Unhandled StmtAST subclasses");
 }
 
 template <typename Derived>
 template <typename RetTy>
 RetTy VisitorBase<Derived>::visitExpr(ExprAST *E) {
-  if (auto x = subclass_cast<BinOpExpr>(E)) {
-    return static_cast<Derived *>(this)->visitBinOp(x);
+  switch (E->getKind()) {
+  case AST::BinOpExprKind:
+    return static_cast<Derived *>(this)->visitBinOp(
+        static_cast<BinOpExpr *>(E));
+  case AST::ParenExprKind:
+    return static_cast<Derived *>(this)->visitParenExpr(
+        static_cast<ParenExpr *>(E));
+  case AST::BoolOpExprKind:
+    return static_cast<Derived *>(this)->visitBoolOp(
+        static_cast<BoolOpExpr *>(E));
+  case AST::UnaryOpExprKind:
+    return static_cast<Derived *>(this)->visitUnaryOp(
+        static_cast<UnaryOpExpr *>(E));
+  case AST::CallExprKind:
+    return static_cast<Derived *>(this)->visitCall(static_cast<CallExpr *>(E));
+  case AST::NumExprKind:
+    return static_cast<Derived *>(this)->visitNum(static_cast<NumExpr *>(E));
+  case AST::StrExprKind:
+    return static_cast<Derived *>(this)->visitStr(static_cast<StrExpr *>(E));
+  case AST::CharExprKind:
+    return static_cast<Derived *>(this)->visitChar(static_cast<CharExpr *>(E));
+  case AST::SubscriptExprKind:
+    return static_cast<Derived *>(this)->visitSubscript(
+        static_cast<SubscriptExpr *>(E));
+  case AST::NameExprKind:
+    return static_cast<Derived *>(this)->visitName(static_cast<NameExpr *>(E));
+  default:
+    assert(false && "Unhandled ExprAST subclasses");
   }
-  if (auto x = subclass_cast<ParenExpr>(E)) {
-    return static_cast<Derived *>(this)->visitParenExpr(x);
-  }
-  if (auto x = subclass_cast<BoolOpExpr>(E)) {
-    return static_cast<Derived *>(this)->visitBoolOp(x);
-  }
-  if (auto x = subclass_cast<UnaryOpExpr>(E)) {
-    return static_cast<Derived *>(this)->visitUnaryOp(x);
-  }
-  if (auto x = subclass_cast<CallExpr>(E)) {
-    return static_cast<Derived *>(this)->visitCall(x);
-  }
-  if (auto x = subclass_cast<NumExpr>(E)) {
-    return static_cast<Derived *>(this)->visitNum(x);
-  }
-  if (auto x = subclass_cast<StrExpr>(E)) {
-    return static_cast<Derived *>(this)->visitStr(x);
-  }
-  if (auto x = subclass_cast<CharExpr>(E)) {
-    return static_cast<Derived *>(this)->visitChar(x);
-  }
-  if (auto x = subclass_cast<SubscriptExpr>(E)) {
-    return static_cast<Derived *>(this)->visitSubscript(x);
-  }
-  if (auto x = subclass_cast<NameExpr>(E)) {
-    return static_cast<Derived *>(this)->visitName(x);
-  }
-  assert(false && "Unhandled ExprAST subclasses");
 }
 
 template <typename Derived>
 template <typename RetTy>
 RetTy VisitorBase<Derived>::visitAST(AST *A) {
-  if (auto x = subclass_cast<ProgramAST>(A))
-    return static_cast<Derived *>(this)->visitProgram(x);
-  if (auto x = subclass_cast<DeclAST>(A))
-    return visitDecl<RetTy>(x);
-  if (auto x = subclass_cast<StmtAST>(A))
-    return visitStmt<RetTy>(x);
-  if (auto x = subclass_cast<ExprAST>(A))
-    return visitExpr<RetTy>(x);
-  assert(false && "Unhandled AST subclasses");
+  switch (A->getKind()) {
+  case AST::ProgramASTKind:
+    return static_cast<Derived *>(this)->visitProgram(
+        static_cast<ProgramAST *>(A));
+#define HANDLE_DECL(CLASS) case AST::CLASS##Kind:
+#include "simplecc/AST/AST.def"
+    return visitDecl<RetTy>(static_cast<DeclAST *>(A));
+#define HANDLE_STMT(CLASS) case AST::CLASS##Kind:
+#include "simplecc/AST/AST.def"
+    return visitStmt<RetTy>(static_cast<StmtAST *>(A));
+#define HANDLE_EXPR(CLASS) case AST::CLASS##Kind:
+#include "simplecc/AST/AST.def"
+    return visitExpr<RetTy>(static_cast<ExprAST *>(A));
+  default:
+    assert(false && "Unhandled AST subclasses");
+  }
 }
 } // namespace simplecc
 #endif //SIMPLECC_AST_VISITORBASE_H
@@ -7,10 +7,24 @@
 // TODO: this class sounds very silly.
 
 namespace simplecc {
+class ThreadPool;
+class TimeReport;
+
 /// @brief AnalysisManager hides the details of all analyses and provides a simple
 /// interface to run all analyses on a program.
 class AnalysisManager {
   SymbolTable TheTable;
+  bool FusedAnalysis = true;
+  ThreadPool *ThePool = nullptr;
+  TimeReport *Report = nullptr;
+
+  /// Run FusedAnalyzer, in parallel if there is a ThreadPool.
+  /// Return true if errors happened.
+  bool runFusedAnalyzer(ProgramAST *P);
+
+  /// Run SymbolTableBuilder, ImplicitCallTransformer, TypeChecker and
+  /// ArrayBoundChecker one after another. Return true if errors happened.
+  bool runSeparateAnalyses(ProgramAST *P);
 
 public:
   AnalysisManager() = default;
@@ -20,6 +34,18 @@ public:
   /// Return true if errors happened.
   bool runAllAnalyses(ProgramAST *P);
 
+  /// Set whether to run the analyses in one traversal with FusedAnalyzer.
+  /// The diagnostics are the same either way. The default is true.
+  void setFusedAnalysis(bool Fused) { FusedAnalysis = Fused; }
+  bool isFusedAnalysis() const { return FusedAnalysis; }
+
+  /// Set a ThreadPool to analyze the functions in parallel, or nullptr.
+  /// Only the fused analysis runs in parallel.
+  void setThreadPool(ThreadPool *Pool) { ThePool = Pool; }
+
+  /// Set a TimeReport to time each analysis in, or nullptr.
+  void setTimeReport(TimeReport *R) { Report = R; }
+
   /// Return the symbol table backing the analyses.
   const SymbolTable &getSymbolTable() const { return TheTable; }
 
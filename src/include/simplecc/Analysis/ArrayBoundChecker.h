@@ -19,13 +19,16 @@ class ArrayBoundChecker : AnalysisVisitor<ArrayBoundChecker> {
   friend AnalysisVisitor;
   friend ChildrenVisitor;
   friend VisitorBase;
-  std::pair<bool, int> getIndex(ExprAST *E) const;
   void visitSubscript(SubscriptExpr *SB);
 
 public:
   ArrayBoundChecker() = default;
   /// Perform the check.
   using AnalysisVisitor::Check;
+
+  /// Return the value of an index if it is a simple constant expression.
+  /// The first of the pair is false if it is not.
+  static std::pair<bool, int> getIndex(ExprAST *E, LocalSymbolTable Local);
 };
 } // namespace simplecc
 
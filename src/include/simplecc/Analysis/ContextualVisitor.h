@@ -30,9 +30,14 @@ protected:
     return *TheTable;
   }
 
-  /// Return the SymbolEntry for an name.
-  SymbolEntry getSymbolEntry(const std::string &Name) const {
-    return TheLocalTable[Name];
+  /// Return the LocalSymbolTable of the FuncDef being visited.
+  LocalSymbolTable getLocalTable() const { return TheLocalTable; }
+
+  /// Return the SymbolEntry a NameExpr, CallExpr or SubscriptExpr
+  /// has been resolved to.
+  template <typename NodeT>
+  const SymbolEntry &getSymbolEntry(const NodeT *N) const {
+    return TheLocalTable[N];
   }
 
 public:
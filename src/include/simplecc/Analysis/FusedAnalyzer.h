@@ -0,0 +1,105 @@
+#ifndef SIMPLECC_ANALYSIS_FUSEDANALYZER_H
+#define SIMPLECC_ANALYSIS_FUSEDANALYZER_H
+#include "simplecc/Analysis/SymbolTable.h"
+#include "simplecc/AST/ChildrenVisitor.h"
+#include <utility>
+
+namespace simplecc {
+class ThreadPool;
+
+/// @brief FusedAnalyzer does the work of SymbolTableBuilder, ImplicitCallTransformer,
+/// TypeChecker and ArrayBoundChecker in a single traversal of the program.
+///
+/// Names are resolved in the same order as SymbolTableBuilder does, so the SymbolTable
+/// is identical to the one built by it. Each expression is resolved, rewritten and typed
+/// bottom-up in the same visit, and the implicit calls are rewritten at the same places
+/// as ImplicitCallTransformer does.
+///
+/// FusedAnalyzer reports no diagnostics. It only finds out whether the program has any
+/// error. Errors are rare, so AnalysisManager then runs the separate passes, which report
+/// exactly the same diagnostics as they do without it. Since the rewriting only happens
+/// where a name resolves to a function, running the separate passes again on the same AST
+/// is safe. Being conservative is fine: an error that the passes don't agree on only
+/// costs another run of them.
+class FusedAnalyzer : ChildrenVisitor<FusedAnalyzer> {
+  void visitProgram(ProgramAST *P);
+  void visitDecl(DeclAST *D);
+  void DefineLocalDecl(DeclAST *D);
+  void DefineGlobalDecl(DeclAST *D);
+  /// Analyze the body of a function whose local table is TheLocal.
+  /// Only the first NumGlobals globals are visible to it.
+  void AnalyzeFunction(FuncDef *FD, unsigned NumGlobals);
+  /// Return the slot of a global visible to the current function, or -1.
+  int getVisibleGlobalSlot(Identifier Name) const;
+  /// Return the slot of a name in the local table, or -1 if it is undefined.
+  int ResolveName(Identifier Name);
+
+  void visitRead(ReadStmt *RD);
+  void visitWrite(WriteStmt *W);
+  void visitAssign(AssignStmt *A);
+  void visitFor(ForStmt *F);
+  void visitWhile(WhileStmt *W);
+  void visitReturn(ReturnStmt *R);
+  void visitIf(IfStmt *I);
+  void visitExprStmt(ExprStmt *ES);
+
+  /// Resolve, rewrite and type an expression where a name of a function
+  /// is an implicit call. Return the expression that takes its place and
+  /// set Type to its type.
+  ExprAST *TransformExpr(ExprAST *E, BasicTypeKind &Type);
+  /// Same as TransformExpr() but require the type not to be void.
+  ExprAST *TransformOperand(ExprAST *E);
+
+  /// Resolve and type an expression that is not rewritten itself.
+  /// The type is recorded in the node as TypeChecker does.
+  BasicTypeKind visitExpr(ExprAST *E) {
+    auto Ty = VisitorBase::visitExpr<BasicTypeKind>(E);
+    E->setType(Ty);
+    return Ty;
+  }
+  BasicTypeKind visitBinOp(BinOpExpr *B);
+  BasicTypeKind visitBoolOp(BoolOpExpr *B);
+  BasicTypeKind visitUnaryOp(UnaryOpExpr *U);
+  BasicTypeKind visitParenExpr(ParenExpr *PE);
+  BasicTypeKind visitCall(CallExpr *C);
+  BasicTypeKind visitSubscript(SubscriptExpr *SB);
+  BasicTypeKind visitName(NameExpr *N);
+  /// Return the type of a NameExpr that has been resolved.
+  BasicTypeKind getNameType(NameExpr *N);
+  BasicTypeKind visitNum(NumExpr *) { return BasicTypeKind::Int; }
+  BasicTypeKind visitChar(CharExpr *) { return BasicTypeKind::Character; }
+  BasicTypeKind visitStr(StrExpr *) { return BasicTypeKind::Void; }
+
+  /// Record that the program has an error.
+  void setError() { HasError = true; }
+
+public:
+  FusedAnalyzer() = default;
+
+  /// Build the SymbolTable of a program, rewrite its implicit calls and
+  /// check it. Return true if errors happened.
+  /// Note: the table will be cleared first.
+  bool Analyze(ProgramAST *P, SymbolTable &S);
+
+  /// Same as above but analyze the functions in parallel on a ThreadPool.
+  /// The globals are defined first, and then each function is analyzed
+  /// in a task of its own, seeing only the globals defined before it.
+  bool Analyze(ProgramAST *P, SymbolTable &S, ThreadPool &Pool);
+
+private:
+  friend VisitorBase;
+  friend ChildrenVisitor;
+
+  SymbolTable *TheTable = nullptr;
+  TableType *TheGlobal = nullptr;
+  TableType *TheLocal = nullptr;
+  LocalSymbolTable TheLocalTable;
+  /// The number of globals the current function can see.
+  unsigned NumVisibleGlobals = 0;
+  FuncDef *TheFuncDef = nullptr;
+  /// The explicit calls are created in the context of the program.
+  ASTContext *TheContext = nullptr;
+  bool HasError = false;
+};
+} // namespace simplecc
+#endif // SIMPLECC_ANALYSIS_FUSEDANALYZER_H
@@ -55,6 +55,8 @@ private:
 
   LocalSymbolTable TheLocalTable;
   const SymbolTable *TheTable;
+  /// The explicit calls are created in the context of the program.
+  ASTContext *TheContext = nullptr;
 };
 } // namespace simplecc
 #endif // SIMPLECC_ANALYSIS_IMPLICITCALLTRANSFORMER_H
\ No newline at end of file
@@ -5,16 +5,67 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace simplecc {
 class SymbolTableBuilder;
-using TableType = std::unordered_map<std::string, SymbolEntry>;
+
+/// @brief TableType holds the symbols of a block (global or local) in a
+/// dense vector in the order of definition. The index of a SymbolEntry is
+/// its slot. Names are mapped to slots once when the table is built, and
+/// NameExpr, CallExpr and SubscriptExpr record the slot they resolve to,
+/// so that later passes look them up by index.
+class TableType {
+public:
+  using const_iterator = std::vector<SymbolEntry>::const_iterator;
+
+  /// Return the slot of a name, or -1 if it is not defined.
+  int getSlot(Identifier Name) const {
+    auto Iter = Slots.find(Name);
+    return Iter == Slots.end() ? -1 : static_cast<int>(Iter->second);
+  }
+
+  /// Return if a name is defined.
+  bool count(Identifier Name) const { return Slots.count(Name); }
+
+  /// Define a name that is not defined yet and return its slot.
+  unsigned insert(Identifier Name, SymbolEntry Entry) {
+    assert(!count(Name) && "Redefinition");
+    unsigned Slot = static_cast<unsigned>(Entries.size());
+    Entries.push_back(Entry);
+    Slots.emplace(Name, Slot);
+    return Slot;
+  }
+
+  /// Return the SymbolEntry at a slot.
+  const SymbolEntry &operator[](unsigned Slot) const {
+    assert(Slot < Entries.size() && "Invalid slot");
+    return Entries[Slot];
+  }
+
+  /// Return the SymbolEntry of a defined name.
+  const SymbolEntry &operator[](Identifier Name) const {
+    assert(count(Name) && "Undefined Name");
+    return Entries[Slots.find(Name)->second];
+  }
+
+  /// Return the number of symbols.
+  size_t size() const { return Entries.size(); }
+
+  const_iterator begin() const { return Entries.begin(); }
+  const_iterator end() const { return Entries.end(); }
+
+private:
+  std::vector<SymbolEntry> Entries;
+  std::unordered_map<Identifier, unsigned> Slots;
+};
 
 /// @brief LocalSymbolTable provides a readonly view to a local symbol table.
 /// It overloads the ``operator[]`` to provide readonly access to SymbolEntry
 /// and prevents lookup failure by assertion.
 class LocalSymbolTable {
   friend class SymbolTable;
+  friend class ByteCodeFile;
   const TableType *TheTable;
   explicit LocalSymbolTable(const TableType &T) : TheTable(&T) {}
 
@@ -28,9 +79,23 @@ public:
   LocalSymbolTable &operator=(const LocalSymbolTable &) = default;
 
   /// Return the SymbolEntry for a name.
-  SymbolEntry operator[](const std::string &Name) const;
+  const SymbolEntry &operator[](Identifier Name) const {
+    return (*TheTable)[Name];
+  }
+
+  /// Return the SymbolEntry a resolved name refers to.
+  /// These only index the table.
+  const SymbolEntry &operator[](const NameExpr *N) const {
+    return (*TheTable)[N->getSymbolSlot()];
+  }
+  const SymbolEntry &operator[](const CallExpr *C) const {
+    return (*TheTable)[C->getSymbolSlot()];
+  }
+  const SymbolEntry &operator[](const SubscriptExpr *SB) const {
+    return (*TheTable)[SB->getSymbolSlot()];
+  }
 
-  /// Readonly iterator interface.
+  /// Readonly iterator interface over the SymbolEntry's.
   using const_iterator = TableType::const_iterator;
   const_iterator begin() const { return TheTable->begin(); }
   const_iterator end() const { return TheTable->end(); }
@@ -50,21 +115,27 @@ public:
   LocalSymbolTable getLocalTable(const FuncDef *FD) const;
 
   /// Return a SymbolEntry for a global name.
-  SymbolEntry getGlobalEntry(const std::string &Name) const;
+  const SymbolEntry &getGlobalEntry(Identifier Name) const {
+    return GlobalTable[Name];
+  }
 
   void Format(std::ostream &O) const;
 
 private:
   TableType GlobalTable;
-  std::unordered_map<const FuncDef *, TableType> LocalTables;
+  /// Local tables in the order of the functions.
+  std::vector<std::pair<const FuncDef *, TableType>> LocalTables;
+  /// Map a function to the index of its local table.
+  std::unordered_map<const FuncDef *, unsigned> LocalTableIndices;
 
   friend class SymbolTableBuilder;
+  friend class FusedAnalyzer;
   /// Return the global table to be populate.
   TableType &getGlobal() { return GlobalTable; }
   /// Create or Return a local table to be populate.
-  TableType &getLocal(FuncDef *FD) { return LocalTables[FD]; }
+  TableType &getLocal(const FuncDef *FD);
 };
 
 DEFINE_INLINE_OUTPUT_OPERATOR(SymbolTable)
 } // namespace simplecc
-#endif // SIMPLECC_ANALYSIS_SYMBOLTABLE_H
\ No newline at end of file
+#endif // SIMPLECC_ANALYSIS_SYMBOLTABLE_H
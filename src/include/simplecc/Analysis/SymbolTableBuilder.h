@@ -21,10 +21,13 @@ class SymbolTableBuilder : ChildrenVisitor<SymbolTableBuilder> {
   void visitDecl(DeclAST *D);
 
   /// Overloads to visit AstNodes that have names.
-  void visitName(NameExpr *N) { ResolveName(N->getName(), N->getLocation()); }
+  /// Each of them records the slot its name resolves to.
+  void visitName(NameExpr *N);
   void visitCall(CallExpr *C);
   void visitSubscript(SubscriptExpr *SB);
-  void ResolveName(const std::string &Name, Location L);
+  /// Return the slot of a name in the local table, or -1 if it is undefined.
+  /// A global name is added to the local table the first time it is used.
+  int ResolveName(Identifier Name, Location L);
 
   /// Trivial setters for important states during the construction
   /// of a table.
@@ -25,6 +25,7 @@ class TypeChecker : AnalysisVisitor<TypeChecker> {
   BasicTypeKind visitName(NameExpr *N);
 
   /// Return the type of evaluating the expression.
+  /// The type is recorded in the node for later passes.
   BasicTypeKind visitExpr(ExprAST *E);
   BasicTypeKind visitNum(NumExpr *) { return BasicTypeKind::Int; }
   BasicTypeKind visitChar(CharExpr *) { return BasicTypeKind::Character; }
@@ -87,6 +87,8 @@ public:
   ~TypeEvaluator() = default;
 
   /// @brief Return the type of an ExprAST.
+  /// The type recorded by type checking is returned if there is one, so
+  /// only nodes created after type checking are evaluated.
   BasicTypeKind getExprType(const ExprAST *E) const;
 
   /// @brief getExprType is a helper that saves the construction of a TypeEvaluator.
@@ -102,7 +102,7 @@ public:
   /// Return the location where this name is declared.
   Location getLocation() const;
   /// Return the value of this name.
-  const std::string &getName() const;
+  Identifier getName() const;
 
   /// Return the Scope of this name.
   Scope getScope() const { return TheScope; }
@@ -1,22 +1,34 @@
 #ifndef SIMPLECC_CODEGEN_BYTECODE_H
 #define SIMPLECC_CODEGEN_BYTECODE_H
+#include "simplecc/Support/Identifier.h"
 #include "simplecc/Support/Macros.h"
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 namespace simplecc {
 /// @brief ByteCode is the primary intermediate representation (IR) of simplecc.
-/// A ByteCode instance consists of an Opcode, an optional integer operand and an optional cstring operand.
+/// A ByteCode instance consists of an Opcode, an optional integer operand and an optional name operand.
 ///
 /// Different Opcode demands different number and type of operands. For example, the ``JUMP_FORWARD`` Opcode
-/// demands a int operand as its jump target. The ``LOAD_GLOBAL`` Opcode demands a cstring operand as its name.
+/// demands a int operand as its jump target. The ``LOAD_GLOBAL`` Opcode demands a name operand, which is an Identifier.
 /// Those properties about operands can be obtained by calling hasIntOperand(), hasStrOperand() and hasNoOperand() member functions.
 /// If an Opcode demands a certain operands, one can get and set these operands by the calling the Operand accessors.
 /// Otherwise, calling accessors on ByteCode that does not has a certain operands triggers an assertion.
 ///
+/// A ByteCode is packed into 8 bytes so that the code of a function is dense.
+/// A name operand is kept as the ID of its Identifier. The only Opcode with
+/// both operands, ``CALL_FUNCTION``, keeps its int operand in the 24 bits
+/// left by the Opcode. The source line and the offset of a ByteCode are
+/// kept by its ByteCodeFunction.
+///
+/// The superinstructions made by ByteCodeFuser on a local or a jump also
+/// carry a constant operand in those 24 bits.
+///
 /// ByteCode can be translated to MIPS backing by a software-emulated stack.
 /// However, meaningful optimization cannot be applied to this form of IR and
-/// the resultant machine code is rather slow.
+/// the resultant machine code is rather slow, so the MIPS backend takes it
+/// lowered to the register-based IR of IRModule instead.
 class ByteCode {
 public:
   /// Opcode for ByteCode.
@@ -24,30 +36,37 @@ public:
 #define HANDLE_OPCODE(opcode, camelName) opcode,
 #include "simplecc/CodeGen/Opcode.def"
   };
-private:
-  Opcode Op;
-  int IntOperand = 0;
-  const char *StrOperand = nullptr;
 
-  // Lineno in source file.
-  unsigned SourceLineno = 0;
+  /// The limit of the int operand of an Opcode that also has a name operand.
+  static const int MaxSmallIntOperand = (1 << 23) - 1;
+  /// The limits of the constant operand of a superinstruction.
+  static const int MinConstOperand = -(1 << 23);
+  static const int MaxConstOperand = (1 << 23) - 1;
 
-  // Offset in the ByteCode stream of a ByteCodeFunction.
-  unsigned ByteCodeOffset = 0;
+private:
+  uint32_t Op : 8;
+  /// The int operand of an Opcode that also has a name operand, or the
+  /// constant operand of a superinstruction.
+  int32_t SmallIntOperand : 24;
+  /// The int operand, or the ID of the name operand.
+  int32_t Operand = 0;
 
   /// Private. Use Create() instead.
-  explicit ByteCode(Opcode Op) : Op(Op) {}
+  explicit ByteCode(Opcode Op) : Op(Op), SmallIntOperand(0) {}
 
   /// Helpers.
   static bool HasStrOperand(Opcode op);
   static bool HasIntOperand(Opcode op);
   static bool IsJump(Opcode Op);
   static bool HasNoOperand(Opcode op);
+  static bool HasConstOperand(Opcode Op);
+  static bool IsSuperinstruction(Opcode Op);
   static const char *getOpcodeName(unsigned Op);
 public:
   ~ByteCode() = default;
   ByteCode(const ByteCode &) = default;
   ByteCode(ByteCode &&) = default;
+  ByteCode &operator=(const ByteCode &) = default;
 
   /// Create a ByteCode with no operand.
   static ByteCode Create(Opcode Op) { return ByteCode(Op); }
@@ -55,17 +74,16 @@ public:
   /// Create a ByteCode with an int operand.
   static ByteCode Create(Opcode Op, int Val);
 
-  /// Create a ByteCode with a cstring operand.
-  /// The pointer is a borrowed one and the actual storage must outlive the ByteCode instance.
-  static ByteCode Create(Opcode Op, const char *Val);
+  /// Create a ByteCode with a name operand.
+  static ByteCode Create(Opcode Op, Identifier Val);
 
-  /// Create a ByteCode with both an int and a cstring operand.
-  static ByteCode Create(Opcode Op, const char *Str, int Int);
+  /// Create a ByteCode with both an int and a name operand.
+  static ByteCode Create(Opcode Op, Identifier Str, int Int);
 
   /// Return if this opcode has an int operand.
   bool HasIntOperand() const { return HasIntOperand(getOpcode()); }
 
-  /// Return if this opcode has an cstring operand.
+  /// Return if this opcode has a name operand.
   bool HasStrOperand() const { return HasStrOperand(getOpcode()); }
 
   /// Return if this opcode has no operand.
@@ -74,33 +92,27 @@ public:
   /// Return if this has a jump Opcode.
   bool IsJump() const { return IsJump(getOpcode()); }
 
-  /// Set the source lineno.
-  void setSourceLineno(unsigned Line) { SourceLineno = Line; }
+  /// Return if this opcode has a constant operand.
+  bool HasConstOperand() const { return HasConstOperand(getOpcode()); }
 
-  /// Return the source lineno.
-  unsigned getSourceLineno() const { return SourceLineno; }
+  /// Return if this is a superinstruction made by ByteCodeFuser.
+  bool IsSuperinstruction() const { return IsSuperinstruction(getOpcode()); }
 
   /// Set the jump target for this ByteCode if this is a jump.
   void setJumpTarget(unsigned Target) {
     assert(IsJump() && "not a jump!");
-    IntOperand = Target;
+    Operand = static_cast<int32_t>(Target);
   }
 
   /// Return the jump target if it is a jump.
   unsigned getJumpTarget() const {
     assert(IsJump() && "not a jump!");
-    assert(IntOperand >= 0 && "negative jump target!");
-    return static_cast<unsigned>(IntOperand);
+    assert(Operand >= 0 && "negative jump target!");
+    return static_cast<unsigned>(Operand);
   }
 
-  /// Set the offset in the stream.
-  void setByteCodeOffset(unsigned Offset) { ByteCodeOffset = Offset; }
-
-  /// Return the offset in the stream.
-  unsigned getByteCodeOffset() const { return ByteCodeOffset; }
-
   /// Return the Opcode.
-  Opcode getOpcode() const { return Op; }
+  Opcode getOpcode() const { return static_cast<Opcode>(Op); }
 
   /// Return the name of the Opcode.
   const char *getOpcodeName() const { return getOpcodeName(getOpcode()); }
@@ -108,31 +120,51 @@ public:
   /// Return the int operand if has one.
   int getIntOperand() const {
     assert(HasIntOperand());
-    return IntOperand;
+    return HasStrOperand() ? static_cast<int>(SmallIntOperand) : Operand;
   }
 
   /// Set the int operand if has one.
   void setIntOperand(int Val) {
     assert(HasIntOperand());
-    IntOperand = Val;
+    if (!HasStrOperand()) {
+      Operand = Val;
+      return;
+    }
+    assert(Val >= 0 && Val <= MaxSmallIntOperand && "int operand too large");
+    SmallIntOperand = Val;
   }
 
-  /// Return the cstring operand if has one.
-  const char *getStrOperand() const {
+  /// Return the constant operand if has one.
+  int getConstOperand() const {
+    assert(HasConstOperand());
+    return SmallIntOperand;
+  }
+
+  /// Set the constant operand if has one.
+  void setConstOperand(int Val) {
+    assert(HasConstOperand());
+    assert(Val >= MinConstOperand && Val <= MaxConstOperand &&
+           "constant operand out of range");
+    SmallIntOperand = Val;
+  }
+
+  /// Return the name operand if has one.
+  Identifier getStrOperand() const {
     assert(HasStrOperand());
-    return StrOperand;
+    return Identifier::getByID(static_cast<unsigned>(Operand));
   }
 
-  /// Set the cstring operand if has one.
-  /// The pointer is a borrowed one and the actual storage must outlive the ByteCode instance.
-  void setStrOperand(const char *Val) {
+  /// Set the name operand if has one.
+  void setStrOperand(Identifier Val) {
     assert(HasStrOperand());
-    StrOperand = Val;
+    Operand = static_cast<int32_t>(Val.getID());
   }
 
   void Format(std::ostream &os) const;
 };
 
+static_assert(sizeof(ByteCode) == 8, "ByteCode should be packed");
+
 DEFINE_INLINE_OUTPUT_OPERATOR(ByteCode)
 
 } // namespace simplecc
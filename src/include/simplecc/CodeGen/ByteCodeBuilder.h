@@ -86,18 +86,18 @@ public:
   unsigned CreateUnary(UnaryOpKind Op) { return Create(MakeUnary(Op)); }
 
   /// Create a CALL_FUNCTION.
-  unsigned CreateCallFunction(const std::string &Name, unsigned Argc) {
-    return Create(ByteCode::CALL_FUNCTION, Name.data(), Argc);
+  unsigned CreateCallFunction(Identifier Name, unsigned Argc) {
+    return Create(ByteCode::CALL_FUNCTION, Name, Argc);
   }
 
   /// Create a load, such as LOAD_LOCAL.
-  unsigned CreateLoad(Scope S, const std::string &Name) {
-    return Create(MakeLoad(S), Name.data());
+  unsigned CreateLoad(Scope S, Identifier Name) {
+    return Create(MakeLoad(S), Name);
   }
 
   /// Create a store, such as STORE_LOCAL.
-  unsigned CreateStore(Scope S, const std::string &Name) {
-    return Create(MakeStore(S), Name.data());
+  unsigned CreateStore(Scope S, Identifier Name) {
+    return Create(MakeStore(S), Name);
   }
 
   /// Create a LOAD_CONST.
@@ -0,0 +1,115 @@
+#ifndef SIMPLECC_CODEGEN_BYTECODECFG_H
+#define SIMPLECC_CODEGEN_BYTECODECFG_H
+#include "simplecc/Support/Macros.h"
+#include <iostream>
+#include <vector>
+
+namespace simplecc {
+class ByteCodeFunction;
+
+/// @brief ByteCodeCFG is the control flow graph of a ByteCodeFunction, with
+/// its dominator tree and loop nest.
+///
+/// A basic block is a range of offsets. A block starts at the entry, at a
+/// jump target and after a jump or return, so only the last ByteCode of a
+/// block transfers control. A jump to the end of the code returns, like a
+/// return or falling off the end, and adds no successor.
+///
+/// The loops are the natural loops of the back edges, those going to a block
+/// that dominates their source. The back edges to the same header make one
+/// loop. The graph is taken as it is: a block that cannot be reached from
+/// the entry has no dominator and is in no loop.
+class ByteCodeCFG {
+public:
+  /// The index of no block or no loop.
+  static constexpr unsigned None = ~0U;
+
+  struct BasicBlock {
+    /// The offsets of the ByteCode's are [Begin, End).
+    unsigned Begin;
+    unsigned End;
+    std::vector<unsigned> Predecessors;
+    std::vector<unsigned> Successors;
+    /// The immediate dominator, None for the entry and an unreachable block.
+    unsigned IDom;
+    /// The innermost loop containing the block, or None.
+    unsigned Loop;
+  };
+
+  struct Loop {
+    unsigned Header;
+    /// The blocks of the loop in order, the header included.
+    std::vector<unsigned> Blocks;
+    /// The innermost loop containing this one, or None.
+    unsigned Parent;
+    /// 1 for an outermost loop.
+    unsigned Depth;
+  };
+
+  ByteCodeCFG() = default;
+  explicit ByteCodeCFG(const ByteCodeFunction &F) { Compute(F); }
+
+  /// Build the graph of a function. The jump targets must be in range.
+  void Compute(const ByteCodeFunction &F);
+
+  /// Return the function the graph is built from.
+  const ByteCodeFunction *getFunction() const { return TheFunction; }
+
+  unsigned getNumBlocks() const { return Blocks.size(); }
+  const BasicBlock &getBlock(unsigned B) const { return Blocks[B]; }
+
+  /// Return the block containing the ByteCode at an offset.
+  unsigned getBlockAt(unsigned Offset) const { return BlockAt[Offset]; }
+
+  using const_iterator = std::vector<BasicBlock>::const_iterator;
+  const_iterator begin() const { return Blocks.begin(); }
+  const_iterator end() const { return Blocks.end(); }
+
+  /// Return the reachable blocks in reverse post order, the entry first.
+  const std::vector<unsigned> &getReversePostOrder() const { return RPO; }
+
+  /// Return if a block can be reached from the entry.
+  bool IsReachable(unsigned B) const { return RPONumbers[B] != None; }
+
+  /// Return if block A dominates block B, which it does if every path from
+  /// the entry to B goes through A. A block dominates itself.
+  bool Dominates(unsigned A, unsigned B) const;
+
+  /// Return if the edge from block From to block To is a back edge.
+  bool IsBackEdge(unsigned From, unsigned To) const {
+    return IsReachable(From) && Dominates(To, From);
+  }
+
+  unsigned getNumLoops() const { return Loops.size(); }
+  const Loop &getLoop(unsigned L) const { return Loops[L]; }
+
+  /// Return the number of loops containing a block.
+  unsigned getLoopDepth(unsigned B) const {
+    return Blocks[B].Loop == None ? 0 : Loops[Blocks[B].Loop].Depth;
+  }
+
+  /// Print the blocks with their ByteCode's, edges, dominators and loops.
+  void Format(std::ostream &O) const;
+
+  /// Write the graph as a cluster of a dot digraph, to which the caller
+  /// writes the head and the tail.
+  void WriteDOT(std::ostream &O) const;
+
+private:
+  void ComputeBlocks();
+  void ComputeDominators();
+  void ComputeLoops();
+  unsigned Intersect(unsigned A, unsigned B) const;
+
+  const ByteCodeFunction *TheFunction = nullptr;
+  std::vector<BasicBlock> Blocks;
+  std::vector<unsigned> BlockAt;
+  std::vector<unsigned> RPO;
+  std::vector<unsigned> RPONumbers;
+  std::vector<Loop> Loops;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(ByteCodeCFG)
+
+} // namespace simplecc
+#endif // SIMPLECC_CODEGEN_BYTECODECFG_H
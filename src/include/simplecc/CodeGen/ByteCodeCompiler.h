@@ -9,6 +9,7 @@
 
 namespace simplecc {
 class ByteCodeModule;
+class ThreadPool;
 
 /// @brief ByteCodeCompiler compiles an AST into a ByteCodeModule.
 class ByteCodeCompiler : ChildrenVisitor<ByteCodeCompiler> {
@@ -16,6 +17,8 @@ class ByteCodeCompiler : ChildrenVisitor<ByteCodeCompiler> {
 
   /// Compile DeclAST.
   void visitFuncDef(FuncDef *FD);
+  /// Compile a FuncDef into a ByteCodeFunction.
+  void CompileFunction(FuncDef *FD, ByteCodeFunction *TheFunction);
   void visitConstDecl(ConstDecl *) {}
   void visitArgDecl(ArgDecl *A);
   void visitVarDecl(VarDecl *VD);
@@ -56,6 +59,10 @@ public:
   ByteCodeCompiler() = default;
   /// Compile a program into a ByteCodeModule.
   void Compile(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M);
+  /// Same as above but compile the functions in parallel on a ThreadPool.
+  /// The result is the same as the serial one.
+  void Compile(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M,
+               ThreadPool &Pool);
 
 private:
   friend ChildrenVisitor;
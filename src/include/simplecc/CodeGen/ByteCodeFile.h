@@ -0,0 +1,177 @@
+#ifndef SIMPLECC_CODEGEN_BYTECODEFILE_H
+#define SIMPLECC_CODEGEN_BYTECODEFILE_H
+#include "simplecc/Support/ErrorManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace simplecc {
+class ByteCodeModule;
+
+/// @brief ByteCodeFile is a ByteCodeModule in a compact binary form, which is
+/// memory-mapped and used in place.
+///
+/// The file is a Header followed by flat tables of fixed-size records whose
+/// fields are all 32 bits wide and in the byte order of the host. Names and
+/// string literals are NUL-terminated strings in a single pool and are
+/// referred to by their index in it, where 0 is the empty string.
+///
+/// Opening a file checks that every record refers to something within the
+/// file, that every name in the code is defined and that the operand stack
+/// is balanced, but decodes nothing, so a consumer can walk the code of a
+/// function right in the mapping. Load() turns the file into a
+/// ByteCodeModule that the MIPS backend takes. The code is that of CodeGen,
+/// which holds no superinstructions.
+class ByteCodeFile {
+public:
+  /// Bump this when the layout changes.
+  static const uint32_t CurrentVersion = 1;
+
+  struct Header {
+    char Magic[8];
+    uint32_t Version;
+    /// 0x01020304 in the byte order of the writer.
+    uint32_t ByteOrder;
+    uint32_t FileSize;
+    /// An array of NumStrings offsets into the string data.
+    uint32_t NumStrings;
+    uint32_t StringOffsetsOffset;
+    uint32_t StringDataOffset;
+    uint32_t StringDataSize;
+    /// An array of the strings of the string literals, indexed by their IDs.
+    uint32_t NumStringLiterals;
+    uint32_t StringLiteralsOffset;
+    /// An array of Object for the global variables.
+    uint32_t NumGlobals;
+    uint32_t GlobalsOffset;
+    /// An array of Function.
+    uint32_t NumFunctions;
+    uint32_t FunctionsOffset;
+    /// An array of Object for the arguments and locals of all functions.
+    uint32_t NumObjects;
+    uint32_t ObjectsOffset;
+    /// An array of Code for the code of all functions.
+    uint32_t NumCodes;
+    uint32_t CodesOffset;
+  };
+
+  /// A variable, an array or an argument.
+  struct Object {
+    enum : uint32_t { Variable, Array, Argument };
+    uint32_t Name;
+    uint32_t Kind;
+    /// A BasicTypeKind.
+    uint32_t Type;
+    /// The size of an array, 0 otherwise.
+    int32_t Size;
+    uint32_t Line;
+    uint32_t Column;
+  };
+
+  /// A function, whose arguments come before its locals in the objects.
+  struct Function {
+    uint32_t Name;
+    uint32_t FirstObject;
+    uint32_t NumArguments;
+    uint32_t NumLocals;
+    uint32_t FirstCode;
+    uint32_t NumCodes;
+  };
+
+  /// A ByteCode, whose offset is its index in the function.
+  struct Code {
+    /// A ByteCode::Opcode.
+    uint32_t Opcode;
+    int32_t IntOperand;
+    /// The string of the name operand.
+    uint32_t StrOperand;
+    uint32_t SourceLineno;
+  };
+
+  ByteCodeFile();
+  ~ByteCodeFile();
+  ByteCodeFile(const ByteCodeFile &) = delete;
+  ByteCodeFile &operator=(const ByteCodeFile &) = delete;
+
+  /// Write a module to O in the form of a ByteCodeFile.
+  static void Write(const ByteCodeModule &M, std::ostream &O);
+
+  /// Return if a file starts like a ByteCodeFile. Only a regular file is
+  /// looked at, so a pipe is left unread.
+  static bool IsByteCodeFile(const std::string &Filename);
+
+  /// Map a file and check it. Return true if errors happened.
+  bool Open(const std::string &Filename);
+
+  /// Fill a module with the content of the file, which must be open.
+  /// Return true if errors happened.
+  bool Load(ByteCodeModule &M);
+
+  /// Unmap the file.
+  void close();
+
+  const Header &getHeader() const { return *getAt<Header>(0); }
+
+  /// Return the string with ID.
+  const char *getString(uint32_t ID) const {
+    assert(ID < getHeader().NumStrings && "Invalid string ID");
+    return getAt<char>(getHeader().StringDataOffset) +
+           getAt<uint32_t>(getHeader().StringOffsetsOffset)[ID];
+  }
+
+  /// Return the string of the string literal with ID.
+  const char *getStringLiteral(uint32_t ID) const {
+    assert(ID < getHeader().NumStringLiterals && "Invalid string literal ID");
+    return getString(getAt<uint32_t>(getHeader().StringLiteralsOffset)[ID]);
+  }
+
+  const Object *getGlobals() const {
+    return getAt<Object>(getHeader().GlobalsOffset);
+  }
+  size_t getNumGlobals() const { return getHeader().NumGlobals; }
+
+  const Function *getFunctions() const {
+    return getAt<Function>(getHeader().FunctionsOffset);
+  }
+  size_t getNumFunctions() const { return getHeader().NumFunctions; }
+
+  /// Return the arguments of a function followed by its locals.
+  const Object *getObjects(const Function &F) const {
+    return getAt<Object>(getHeader().ObjectsOffset) + F.FirstObject;
+  }
+
+  /// Return the code of a function.
+  const Code *getCode(const Function &F) const {
+    return getAt<Code>(getHeader().CodesOffset) + F.FirstCode;
+  }
+
+private:
+  template <typename T> const T *getAt(uint32_t Offset) const {
+    assert(Data && "File not open");
+    return reinterpret_cast<const T *>(Data + Offset);
+  }
+
+  /// Check that the records lie in the file and refer to things in it.
+  /// Return true if errors happened.
+  bool Verify();
+
+  /// Check that the names of the code of a function are defined, that the
+  /// string literals exist and that the operand stack is empty at the start
+  /// and the end of each block and never popped when empty. GlobalOf and
+  /// FunctionOf map the ID of a name to its global or function, if any.
+  /// Return true if errors happened.
+  bool VerifyCode(const Function &F,
+                  const std::vector<const Object *> &GlobalOf,
+                  const std::vector<const Function *> &FunctionOf);
+
+  /// Either mapped or read into a buffer of our own.
+  const char *Data = nullptr;
+  size_t Size = 0;
+  bool IsMapped = false;
+  std::string Filename;
+  ErrorManager EM;
+};
+} // namespace simplecc
+#endif // SIMPLECC_CODEGEN_BYTECODEFILE_H
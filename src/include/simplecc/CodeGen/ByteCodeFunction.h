@@ -15,6 +15,10 @@ class ByteCodeModule;
 /// 1. a list of formal arguments.
 /// 2. a list of local variables (ArrayType and VarType).
 /// 3. a list of ByteCode's.
+///
+/// The offset of a ByteCode is its index in the list. The source lines of the
+/// ByteCode's are kept in a list of their own, so the list of ByteCode's stays
+/// compact for the passes that walk it.
 class ByteCodeFunction {
 public:
   /// The type for a list of local variables.
@@ -31,10 +35,10 @@ public:
   }
 
   /// Return the name of the function.
-  const std::string &getName() const { return Name; }
+  Identifier getName() const { return Name; }
 
   /// Set the name of the function.
-  void setName(std::string Str) { Name = std::move(Str); }
+  void setName(Identifier Str) { Name = Str; }
 
   /// Return the local symbol table.
   void setLocalTable(LocalSymbolTable L) { Symbols = L; }
@@ -42,12 +46,33 @@ public:
   /// Set the local symbol table.
   LocalSymbolTable getLocalTable() const { return Symbols; }
 
-  /// Return the list of ByteCode.
+  /// Return the list of ByteCode. Use append() to add to it.
   ByteCodeListTy &getByteCodeList() { return ByteCodeList; }
 
   /// Return the list of ByteCode.
   const ByteCodeListTy &getByteCodeList() const { return ByteCodeList; }
 
+  /// Append a ByteCode from a source line. Return its offset.
+  unsigned append(ByteCode Code, unsigned Lineno) {
+    auto Off = static_cast<unsigned>(ByteCodeList.size());
+    ByteCodeList.push_back(Code);
+    SourceLinenos.push_back(Lineno);
+    return Off;
+  }
+
+  /// Return the source line of the ByteCode at the specific index.
+  unsigned getSourceLinenoAt(unsigned Idx) const { return SourceLinenos[Idx]; }
+
+  /// Reserve room for Size ByteCode's.
+  void reserve(size_t Size) {
+    ByteCodeList.reserve(Size);
+    SourceLinenos.reserve(Size);
+  }
+
+  /// Remove the ByteCode's whose entries in Removed are true. A jump to a
+  /// removed ByteCode then goes to the first one kept after it.
+  void removeByteCodes(const std::vector<bool> &Removed);
+
   /// Return the ByteCode at the specific index.
   ByteCode &getByteCodeAt(unsigned Idx) { return ByteCodeList[Idx]; }
 
@@ -113,9 +138,11 @@ private:
   ByteCodeModule *Parent;
   LocalSymbolTable Symbols;
   ByteCodeListTy ByteCodeList;
+  /// The source line of each ByteCode.
+  std::vector<unsigned> SourceLinenos;
   LocalVariableListTy Arguments;
   LocalVariableListTy LocalVariables;
-  std::string Name;
+  Identifier Name;
 
   /// Private. Use Create() instead.
   explicit ByteCodeFunction(ByteCodeModule *M);
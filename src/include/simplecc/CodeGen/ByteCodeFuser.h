@@ -0,0 +1,46 @@
+#ifndef SIMPLECC_CODEGEN_BYTECODEFUSER_H
+#define SIMPLECC_CODEGEN_BYTECODEFUSER_H
+#include "simplecc/CodeGen/ByteCode.h"
+#include <unordered_set>
+#include <vector>
+
+namespace simplecc {
+class ByteCodeFunction;
+class ByteCodeModule;
+
+/// @brief ByteCodeFuser replaces common sequences of ByteCode's with the
+/// superinstructions of Opcode.def, which the interpreter runs with fewer
+/// dispatches and the MIPS backend translates with less stack traffic.
+///
+/// The sequences are the most frequent ones over the test programs that fit
+/// in a ByteCode. A sequence is fused only if no jump lands inside it and its
+/// constant fits the constant operand, so the result behaves the same.
+/// The superinstructions are only meant for the backends: the passes over
+/// ByteCode and ByteCodeFile do not take them.
+class ByteCodeFuser {
+public:
+  ByteCodeFuser() = default;
+
+  /// Fuse the code of every function of a module.
+  void Fuse(ByteCodeModule &M);
+  void Fuse(ByteCodeFunction &F);
+
+  /// Return the number of superinstructions made so far.
+  unsigned getNumFused() const { return NumFused; }
+
+private:
+  /// Fuse the sequence at Idx if there is one. Return its length, 0 if none.
+  unsigned FuseAt(ByteCodeFunction &F, unsigned Idx);
+
+  /// Return the superinstruction comparing with a constant for a jump,
+  /// or the jump itself if there is none.
+  static ByteCode::Opcode getJumpWithConst(ByteCode::Opcode Op);
+
+  /// Reused for each function.
+  std::vector<bool> IsJumpTarget;
+  std::vector<bool> Removed;
+  std::unordered_set<Identifier> Arrays;
+  unsigned NumFused = 0;
+};
+} // namespace simplecc
+#endif // SIMPLECC_CODEGEN_BYTECODEFUSER_H
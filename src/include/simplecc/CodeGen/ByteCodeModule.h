@@ -1,7 +1,9 @@
 #ifndef SIMPLECC_CODEGEN_BYTECODEMODULE_H
 #define SIMPLECC_CODEGEN_BYTECODEMODULE_H
+#include "simplecc/Analysis/SymbolTable.h"
 #include "simplecc/Analysis/Types.h"
 #include <iostream>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +32,10 @@ public:
   const StringLiteralTable &getStringLiteralTable() const {
     return StringLiterals;
   }
+  /// Return the string literals in the order of their IDs.
+  const std::vector<std::string> &getStringLiterals() const {
+    return StringLiteralList;
+  }
   /// For a string literal, this method returns the corresponding ID.
   unsigned getStringLiteralID(const std::string &Str);
 
@@ -54,6 +60,13 @@ public:
   bool empty() const { return FunctionList.empty(); }
   size_t size() const { return FunctionList.size(); }
 
+  /// Return the context for the declarations of a module that is not
+  /// compiled from a program, such as one loaded from a ByteCodeFile.
+  ASTContext &getContext();
+
+  /// Create a local table owned by this module.
+  TableType &createLocalTable();
+
   /// Make this module empty.
   void clear();
   void Format(std::ostream &O) const;
@@ -61,7 +74,14 @@ public:
 private:
   FunctionListTy FunctionList;
   StringLiteralTable StringLiterals;
+  /// The keys of StringLiterals indexed by ID, so that they are printed and
+  /// emitted in an order that does not depend on the hash table.
+  std::vector<std::string> StringLiteralList;
   GlobalVariableListTy GlobalVariables;
+  /// A compiled module refers to the declarations and the local tables of
+  /// its program. A loaded module has no program, so it owns them.
+  std::unique_ptr<ASTContext> TheContext;
+  std::vector<std::unique_ptr<TableType>> LocalTables;
 };
 
 DEFINE_INLINE_OUTPUT_OPERATOR(ByteCodeModule)
@@ -0,0 +1,89 @@
+#ifndef SIMPLECC_CODEGEN_BYTECODEPEEPHOLE_H
+#define SIMPLECC_CODEGEN_BYTECODEPEEPHOLE_H
+#include "simplecc/CodeGen/ByteCodeCFG.h"
+#include "simplecc/Support/Identifier.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace simplecc {
+class ByteCode;
+class ByteCodeFunction;
+class ByteCodeModule;
+
+/// @brief PeepholeOptions selects the rewrites of ByteCodePeephole.
+struct PeepholeOptions {
+  /// Make a jump to a JUMP_FORWARD go to where that one goes.
+  bool ThreadJumps = true;
+  /// Remove a JUMP_FORWARD to the next ByteCode.
+  bool RemoveJumpsToNext = true;
+  /// Remove LOAD_CONST 0 before BINARY_ADD or BINARY_SUB, LOAD_CONST 1
+  /// before BINARY_MULTIPLY or BINARY_DIVIDE, and UNARY_POSITIVE.
+  bool RemoveIdentities = true;
+  /// Remove STORE_LOCAL x; LOAD_LOCAL x if x is not used afterwards, which
+  /// leaves the value on the stack.
+  bool RemoveDeadStores = true;
+  /// Remove the code that cannot be reached, like the RETURN_NONE after a
+  /// return.
+  bool RemoveUnreachable = true;
+};
+
+/// @brief ByteCodePeephole removes redundant ByteCode's the compiler emits.
+///
+/// The rewrites are repeated until none applies, since one can make room for
+/// another. The jumps are remapped as the ByteCode's are removed. The code
+/// must be plain ByteCode's without superinstructions, so the pass runs before
+/// ByteCodeFuser. A function with superinstructions is left alone.
+class ByteCodePeephole {
+public:
+  /// The size of a function before and after the pass.
+  struct FunctionStats {
+    Identifier Name;
+    unsigned Before;
+    unsigned After;
+  };
+
+  ByteCodePeephole() = default;
+  explicit ByteCodePeephole(const PeepholeOptions &Opts) : Opts(Opts) {}
+
+  /// Optimize every function of a module.
+  void Optimize(ByteCodeModule &M);
+  /// Optimize a function. Return if any ByteCode is removed.
+  bool Optimize(ByteCodeFunction &F);
+
+  /// Return the sizes of the functions optimized so far.
+  const std::vector<FunctionStats> &getStats() const { return Stats; }
+  /// Return the number of ByteCode's removed so far.
+  unsigned getNumRemoved() const { return NumRemoved; }
+
+private:
+  /// Run the rewrites once. Return if anything changed.
+  bool RunOnce(ByteCodeFunction &F);
+  /// Make the jumps skip JUMP_FORWARD's. Return if any is changed.
+  bool ThreadJumps(ByteCodeFunction &F);
+  /// Compute which of Variables are live out of each block of TheCFG.
+  void ComputeLiveness(const ByteCodeFunction &F);
+  /// Mark the dead STORE_LOCAL x; LOAD_LOCAL x pairs of a block.
+  void MarkDeadStores(const ByteCodeFunction &F, unsigned B);
+  /// Return the index of the variable of a LOAD_LOCAL or STORE_LOCAL in
+  /// Variables, or ByteCodeCFG::None.
+  unsigned getVariable(const ByteCode &C) const;
+
+  PeepholeOptions Opts;
+  std::vector<FunctionStats> Stats;
+  unsigned NumRemoved = 0;
+
+  /// Reused for each function.
+  ByteCodeCFG TheCFG;
+  std::vector<bool> Removed;
+  std::unordered_map<Identifier, unsigned> Variables;
+  /// Bit sets of Variables, NumWords words for each block.
+  unsigned NumWords = 0;
+  std::vector<uint64_t> Use;
+  std::vector<uint64_t> Def;
+  std::vector<uint64_t> LiveIn;
+  std::vector<uint64_t> LiveOut;
+  std::vector<uint64_t> Live;
+};
+} // namespace simplecc
+#endif // SIMPLECC_CODEGEN_BYTECODEPEEPHOLE_H
@@ -7,9 +7,24 @@ namespace simplecc {
 class ProgramAST;
 class SymbolTable;
 class ByteCodeModule;
+class ThreadPool;
 
 /// PrintByteCode
 void PrintByteCode(ProgramAST *P, std::ostream &O);
 void CompileToByteCode(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M);
+/// Compile the functions in parallel on a ThreadPool.
+void CompileToByteCode(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M,
+                       ThreadPool &Pool);
+/// Remove the redundant ByteCode's of the module. Return the number
+/// removed. The size of each function before and after is printed to Report
+/// if it is not nullptr.
+unsigned OptimizeByteCode(ByteCodeModule &M, std::ostream *Report = nullptr);
+/// Replace common sequences in the module with superinstructions for the
+/// backends. Return the number of superinstructions made.
+unsigned FuseByteCode(ByteCodeModule &M);
+/// Print the control flow graph of each function of the module.
+void PrintByteCodeCFG(const ByteCodeModule &M, std::ostream &O);
+/// Write the control flow graphs of the module as a dot digraph.
+void WriteByteCodeCFGGraph(const ByteCodeModule &M, std::ostream &O);
 } // namespace simplecc
 #endif // SIMPLECC_CODEGEN_CODEGEN_H
\ No newline at end of file
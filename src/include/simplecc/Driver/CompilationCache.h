@@ -0,0 +1,78 @@
+#ifndef SIMPLECC_DRIVER_COMPILATIONCACHE_H
+#define SIMPLECC_DRIVER_COMPILATIONCACHE_H
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace simplecc {
+/// @brief CompilationCache is an on-disk cache of the results of the driver
+/// commands, keyed by a hash of the compiler, the command, the name of the
+/// input and its bytes.
+/// Each entry is a file in the cache directory holding the exit status, the
+/// output and the diagnostics of a run, so a hit replays the run exactly.
+///
+/// When the entries grow beyond the size limit, the least recently used ones
+/// are removed. A hit touches its entry. Entries are written to a temporary
+/// file first and renamed into place, so concurrent drivers sharing a cache
+/// never see a partial entry.
+class CompilationCache {
+public:
+  struct Entry {
+    int Status = 0;
+    /// Whether the command wrote to its output at all.
+    bool HasOutput = false;
+    std::string Output;
+    std::string Diagnostics;
+  };
+
+  /// Create a cache in Dir, which is created if it does not exist.
+  /// MaxSize is the limit of the total size of the entries in bytes.
+  CompilationCache(std::string Dir, uint64_t MaxSize);
+  CompilationCache(const CompilationCache &) = delete;
+  CompilationCache &operator=(const CompilationCache &) = delete;
+
+  /// Compute the key of running Command on the file named Input.
+  /// Return false if Input cannot be read.
+  bool getKey(const std::string &Command, const std::string &Input,
+              std::string &Key) const;
+
+  /// Look up an entry. Return true on a hit.
+  bool lookup(const std::string &Key, Entry &E);
+
+  /// Store an entry and evict old ones if the cache is full.
+  void store(const std::string &Key, const Entry &E);
+
+  unsigned getNumHits() const { return NumHits; }
+  unsigned getNumMisses() const { return NumMisses; }
+  unsigned getNumEvictions() const { return NumEvictions; }
+
+  /// Print the hits, misses and evictions of this process.
+  void PrintStats(std::ostream &O) const;
+
+private:
+  /// Return the path of the entry of Key.
+  std::string getEntryPath(const std::string &Key) const;
+  /// Account for an entry of AddedSize bytes and remove the least recently
+  /// used entries if the total size is above the limit.
+  void Evict(uint64_t AddedSize);
+
+  std::string Dir;
+  uint64_t MaxSize;
+  /// Identify the compiler so that a new build never sees old entries.
+  uint64_t CompilerHash;
+  std::atomic<unsigned> NumHits{0};
+  std::atomic<unsigned> NumMisses{0};
+  std::atomic<unsigned> NumEvictions{0};
+  /// The number of entries stored by this process, to name temporary files.
+  std::atomic<unsigned> NumStores{0};
+  /// Guard the two below.
+  std::mutex EvictMutex;
+  /// The total size of the entries as of the last scan plus what this
+  /// process stored since. Other processes are only seen by a scan.
+  uint64_t KnownSize = 0;
+  bool HasScanned = false;
+};
+} // namespace simplecc
+#endif // SIMPLECC_DRIVER_COMPILATIONCACHE_H
@@ -7,19 +7,64 @@ class raw_ostream;
 }
 
 namespace simplecc {
+class CompilationCache;
 
 class Driver : public DriverBase {
-  std::unique_ptr<Node> runBuildCST();
+public:
+  enum class CommandKind {
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix) Name,
+#include "simplecc/Driver/Driver.def"
+  };
+
+private:
+  std::unique_ptr<ParseTree> runBuildCST();
   void runDumpSymbolTable();
-#define HANDLE_COMMAND(Name, Arg, Description) void run##Name();
+  /// Print the time report as text to getErrs() and as JSON to JSONFile,
+  /// unless it is empty.
+  void PrintTimeReport(bool Text, const std::string &JSONFile);
+  /// Serve the compile requests read from In, one per line, until EOF or a
+  /// line of "quit". A request is a command switch without the dashes, an
+  /// input file and an optional output file, separated by tabs, or by spaces
+  /// if the line has no tab, like ``asm foo.c foo.s``. A file name with a
+  /// space needs the tabs. The reply to each request is a header line of
+  /// ``<status> <output size> <diagnostics size>`` followed by the output,
+  /// if no output file is given, and then the diagnostics.
+  /// The driver, its thread pool and the global tables are reused.
+  void ServeRequests(std::istream &In, std::ostream &Out);
+  /// Run the method of a command.
+  void DispatchCommand(CommandKind Cmd);
+  /// Run a command through the cache, whose key for the run is Key.
+  /// On a miss the output and the diagnostics are captured and stored.
+  /// Either way they are then written as the command would.
+  int runCommandCached(CommandKind Cmd, const std::string &Key);
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix) void run##Name();
 #include "simplecc/Driver/Driver.def"
 #if SIMPLE_COMPILER_USE_LLVM
   std::unique_ptr<llvm::raw_ostream> getLLVMRawOstream();
 #endif
 
+  /// The cache of the results of the commands, if any.
+  CompilationCache *Cache = nullptr;
+
 public:
   Driver() = default;
   int run(int argc, char **argv);
+
+  /// Run a command on the input file and return the exit status.
+  int runCommand(CommandKind Cmd);
+
+  /// Set a cache to look up the results of the commands in, or nullptr.
+  void setCache(CompilationCache *C) { Cache = C; }
+
+  /// Run a command on each of Inputs with a Driver of its own, on NumThreads
+  /// threads (0 for all cores). The output of each input is written to a file
+  /// named after it, in OutputDir if it is not empty. The diagnostics of each
+  /// input are printed together in the order of Inputs, followed by its
+  /// peephole report and, if TimeReportText, its time report. Return the exit
+  /// status, which is 1 if any input fails.
+  int runBatch(CommandKind Cmd, const std::vector<std::string> &Inputs,
+               const std::string &OutputDir, unsigned NumThreads,
+               bool FusedAnalysis, bool TimeReportText);
 };
 
 } // namespace simplecc
@@ -2,8 +2,13 @@
 #define SIMPLECC_DRIVER_DRIVERBASE_H
 #include "simplecc/Analysis/AnalysisManager.h"
 #include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/IR/IRModule.h"
+#include "simplecc/Lex/Lexer.h"
+#include "simplecc/Lex/SourceBuffer.h"
 #include "simplecc/Lex/TokenInfo.h"
 #include "simplecc/Support/ErrorManager.h"
+#include "simplecc/Support/ThreadPool.h"
+#include "simplecc/Support/TimeReport.h"
 #include "simplecc/Parse/Parse.h"
 
 #include <fstream>
@@ -16,17 +21,24 @@ namespace simplecc {
 class DriverBase {
 protected:
   /// Return a ptr to the output stream. Nullptr on failure.
-  std::ostream *getStdOstream();
-  /// Return a ptr to the input stream. Nullptr on failure.
-  std::istream *getStdIstream();
+  std::ostream *getStdOstream(bool Binary = false);
+
+  /// Return a Lexer over the input. Stdin is lexed while it is being read.
+  /// Nullptr on failure.
+  std::unique_ptr<Lexer> getLexer();
 
   /// Lower level interfaces, each of which wraps a component function.
-  void doTokenize(std::istream &IS);
-  bool doParse();
+  void doTokenize(Lexer &L);
+  bool doParse(Lexer &L);
   bool doAnalyses();
   void doTransform();
   void doCodeGen();
-  void doAssemble(std::ostream &OS);
+  bool doLoadByteCode();
+  void doPeephole();
+  void doFuse();
+  bool doLowerToIR();
+  /// Assemble the IR, or the byte code if FromByteCode is true.
+  void doAssemble(std::ostream &OS, bool FromByteCode = false);
 
   /// High level interfaces, each of which run all its dependencies and
   /// can be run individually.
@@ -34,8 +46,20 @@ protected:
   bool runParse();
   bool runAnalyses();
   bool runTransform();
+  /// The input can also be a ByteCodeFile, which is loaded instead.
   bool runCodeGen();
+  /// Run CodeGen and clean up the compiled code by the peephole pass unless
+  /// disabled. A loaded ByteCodeFile is taken as it is.
+  bool runPeephole();
+  /// Run Peephole and make superinstructions for the stack backend and the
+  /// interpreter unless disabled.
+  bool runFuse();
+  /// Run Peephole and lower the byte code to the register-based IR.
+  bool runLowerToIR();
+  /// Assemble from the IR with registers allocated.
   bool runAssemble();
+  /// Assemble from the fused byte code, keeping the operand stack in memory.
+  bool runAssembleByteCode();
 
   const std::vector<TokenInfo> &getTokens() const { return TheTokens; }
   const SymbolTable &getSymbolTable() const { return AM.getSymbolTable(); }
@@ -43,12 +67,44 @@ protected:
   ProgramAST *getProgram() { return TheProgram.get(); }
   const ByteCodeModule &getByteCodeModule() const { return TheModule; }
   ByteCodeModule &getByteCodeModule() { return TheModule; }
+  const IRModule &getIRModule() const { return TheIR; }
   ErrorManager &getEM() { return EM; }
+  const SourceBuffer &getSource() const { return TheSource; }
+  /// Return the TimeReport of the phases, nullptr unless it is enabled.
+  TimeReport *getTimeReport() { return Report.get(); }
 public:
   void setInputFile(std::string Filename) { InputFile = std::move(Filename); }
   void setOutputFile(std::string Filename) { OutputFile = std::move(Filename); }
+  /// Set the stream the output file "-" stands for, which is ``std::cout``
+  /// by default. It is kept by clear().
+  void setStdOutput(std::ostream *OS) { StdOutput = OS; }
+  std::ostream *getStdOutput() const { return StdOutput; }
+  /// Set the stream a running program reads, which is ``std::cin`` by
+  /// default. It is kept by clear().
+  void setStdInput(std::istream *IS) { StdInput = IS; }
+  std::istream &getStdInput() const { return *StdInput; }
+  /// Return if the command has asked for the output stream.
+  bool hasOpenedOutput() const { return OpenedOutput; }
   std::string getInputFile() const { return InputFile; }
   std::string getOutputFile() const { return OutputFile; }
+  void setFusedAnalysis(bool Fused) { AM.setFusedAnalysis(Fused); }
+  /// Enable or disable the peephole pass over the byte code, which is
+  /// enabled by default. It is kept by clear().
+  void setPeephole(bool Enabled) { Peephole = Enabled; }
+  bool isPeepholeEnabled() const { return Peephole; }
+  /// Print the size of each function before and after the peephole pass
+  /// to stderr.
+  void setPeepholeReport(bool Enabled) { PeepholeReport = Enabled; }
+  bool isPeepholeReportEnabled() const { return PeepholeReport; }
+  /// Enable or disable fusing the byte code into superinstructions, which is
+  /// enabled by default. It is kept by clear().
+  void setFuse(bool Enabled) { Fuse = Enabled; }
+  bool isFuseEnabled() const { return Fuse; }
+  /// Set the number of threads used to analyze and compile the functions.
+  /// 0 means one per hardware thread and 1 means no threads at all.
+  void setNumThreads(unsigned NumThreads);
+  /// Time each phase and pass, and count the items each one processes.
+  void enableTimeReport();
 
   void clear();
   int status() const { return !EM.IsOk(); }
@@ -56,14 +112,27 @@ public:
 private:
   std::string InputFile;
   std::string OutputFile;
-  std::ifstream StdIFStream;
   std::ofstream StdOFStream;
+  std::ostream *StdOutput = &std::cout;
+  std::istream *StdInput = &std::cin;
+  bool OpenedOutput = false;
+  bool Peephole = true;
+  bool PeepholeReport = false;
+  bool Fuse = true;
+  /// If TheModule is loaded from a ByteCodeFile.
+  bool LoadedByteCode = false;
 
+  SourceBuffer TheSource;
   std::vector<TokenInfo> TheTokens;
   AnalysisManager AM;
   std::unique_ptr<ProgramAST, DeleteAST> TheProgram;
   ByteCodeModule TheModule;
+  IRModule TheIR;
   ErrorManager EM;
+  /// Nullptr unless more than one thread is used.
+  std::unique_ptr<ThreadPool> ThePool;
+  /// Nullptr unless the time report is enabled.
+  std::unique_ptr<TimeReport> Report;
 };
 }
 #endif //SIMPLECC_DRIVER_DRIVERBASE_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+/// @file External interface of the IR module.
+#ifndef SIMPLECC_IR_IR_H
+#define SIMPLECC_IR_IR_H
+#include <iostream>
+
+namespace simplecc {
+class ByteCodeModule;
+class IRModule;
+
+/// Lower a ByteCodeModule without superinstructions to the register-based IR.
+/// Return true if errors happened.
+bool LowerToIR(const ByteCodeModule &M, IRModule &IR);
+/// Print an IRModule in a readable form.
+void PrintIR(const IRModule &IR, std::ostream &O);
+} // namespace simplecc
+#endif // SIMPLECC_IR_IR_H
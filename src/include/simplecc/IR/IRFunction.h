@@ -0,0 +1,133 @@
+#ifndef SIMPLECC_IR_IRFUNCTION_H
+#define SIMPLECC_IR_IRFUNCTION_H
+#include "simplecc/IR/IRInstruction.h"
+#include "simplecc/Support/Identifier.h"
+#include "simplecc/Support/Macros.h"
+#include <iostream>
+#include <vector>
+
+namespace simplecc {
+
+/// @brief IRBasicBlock is a list of IRInstruction's that ends with the only
+/// terminator in it.
+class IRBasicBlock {
+public:
+  using InstructionListTy = std::vector<IRInstruction>;
+
+  InstructionListTy &getInstructions() { return Instructions; }
+  const InstructionListTy &getInstructions() const { return Instructions; }
+
+  /// Return the terminator, which must be there.
+  const IRInstruction &getTerminator() const {
+    assert(HasTerminator() && "block not terminated!");
+    return Instructions.back();
+  }
+  IRInstruction &getTerminator() {
+    assert(HasTerminator() && "block not terminated!");
+    return Instructions.back();
+  }
+  bool HasTerminator() const {
+    return !Instructions.empty() && Instructions.back().IsTerminator();
+  }
+
+  void append(IRInstruction I) { Instructions.push_back(std::move(I)); }
+
+  /// Return the blocks the terminator may go to.
+  unsigned getNumSuccessors() const { return getTerminator().getNumTargets(); }
+  unsigned getSuccessor(unsigned I) const {
+    return getTerminator().getTarget(I);
+  }
+
+  using iterator = InstructionListTy::iterator;
+  using const_iterator = InstructionListTy::const_iterator;
+  iterator begin() { return Instructions.begin(); }
+  iterator end() { return Instructions.end(); }
+  const_iterator begin() const { return Instructions.begin(); }
+  const_iterator end() const { return Instructions.end(); }
+  size_t size() const { return Instructions.size(); }
+  bool empty() const { return Instructions.empty(); }
+
+private:
+  InstructionListTy Instructions;
+};
+
+/// @brief IRFunction is a function in the register-based IR: a list of
+/// IRBasicBlock's, the first of which is the entry, over an unlimited number
+/// of virtual registers.
+///
+/// The registers are numbered from 0. The first ones hold the arguments on
+/// entry, followed by those of the scalar local variables and the
+/// temporaries. The local arrays live in the frame and are only accessed by
+/// their address.
+class IRFunction {
+public:
+  /// A local array.
+  struct LocalArray {
+    Identifier Name;
+    unsigned Size;
+  };
+  using BlockListTy = std::vector<IRBasicBlock>;
+
+  IRFunction(Identifier Name, unsigned NumArguments)
+      : Name(Name), NumArguments(NumArguments) {}
+
+  Identifier getName() const { return Name; }
+  unsigned getNumArguments() const { return NumArguments; }
+
+  /// Register interface. A register of a variable has its name, which is
+  /// used only in printing.
+  unsigned getNumRegisters() const {
+    return static_cast<unsigned>(RegisterNames.size());
+  }
+  unsigned createRegister(Identifier Name = Identifier()) {
+    RegisterNames.push_back(Name);
+    return getNumRegisters() - 1;
+  }
+  Identifier getRegisterName(unsigned Reg) const { return RegisterNames[Reg]; }
+
+  /// Local array interface.
+  const std::vector<LocalArray> &getLocalArrays() const { return Arrays; }
+  void addLocalArray(Identifier Name, unsigned Size) {
+    Arrays.push_back(LocalArray{Name, Size});
+  }
+
+  /// Block interface.
+  BlockListTy &getBlocks() { return Blocks; }
+  const BlockListTy &getBlocks() const { return Blocks; }
+  IRBasicBlock &getBlock(unsigned I) { return Blocks[I]; }
+  const IRBasicBlock &getBlock(unsigned I) const { return Blocks[I]; }
+  unsigned getNumBlocks() const { return static_cast<unsigned>(Blocks.size()); }
+  /// Append an empty block and return its index.
+  unsigned createBlock() {
+    Blocks.emplace_back();
+    return getNumBlocks() - 1;
+  }
+
+  using iterator = BlockListTy::iterator;
+  using const_iterator = BlockListTy::const_iterator;
+  iterator begin() { return Blocks.begin(); }
+  iterator end() { return Blocks.end(); }
+  const_iterator begin() const { return Blocks.begin(); }
+  const_iterator end() const { return Blocks.end(); }
+
+  /// Return the total number of instructions.
+  size_t getNumInstructions() const;
+
+  /// Remove the blocks that cannot be reached from the entry and renumber
+  /// the rest in their order. Return if any is removed.
+  bool removeUnreachableBlocks();
+
+  void Format(std::ostream &O) const;
+
+private:
+  Identifier Name;
+  unsigned NumArguments;
+  std::vector<Identifier> RegisterNames;
+  std::vector<LocalArray> Arrays;
+  BlockListTy Blocks;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(IRFunction)
+
+} // namespace simplecc
+#endif // SIMPLECC_IR_IRFUNCTION_H
@@ -0,0 +1,180 @@
+#ifndef SIMPLECC_IR_IRINSTRUCTION_H
+#define SIMPLECC_IR_IRINSTRUCTION_H
+#include "simplecc/Support/Identifier.h"
+#include "simplecc/Support/Macros.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+
+/// @brief IROperand is an operand of an IRInstruction, which is a virtual
+/// register, an immediate or none at all.
+class IROperand {
+public:
+  enum Kind : uint8_t { None, Register, Immediate };
+
+  /// Construct the none operand.
+  IROperand() = default;
+
+  static IROperand CreateRegister(unsigned Reg) {
+    return IROperand(Register, static_cast<int32_t>(Reg));
+  }
+  static IROperand CreateImmediate(int Val) {
+    return IROperand(Immediate, Val);
+  }
+
+  Kind getKind() const { return K; }
+  bool IsNone() const { return K == None; }
+  bool IsRegister() const { return K == Register; }
+  bool IsImmediate() const { return K == Immediate; }
+
+  unsigned getRegister() const {
+    assert(IsRegister() && "not a register!");
+    return static_cast<unsigned>(Value);
+  }
+  int getImmediate() const {
+    assert(IsImmediate() && "not an immediate!");
+    return Value;
+  }
+
+  bool operator==(const IROperand &RHS) const {
+    return K == RHS.K && Value == RHS.Value;
+  }
+  bool operator!=(const IROperand &RHS) const { return !(*this == RHS); }
+
+  /// Format a register as %N and an immediate as its value.
+  void Format(std::ostream &O) const;
+
+private:
+  IROperand(Kind K, int32_t Value) : K(K), Value(Value) {}
+  Kind K = None;
+  int32_t Value = 0;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(IROperand)
+
+/// @brief IRInstruction is a three-address instruction of the register-based
+/// IR. It defines at most one virtual register, the Dest, and uses its
+/// operands, each of which is a virtual register or an immediate.
+///
+/// The instructions are listed in IROpcode.def. A Call has as many operands
+/// as its callee has arguments, and the others have up to three. Only the
+/// terminators, Jump, Branch and Return, transfer the control, and they do
+/// it to the indices of the IRBasicBlock's of the function.
+class IRInstruction {
+public:
+  enum Opcode : uint8_t {
+#define HANDLE_IR_OPCODE(Name, Str) Name,
+#include "simplecc/IR/IROpcode.def"
+  };
+
+  /// The comparisons of a Branch.
+  enum Condition : uint8_t { EQ, NE, GT, GE, LT, LE };
+
+  /// The Dest of an instruction that defines no register.
+  static constexpr unsigned NoRegister = ~0U;
+
+  /// Create an instruction of the form Dest = Op A, B, C.
+  static IRInstruction Create(Opcode Op, unsigned Dest,
+                              IROperand A = IROperand(),
+                              IROperand B = IROperand(),
+                              IROperand C = IROperand());
+
+  /// Create an instruction on a named object: a global, an array or a callee.
+  static IRInstruction Create(Opcode Op, unsigned Dest, Identifier Name,
+                              IROperand A = IROperand());
+
+  /// Create a Call of Name with Args.
+  static IRInstruction CreateCall(unsigned Dest, Identifier Name,
+                                  std::vector<IROperand> Args);
+
+  /// Create a Jump to a block.
+  static IRInstruction CreateJump(unsigned Target);
+
+  /// Create a Branch to True if A compares with B, or else to False.
+  static IRInstruction CreateBranch(Condition Cond, IROperand A, IROperand B,
+                                    unsigned True, unsigned False);
+
+  /// Create a Return of A, which may be none.
+  static IRInstruction CreateReturn(IROperand A = IROperand());
+
+  Opcode getOpcode() const { return Op; }
+  static const char *getOpcodeName(Opcode Op);
+  const char *getOpcodeName() const { return getOpcodeName(Op); }
+
+  static bool IsTerminator(Opcode Op) { return Op >= Jump; }
+  bool IsTerminator() const { return IsTerminator(Op); }
+
+  /// Return if this instruction does more than defining its Dest, so it
+  /// cannot be removed even if its Dest is never used.
+  bool HasSideEffect() const;
+
+  bool HasDest() const { return Dest != NoRegister; }
+  unsigned getDest() const { return Dest; }
+  void setDest(unsigned Reg) { Dest = Reg; }
+
+  /// Operand interface.
+  unsigned getNumOperands() const {
+    return Op == Call ? static_cast<unsigned>(Arguments.size()) : NumOperands;
+  }
+  const IROperand &getOperand(unsigned I) const {
+    assert(I < getNumOperands() && "operand out of range!");
+    return Op == Call ? Arguments[I] : Operands[I];
+  }
+  void setOperand(unsigned I, IROperand Val) {
+    assert(I < getNumOperands() && "operand out of range!");
+    (Op == Call ? Arguments[I] : Operands[I]) = Val;
+  }
+
+  /// Return the global, the array or the callee.
+  Identifier getName() const { return Name; }
+
+  Condition getCondition() const {
+    assert(Op == Branch && "not a branch!");
+    return Cond;
+  }
+  static const char *getConditionName(Condition Cond);
+  /// Return the condition that holds if Cond does not.
+  static Condition getInverse(Condition Cond);
+  /// Return the condition with its operands swapped.
+  static Condition getSwapped(Condition Cond);
+  /// Evaluate Cond on constants.
+  static bool Evaluate(Condition Cond, int A, int B);
+
+  /// Return the number of blocks a terminator may go to.
+  unsigned getNumTargets() const {
+    return Op == Branch ? 2 : Op == Jump ? 1 : 0;
+  }
+  unsigned getTarget(unsigned I) const {
+    assert(I < getNumTargets() && "target out of range!");
+    return Targets[I];
+  }
+  void setTarget(unsigned I, unsigned Block) {
+    assert(I < getNumTargets() && "target out of range!");
+    Targets[I] = Block;
+  }
+
+  void Format(std::ostream &O) const;
+
+private:
+  explicit IRInstruction(Opcode Op, unsigned Dest = NoRegister)
+      : Op(Op), Dest(Dest) {}
+
+  Opcode Op;
+  Condition Cond = EQ;
+  uint8_t NumOperands = 0;
+  unsigned Dest;
+  IROperand Operands[3];
+  unsigned Targets[2] = {0, 0};
+  Identifier Name;
+  /// The operands of a Call.
+  std::vector<IROperand> Arguments;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(IRInstruction)
+
+} // namespace simplecc
+#endif // SIMPLECC_IR_IRINSTRUCTION_H
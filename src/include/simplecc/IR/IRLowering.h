@@ -0,0 +1,66 @@
+#ifndef SIMPLECC_IR_IRLOWERING_H
+#define SIMPLECC_IR_IRLOWERING_H
+#include "simplecc/CodeGen/ByteCodeCFG.h"
+#include "simplecc/IR/IRInstruction.h"
+#include "simplecc/Support/ErrorManager.h"
+#include "simplecc/Support/Identifier.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+class ByteCode;
+class ByteCodeFunction;
+class ByteCodeModule;
+class IRFunction;
+class IRModule;
+
+/// @brief IRLowering lowers a ByteCodeModule to an IRModule.
+///
+/// The blocks are those of the ByteCodeCFG. The operand stack of each block
+/// is simulated at compile time, so a push becomes an operand and an
+/// operation on the stack becomes an instruction on virtual registers. A
+/// scalar local lives in a register of its own and an operand that refers to
+/// it is copied to a temporary before the local is assigned. A store of the result of the last instruction goes
+/// straight into the register of the local.
+///
+/// The code must be plain ByteCode's without superinstructions. The operand
+/// stack must be empty at each jump and jump target, as the compiler makes it.
+class IRLowering {
+public:
+  IRLowering();
+
+  /// Lower a module into IR, which is cleared first.
+  /// Return true if errors happened.
+  bool Lower(const ByteCodeModule &M, IRModule &IR);
+
+private:
+  bool LowerFunction(const ByteCodeFunction &Fn, IRFunction &F);
+  /// Lower one ByteCode into the current block.
+  bool LowerByteCode(const ByteCode &C, unsigned Offset);
+  /// Return the block that starts at an offset.
+  unsigned getBlockAt(unsigned Offset) const { return BlockAt[Offset]; }
+  /// Append an instruction to the current block.
+  void append(IRInstruction I);
+  /// Pop the operand stack, which must not be empty.
+  IROperand pop();
+  /// Copy the uses of Reg on the operand stack into temporaries.
+  void materialize(unsigned Reg);
+
+  /// Whether a global is an array, by name.
+  std::unordered_map<Identifier, bool> Globals;
+  /// The register of a scalar local or the array flag of an array.
+  std::unordered_map<Identifier, std::pair<unsigned, bool>> Locals;
+  /// Reused for each function.
+  ByteCodeCFG TheCFG;
+  std::vector<unsigned> BlockAt;
+  std::vector<IROperand> Stack;
+  IRFunction *TheFunction = nullptr;
+  unsigned CurrentBlock = 0;
+  /// Registers below this hold variables and the rest are temporaries.
+  unsigned NumVariables = 0;
+  ErrorManager EM;
+};
+
+} // namespace simplecc
+#endif // SIMPLECC_IR_IRLOWERING_H
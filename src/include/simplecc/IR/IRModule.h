@@ -0,0 +1,63 @@
+#ifndef SIMPLECC_IR_IRMODULE_H
+#define SIMPLECC_IR_IRMODULE_H
+#include "simplecc/IR/IRFunction.h"
+#include "simplecc/Support/Identifier.h"
+#include "simplecc/Support/Macros.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace simplecc {
+
+/// @brief IRModule is a container of IRFunction's, together with the global
+/// variables and the string literals they refer to.
+class IRModule {
+public:
+  /// A global variable, whose Size is 0 unless it is an array.
+  struct GlobalVariable {
+    Identifier Name;
+    unsigned Size;
+    bool IsArray() const { return Size != 0; }
+  };
+  using GlobalVariableListTy = std::vector<GlobalVariable>;
+  using FunctionListTy = std::vector<std::unique_ptr<IRFunction>>;
+
+  IRModule() = default;
+  IRModule(const IRModule &) = delete;
+  IRModule &operator=(const IRModule &) = delete;
+
+  const GlobalVariableListTy &getGlobalVariables() const { return Globals; }
+  void addGlobalVariable(Identifier Name, unsigned Size) {
+    Globals.push_back(GlobalVariable{Name, Size});
+  }
+
+  /// Return the string literals, each of which is at its ID.
+  const std::vector<std::string> &getStringLiterals() const {
+    return StringLiterals;
+  }
+  void setStringLiteral(unsigned ID, std::string Str);
+
+  /// Append a function of the given name and return it.
+  IRFunction *createFunction(Identifier Name, unsigned NumArguments);
+
+  const FunctionListTy &getFunctionList() const { return Functions; }
+  size_t size() const { return Functions.size(); }
+  bool empty() const { return Functions.empty(); }
+  IRFunction &getFunction(unsigned I) { return *Functions[I]; }
+  const IRFunction &getFunction(unsigned I) const { return *Functions[I]; }
+
+  /// Make this module empty.
+  void clear();
+  void Format(std::ostream &O) const;
+
+private:
+  GlobalVariableListTy Globals;
+  std::vector<std::string> StringLiterals;
+  FunctionListTy Functions;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(IRModule)
+
+} // namespace simplecc
+#endif // SIMPLECC_IR_IRMODULE_H
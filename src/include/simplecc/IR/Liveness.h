@@ -0,0 +1,66 @@
+#ifndef SIMPLECC_IR_LIVENESS_H
+#define SIMPLECC_IR_LIVENESS_H
+#include <cstdint>
+#include <vector>
+
+namespace simplecc {
+class IRFunction;
+
+/// @brief RegisterSet is a set of virtual registers as a bit vector.
+class RegisterSet {
+public:
+  RegisterSet() = default;
+  explicit RegisterSet(unsigned NumRegisters)
+      : Words((NumRegisters + 63) / 64, 0) {}
+
+  bool test(unsigned Reg) const { return Words[Reg / 64] >> Reg % 64 & 1; }
+  void set(unsigned Reg) { Words[Reg / 64] |= uint64_t(1) << Reg % 64; }
+  void reset(unsigned Reg) { Words[Reg / 64] &= ~(uint64_t(1) << Reg % 64); }
+
+  /// Add the registers of RHS. Return if this set grows.
+  bool unionWith(const RegisterSet &RHS);
+  /// Set this to Use + (Out - Def). Return if this set changes.
+  bool assignTransfer(const RegisterSet &Use, const RegisterSet &Out,
+                      const RegisterSet &Def);
+
+  /// Call Fn on each register in ascending order.
+  template <typename FnT> void forEach(FnT Fn) const {
+    for (unsigned W = 0, E = Words.size(); W < E; ++W) {
+      for (uint64_t Bits = Words[W]; Bits; Bits &= Bits - 1)
+        Fn(W * 64 + CountTrailingZeros(Bits));
+    }
+  }
+
+private:
+  static unsigned CountTrailingZeros(uint64_t Bits) {
+    unsigned N = 0;
+    while (!(Bits & 1)) {
+      Bits >>= 1;
+      ++N;
+    }
+    return N;
+  }
+  std::vector<uint64_t> Words;
+};
+
+/// @brief Liveness computes the virtual registers that are live on entry to
+/// and on exit from each block of an IRFunction, by the usual backward
+/// dataflow iterated to a fixed point.
+class Liveness {
+public:
+  Liveness() = default;
+
+  void Compute(const IRFunction &F);
+
+  const RegisterSet &getLiveIn(unsigned Block) const { return LiveIn[Block]; }
+  const RegisterSet &getLiveOut(unsigned Block) const {
+    return LiveOut[Block];
+  }
+
+private:
+  std::vector<RegisterSet> LiveIn;
+  std::vector<RegisterSet> LiveOut;
+};
+
+} // namespace simplecc
+#endif // SIMPLECC_IR_LIVENESS_H
@@ -0,0 +1,86 @@
+#ifndef SIMPLECC_INTERPRETER_BYTECODEINTERPRETER_H
+#define SIMPLECC_INTERPRETER_BYTECODEINTERPRETER_H
+#include "simplecc/Support/ErrorManager.h"
+#include "simplecc/Support/Identifier.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+class ByteCodeModule;
+class ByteCodeFunction;
+
+/// @brief ByteCodeInterpreter runs a ByteCodeModule without the MIPS
+/// simulator.
+///
+/// Each function is first lowered to an array of Instr with everything that
+/// the MIPS backend looks up by name resolved: a local to its slot in the
+/// frame, a global to its address, a call to its callee and a string literal
+/// to its text. The Instr's are then run by a loop that dispatches on their
+/// opcodes by computed goto where the compiler has it. The superinstructions
+/// of ByteCodeFuser are run as they are, so fusing first saves dispatches.
+///
+/// Memory is an array of 32-bit words holding the globals followed by the
+/// stack. A frame is the arguments, which the caller has pushed, and the
+/// locals followed by the operand stack. The address of an array is the
+/// index of its first element in the memory, so subscripts are checked
+/// against the memory rather than the array, like they are on MIPS.
+///
+/// Reads and writes behave as in the native program from the LLVM backend:
+/// a character read skips white space, and a failed read gives 0.
+class ByteCodeInterpreter {
+public:
+  ByteCodeInterpreter();
+  ~ByteCodeInterpreter();
+  ByteCodeInterpreter(const ByteCodeInterpreter &) = delete;
+  ByteCodeInterpreter &operator=(const ByteCodeInterpreter &) = delete;
+
+  /// Set the number of words of the memory, which limits the recursion.
+  void setMemorySize(size_t Words) { MemorySize = Words; }
+
+  /// Run main() of a module, reading In and writing Out.
+  /// Return true if errors happened.
+  bool Run(const ByteCodeModule &M, std::istream &In, std::ostream &Out);
+
+private:
+  struct Instr {
+    uint32_t Op;
+    int32_t A;
+    int32_t B;
+  };
+
+  struct Function {
+    Identifier Name;
+    std::vector<Instr> Code;
+    unsigned NumArguments;
+    /// The words of the arguments and the locals.
+    unsigned FrameSize;
+    /// A bound of the depth of the operand stack.
+    unsigned MaxStackDepth;
+  };
+
+  /// Lower the module into Functions. Return true if errors happened.
+  bool Lower(const ByteCodeModule &M);
+  bool LowerFunction(const ByteCodeFunction &Fn, Function &F);
+
+  /// Run the lowered main(). Return true if errors happened.
+  bool Execute(std::istream &In, std::ostream &Out);
+
+  std::vector<Function> Functions;
+  unsigned MainIndex = 0;
+  /// The address and whether it is an array of each global.
+  std::unordered_map<Identifier, std::pair<unsigned, bool>> Globals;
+  std::unordered_map<Identifier, unsigned> FunctionIndices;
+  unsigned GlobalSize = 0;
+  /// The text of the string literals by their IDs.
+  std::vector<std::string> StringLiterals;
+  size_t MemorySize;
+  ErrorManager EM;
+};
+} // namespace simplecc
+#endif // SIMPLECC_INTERPRETER_BYTECODEINTERPRETER_H
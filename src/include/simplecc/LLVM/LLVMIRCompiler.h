@@ -147,7 +147,7 @@ private:
   /// Local Constant => ConstantInt.
   /// Local Array/Variable => Alloca(Type, ArraySize=nullptr).
   /// Global Stuffs => As it in GlobalValues.
-  std::unordered_map<std::string, Value *> LocalValues;
+  std::unordered_map<Identifier, Value *> LocalValues;
 
   /// Keep track of global name binding.
   /// Global Constant => GlobalVariable(IsConstant=true, ExternalLinkage).
@@ -156,7 +156,7 @@ private:
   /// Global Variable => GlobalVariable(Initializer=Zero, ExternalLinkage).
   /// Global Function => Function(ExternalLinkage).
   /// printf/scanf => External Function Declaration.
-  std::unordered_map<std::string, Value *> GlobalValues;
+  std::unordered_map<Identifier, Value *> GlobalValues;
 
   /// Error handling. There should not be any user's errors in the stage.
   /// But developer can make mistakes and this EM will tell.
@@ -0,0 +1,55 @@
+#ifndef SIMPLECC_LEX_LEXER_H
+#define SIMPLECC_LEX_LEXER_H
+#include "simplecc/Lex/SourceBuffer.h"
+#include "simplecc/Lex/TokenInfo.h"
+#include <iostream>
+#include <string>
+
+namespace simplecc {
+/// This class turns source text into tokens one at a time, on demand.
+/// It either lexes a SourceBuffer that is already filled, or reads an
+/// input stream line by line into a SourceBuffer as more tokens are asked for.
+/// No more than one line is looked at ahead of the last token returned.
+class Lexer {
+public:
+  /// Lex the whole text of Source.
+  explicit Lexer(const SourceBuffer &Source)
+      : Source(Source), Writable(nullptr), Input(nullptr),
+        Cursor(Source.getBufferStart()) {}
+
+  /// Lex lines as they are read from Input and appended to Source.
+  Lexer(SourceBuffer &Source, std::istream &Input)
+      : Source(Source), Writable(&Source), Input(&Input), Cursor(nullptr) {}
+
+  /// Return the next token. Once the input is exhausted, return ENDMARKER
+  /// on each call.
+  TokenInfo Lex();
+
+  /// Return the number of tokens returned so far.
+  size_t getNumTokens() const { return NumTokens; }
+
+private:
+  /// Move to the next line. Return false if no line is left.
+  bool NextLine();
+
+  /// Return the lower-cased Identifier of a NAME.
+  Identifier InternName(const char *Name, unsigned Length);
+
+  const SourceBuffer &Source;
+  /// Source as a mutable object, if the text is streamed.
+  SourceBuffer *Writable;
+  /// The stream to read lines from, if any.
+  std::istream *Input;
+  /// Beginning of the next line in a contiguous buffer.
+  const char *Cursor;
+  /// The current line.
+  const char *TheLine = nullptr;
+  unsigned Max = 0;
+  unsigned Pos = 0;
+  unsigned Lineno = 0;
+  size_t NumTokens = 0;
+  /// Scratch space to lower-case a NAME.
+  std::string Lowered;
+};
+} // namespace simplecc
+#endif // SIMPLECC_LEX_LEXER_H
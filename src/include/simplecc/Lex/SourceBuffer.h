@@ -0,0 +1,90 @@
+#ifndef SIMPLECC_LEX_SOURCEBUFFER_H
+#define SIMPLECC_LEX_SOURCEBUFFER_H
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+/// This class owns the text of a source file.
+/// Tokens point into it so that the lexer never copies the text of a line.
+/// A line is only recovered when a diagnostic asks for it.
+///
+/// The text is filled in one of two ways.
+/// - A whole regular file is memory-mapped where the platform supports it.
+///   A pipe, a device or a file that cannot be mapped is read in one go.
+///   The text is one contiguous buffer.
+/// - A stream is appended line by line while it is being lexed, so lexing
+///   can start before the whole input arrives. The text is then made of
+///   chunks that never move once filled.
+///
+/// Either way, the text is **not** NUL-terminated.
+class SourceBuffer {
+public:
+  SourceBuffer() = default;
+  explicit SourceBuffer(std::string Text);
+  SourceBuffer(const SourceBuffer &) = delete;
+  SourceBuffer &operator=(const SourceBuffer &) = delete;
+  ~SourceBuffer() { clear(); }
+
+  /// Replace the content of this buffer with that of a file.
+  /// Return true on error.
+  bool ReadFile(const std::string &Filename);
+
+  /// Replace the content of this buffer with all the chars of an input stream.
+  void ReadFrom(std::istream &IS);
+
+  /// Read one line from an input stream and append it to this buffer.
+  /// Line and Length are set to the chars of the line, without the newline.
+  /// Return false if no line is left.
+  bool AppendLine(std::istream &IS, const char *&Line, unsigned &Length);
+
+  /// Return a ptr to the first char of the text.
+  /// Only valid if the text is contiguous.
+  const char *getBufferStart() const {
+    assert(!IsStreamed && "Streamed text is not contiguous");
+    return BufferStart;
+  }
+
+  /// Return a ptr past the last char of the text.
+  /// Only valid if the text is contiguous.
+  const char *getBufferEnd() const { return getBufferStart() + Size; }
+
+  /// Return the number of chars in the text.
+  unsigned size() const { return Size; }
+
+  /// Return if the text was memory-mapped.
+  bool isMapped() const { return IsMapped; }
+
+  /// Return if the text was appended line by line.
+  bool isStreamed() const { return IsStreamed; }
+
+  /// Return the line of code containing the char at Pos, without
+  /// the trailing newline.
+  std::string getLine(const char *Pos) const;
+
+  void clear();
+
+private:
+  /// Make the buffer refer to the owned Storage.
+  void setStorage(std::string Text);
+
+  /// Holds the text when it was read rather than mapped.
+  std::string Storage;
+  const char *BufferStart = "";
+  unsigned Size = 0;
+  bool IsMapped = false;
+  bool IsStreamed = false;
+
+  /// A chunk of streamed text. Lines never straddle chunks.
+  struct Chunk {
+    std::unique_ptr<char[]> Data;
+    unsigned Capacity;
+    unsigned Used;
+  };
+  std::vector<Chunk> Chunks;
+};
+} // namespace simplecc
+#endif // SIMPLECC_LEX_SOURCEBUFFER_H
@@ -1,7 +1,9 @@
 #ifndef SIMPLECC_LEX_TOKENINFO_H
 #define SIMPLECC_LEX_TOKENINFO_H
 #include "simplecc/Lex/Location.h"
+#include "simplecc/Lex/SourceBuffer.h"
 #include "simplecc/Parse/Grammar.h"
+#include "simplecc/Support/Identifier.h"
 #include "simplecc/Support/Macros.h"
 #include <iostream>
 #include <string>
@@ -9,9 +11,12 @@
 
 namespace simplecc {
 /// This class represents a single token.
+/// A token does not own its text. It refers to a range of chars in the
+/// SourceBuffer it was lexed from, which must outlive it.
 class TokenInfo {
 public:
-  TokenInfo(Symbol Ty, std::string S, Location Loc, std::string Line);
+  TokenInfo(Symbol Ty, const SourceBuffer *Source, const char *Data,
+            unsigned Length, Location Loc, Identifier Id = Identifier());
   TokenInfo(const TokenInfo &) = default;
   TokenInfo(TokenInfo &&) = default;
 
@@ -21,12 +26,25 @@ public:
   /// Return the location this token was found.
   Location getLocation() const { return Loc; }
 
-  /// Return the string value of this token.
+  /// Return the string value of this token. A NAME is lower-cased.
   /// Virtual tokens like ENDMARKER have an empty one.
-  const std::string &getString() const { return Str; }
+  std::string getString() const;
+
+  /// Return the lower-cased Identifier of a NAME, or the empty one
+  /// for other tokens.
+  Identifier getIdentifier() const { return Id; }
 
   /// Return the line of code where this token was found.
-  const std::string &getLine() const { return Line; }
+  /// The line is recovered from the SourceBuffer on each call,
+  /// so this is intended for diagnostics only.
+  std::string getLine() const;
+
+  /// Return a ptr to the chars of this token as they are in the source,
+  /// or nullptr for virtual tokens.
+  const char *getData() const { return Data; }
+
+  /// Return the number of chars of this token.
+  unsigned getLength() const { return Length; }
 
   /// Return the type of this token, which must be a terminal.
   Symbol getType() const { return Type; }
@@ -47,9 +65,11 @@ public:
 
 private:
   Symbol Type;
-  std::string Str;
+  unsigned Length;
+  const char *Data;
   Location Loc;
-  std::string Line;
+  const SourceBuffer *Source;
+  Identifier Id;
 };
 
 DEFINE_INLINE_OUTPUT_OPERATOR(TokenInfo)
@@ -1,12 +1,18 @@
 #ifndef SIMPLECC_LEX_TOKENIZE_H
 #define SIMPLECC_LEX_TOKENIZE_H
+#include "simplecc/Lex/Lexer.h"
+#include "simplecc/Lex/SourceBuffer.h"
 #include "simplecc/Lex/TokenInfo.h"
 #include <iostream>
 #include <vector>
 
 namespace simplecc {
-/// This function tokenizes an input stream and adds all tokens to a vector.
-void Tokenize(std::istream &Input, std::vector<TokenInfo> &Output);
+/// This function tokenizes a SourceBuffer and adds all tokens to a vector.
+/// The tokens refer into Source, which must outlive them.
+void Tokenize(const SourceBuffer &Source, std::vector<TokenInfo> &Output);
+
+/// This function pulls all the tokens from a Lexer and adds them to a vector.
+void Tokenize(Lexer &L, std::vector<TokenInfo> &Output);
 
 /// This function prints a vector of tokens to an output stream with proper align.
 void PrintTokens(const std::vector<TokenInfo> &Tokens, std::ostream &O);
@@ -2,7 +2,9 @@
 #define SIMPLECC_PARSE_ASTBUILDER_H
 #include "simplecc/AST/AST.h"
 #include "simplecc/Support/ErrorManager.h"
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simplecc {
@@ -19,6 +21,9 @@ class ASTBuilder {
   /// program: const_decl* declaration* ENDMARKER
   ProgramAST *visit_program(std::string Filename, Node *N);
 
+  /// const_decl | declaration
+  void visit_program_item(Node *N, std::vector<DeclAST *> &Decls);
+
   /// const_decl: 'const' type_name const_item (',' const_item)* ';'
   void visit_const_decl(Node *N, std::vector<DeclAST *> &Decls);
 
@@ -35,7 +40,7 @@ class ASTBuilder {
   void visit_decl_trailer(Node *N, Node *TypeName, Node *Name,
                           std::vector<DeclAST *> &Decls);
 
-  DeclAST *visit_funcdef(BasicTypeKind RetTy, std::string Name,
+  DeclAST *visit_funcdef(BasicTypeKind RetTy, Identifier Name,
                          Node *decl_trailer, Location L);
 
   /// paralist: '(' type_name NAME (',' type_name NAME)* ')'
@@ -99,7 +104,7 @@ class ASTBuilder {
   ExprAST *visit_atom(Node *N, ExprContextKind Context);
 
   /// atom_trailer: '[' expr ']' | arglist
-  ExprAST *visit_atom_trailer(Node *N, const std::string &Name,
+  ExprAST *visit_atom_trailer(Node *N, Identifier Name,
                               ExprContextKind Context);
 
   /// arglist: '(' expr (',' expr)* ')'
@@ -110,15 +115,35 @@ class ASTBuilder {
 
   /// Handle conversion from string to integer.
   /// If the resultant integer exceeds the range of int,
-  /// report error through EM.
+  /// record an error to be reported by Build().
   int evaluate_integer(const std::string &Str, Location L);
+
+  /// Report the errors recorded so far through EM.
+  void FlushErrors();
 public:
+  ASTBuilder() : TheContext(new ASTContext) {}
+
   /// Create an AST from the parse tree and the filename.
   /// On error, return nullptr and print an error.
   std::unique_ptr<ProgramAST, DeleteAST>
       Build(const std::string &Filename, const Node *N);
+
+  /// Create the AST of a child of the program rule and add it to Decls.
+  /// This allows the AST to be built while the program is being parsed.
+  void BuildDecl(const Node *N, std::vector<DeclAST *> &Decls);
+
+  /// Create an AST from the declarations made by BuildDecl() and the filename.
+  /// On error, return nullptr, print an error and delete the declarations.
+  std::unique_ptr<ProgramAST, DeleteAST>
+      Build(const std::string &Filename, std::vector<DeclAST *> Decls);
 private:
   ErrorManager EM;
+  /// All the nodes are created in this context, which is handed over to
+  /// the ProgramAST by Build().
+  std::unique_ptr<ASTContext> TheContext;
+  /// Errors are only reported when the whole program has been built, so
+  /// they cannot interleave with syntax errors when building while parsing.
+  std::vector<std::pair<Location, std::string>> PendingErrors;
 };
 } // namespace simplecc
 #endif // SIMPLECC_PARSE_ASTBUILDER_H
\ No newline at end of file
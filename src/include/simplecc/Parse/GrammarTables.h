@@ -0,0 +1,81 @@
+#ifndef SIMPLECC_PARSE_GRAMMARTABLES_H
+#define SIMPLECC_PARSE_GRAMMARTABLES_H
+#include "simplecc/Parse/Grammar.h"
+#include "simplecc/Support/Identifier.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace simplecc {
+class TokenInfo;
+
+/// This struct tells what the Parser does upon a label in a DFA state.
+struct ParseAction {
+  enum ActionKind : unsigned char {
+    /// No arc accepts the label and the state is not final.
+    Error,
+    /// Shift the token and go to NewState.
+    Shift,
+    /// Go to NewState and push the DFA of NonTerminal.
+    Push,
+    /// The state is final: pop the DFA and try the label again.
+    Pop,
+  };
+  ActionKind Kind;
+  int NewState;
+  int NonTerminal;
+};
+
+/// This class holds lookup tables precomputed from a Grammar, so that the
+/// Parser never scans the raw tables of Grammar.cpp while parsing.
+/// The tables of a Grammar are built once on first use and then shared.
+class GrammarTables {
+public:
+  /// Return the tables of a Grammar, building them if needed.
+  static const GrammarTables &get(const Grammar *G);
+
+  /// Return the label value for a token.
+  /// A NAME is looked up by its Identifier so that no string is hashed.
+  /// Return -1 for failure.
+  int Classify(const TokenInfo &T) const;
+
+  /// Return the action to take upon a label in a state of a DFA.
+  /// DFAIndex is the value of the non-terminal minus NT_OFFSET.
+  const ParseAction &getAction(int DFAIndex, int State, int Label) const {
+    return Actions[(DFABase[DFAIndex] + State) * TheGrammar->n_labels + Label];
+  }
+
+  /// Return if the label is in the first set of a DFA.
+  bool IsInFirstSet(int DFAIndex, int Label) const {
+    return FirstSets[DFAIndex][Label];
+  }
+
+  const Grammar *getGrammar() const { return TheGrammar; }
+
+private:
+  explicit GrammarTables(const Grammar *G);
+
+  /// Fill in the actions of all states of a DFA.
+  void ComputeActions(int DFAIndex);
+
+  const Grammar *TheGrammar;
+  /// Map a keyword to its label.
+  std::unordered_map<Identifier, int> KeywordLabels;
+  /// Return the chars of an operator packed in an integer, or 0 if it is
+  /// too long to be one.
+  static uint32_t getOperatorKey(const char *Data, size_t Length);
+
+  /// Map the packed chars of an operator to its label.
+  std::unordered_map<uint32_t, int> OperatorLabels;
+  /// Map a terminal type to its label, or -1.
+  std::vector<int> TokenLabels;
+  /// One bitset of labels per DFA.
+  std::vector<std::vector<bool>> FirstSets;
+  /// The dense [state][label] action table of all DFAs.
+  std::vector<ParseAction> Actions;
+  /// The index of the first state of each DFA in all states.
+  std::vector<int> DFABase;
+};
+} // namespace simplecc
+#endif // SIMPLECC_PARSE_GRAMMARTABLES_H
@@ -2,56 +2,119 @@
 #define SIMPLECC_PARSE_NODE_H
 #include "simplecc/Lex/Location.h"
 #include "simplecc/Parse/Grammar.h"
+#include "simplecc/Support/BumpPtrAllocator.h"
+#include "simplecc/Support/Identifier.h"
 #include "simplecc/Support/Macros.h"
 #include <iostream>
 #include <string>
 #include <utility>
-#include <vector>
 #include <cassert>
 
 namespace simplecc {
+/// This class represents a node of the concrete syntax tree.
+/// Nodes live in the arena of a ParseTree and are never freed one by one.
+/// The value of a node refers to either the source text or the spelling of
+/// its Identifier, and the children are a contiguous array in the arena.
 class Node {
 public:
-  using ChildrenListType = std::vector<Node *>;
-  Node(Symbol Ty, std::string Val, Location L);
-  ~Node();
+  Node(Symbol Ty, const char *Val, unsigned Len, Location L,
+       Identifier Id = Identifier())
+      : Type(Ty), NumChildren(0), ValueLength(Len), Value(Val),
+        Children(nullptr), Loc(L), Id(Id) {}
 
   /// Iterator Interface to children Nodes.
-  using iterator = ChildrenListType::iterator;
-  using const_iterator = ChildrenListType::const_iterator;
+  using iterator = Node *const *;
+  using const_iterator = Node *const *;
 
-  iterator begin() { return std::begin(Children); }
-  iterator end() { return std::end(Children); }
-  const_iterator begin() const { return std::begin(Children); }
-  const_iterator end() const { return std::end(Children); }
+  /// A view of the children array.
+  class ChildrenListType {
+    const_iterator Begin, End;
 
-  const std::vector<Node *> &getChildren() const { return Children; }
-  std::vector<Node *> &getChildren() { return Children; }
+  public:
+    ChildrenListType(const_iterator B, const_iterator E) : Begin(B), End(E) {}
+    const_iterator begin() const { return Begin; }
+    const_iterator end() const { return End; }
+  };
+
+  const_iterator begin() const { return Children; }
+  const_iterator end() const { return Children + NumChildren; }
+
+  ChildrenListType getChildren() const { return {begin(), end()}; }
+
+  /// Set the children of this node, which must live as long as the node.
+  void setChildren(Node *const *Begin, unsigned Num) {
+    Children = Begin;
+    NumChildren = Num;
+  }
 
-  void AddChild(Node *child) { Children.push_back(child); }
   Node *getFirstChild() const { return getChild(0); }
   Node *getLastChild() const { return getChild(getNumChildren() - 1); }
   Node *getChild(unsigned Idx) const {
-    assert(getNumChildren() >= 0 && Idx < getNumChildren());
+    assert(Idx < getNumChildren());
     return Children[Idx];
   }
-  size_t getNumChildren() const { return Children.size(); }
+  size_t getNumChildren() const { return NumChildren; }
 
   Symbol getType() const { return Type; }
   const char *getTypeName() const;
   Location getLocation() const { return Loc; }
-  const std::string &getValue() const { return Value; }
+  std::string getValue() const { return std::string(Value, ValueLength); }
+  /// Return the Identifier of a NAME node.
+  Identifier getIdentifier() const {
+    assert(Type == Symbol::NAME && "Only NAME has an Identifier");
+    return Id;
+  }
   void Format(std::ostream &O) const;
   void dump() const;
 
 private:
   Symbol Type;
-  std::string Value;
-  ChildrenListType Children;
+  unsigned NumChildren;
+  unsigned ValueLength;
+  const char *Value;
+  Node *const *Children;
   Location Loc;
+  Identifier Id;
 };
 
 DEFINE_INLINE_OUTPUT_OPERATOR(Node)
 
+/// This class owns a concrete syntax tree. All of its Nodes are allocated
+/// in one arena, so the whole tree is freed in one shot.
+class ParseTree {
+public:
+  ParseTree() = default;
+  ParseTree(const ParseTree &) = delete;
+  ParseTree &operator=(const ParseTree &) = delete;
+
+  Node *getRoot() const { return Root; }
+  void setRoot(Node *N) { Root = N; }
+
+  /// Create a Node in the arena.
+  Node *CreateNode(Symbol Ty, const char *Val, unsigned Len, Location L,
+                   Identifier Id = Identifier()) {
+    ++NumNodes;
+    return Arena.Create<Node>(Ty, Val, Len, L, Id);
+  }
+
+  /// Return the arena where Nodes and their children arrays live.
+  BumpPtrAllocator &getAllocator() { return Arena; }
+
+  /// Return the number of Nodes created.
+  unsigned getNumNodes() const { return NumNodes; }
+
+  void Format(std::ostream &O) const {
+    assert(Root && "Empty ParseTree");
+    Root->Format(O);
+  }
+
+private:
+  BumpPtrAllocator Arena;
+  Node *Root = nullptr;
+  unsigned NumNodes = 0;
+};
+
+DEFINE_INLINE_OUTPUT_OPERATOR(ParseTree)
+
 } // namespace simplecc
-#endif // SIMPLECC_PARSE_NODE_H
\ No newline at end of file
+#endif // SIMPLECC_PARSE_NODE_H
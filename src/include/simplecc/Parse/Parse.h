@@ -1,5 +1,6 @@
 #ifndef SIMPLECC_PARSE_PARSE_H
 #define SIMPLECC_PARSE_PARSE_H
+#include "simplecc/Lex/Lexer.h"
 #include "simplecc/Lex/TokenInfo.h"
 #include "simplecc/AST/AST.h"
 #include "simplecc/Parse/Node.h"
@@ -10,13 +11,27 @@
 namespace simplecc {
 
 /// Parse the tokens and create a parse tree (or concrete syntax tree) from them.
-std::unique_ptr<Node>
+/// The tree refers to the source text of the tokens, which must outlive it.
+std::unique_ptr<ParseTree>
 BuildCST(const std::vector<TokenInfo> &TheTokens);
 
+/// Parse the tokens pulled from a Lexer and create a parse tree from them.
+std::unique_ptr<ParseTree> BuildCST(Lexer &TheLexer);
+
 /// Parse the tokens and create an AST from them.
+/// The AST is built while parsing without creating the CST of the whole program.
 /// Return nullptr on error.
 std::unique_ptr<ProgramAST, DeleteAST>
 BuildAST(const std::string &Filename, const std::vector<TokenInfo> &TheTokens);
 
+/// Parse the tokens pulled from a Lexer and create an AST from them.
+/// The tokens are never all held in memory at once.
+/// If NumCSTNodes is not nullptr, the number of CST nodes created while
+/// parsing is stored in it.
+/// Return nullptr on error.
+std::unique_ptr<ProgramAST, DeleteAST>
+BuildAST(const std::string &Filename, Lexer &TheLexer,
+         size_t *NumCSTNodes = nullptr);
+
 } // namespace simplecc
 #endif // SIMPLECC_PARSE_PARSE_H
\ No newline at end of file
@@ -1,7 +1,11 @@
 #ifndef SIMPLECC_PARSE_PARSER_H
 #define SIMPLECC_PARSE_PARSER_H
+#include "simplecc/Lex/Lexer.h"
 #include "simplecc/Lex/TokenInfo.h"
+#include "simplecc/Parse/GrammarTables.h"
+#include "simplecc/Parse/Node.h"
 #include "simplecc/Support/ErrorManager.h"
+#include <functional>
 #include <iostream>
 #include <stack>
 #include <string>
@@ -9,7 +13,6 @@
 #include <memory> // unique_ptr
 
 namespace simplecc {
-class Node;
 
 /// @brief Parser is a push-down finite state machine that parses the tokens
 /// linearly with one lookahead without any recursion call.
@@ -19,68 +22,95 @@ class Parser {
   class StackEntry {
     /// @brief TheDFA is the grammar rule that is being expanded.
     const DFA *TheDFA;
+    /// @brief TheIndex is the index of TheDFA in the grammar.
+    int TheIndex;
     /// @brief TheState is the current state of TheDFA.
     int TheState;
     /// @brief TheNode is the Node being constructed under the grammar rule.
     Node *TheNode;
-    // use unique_ptr.
+    /// @brief ChildrenBegin is where the children of TheNode start in the
+    /// Parser's PendingChildren.
+    unsigned ChildrenBegin;
 
   public:
-    StackEntry(const DFA *D, int State, Node *N)
-        : TheDFA(D), TheState(State), TheNode(N) {}
+    StackEntry(const DFA *D, int Index, int State, Node *N, unsigned Begin)
+        : TheDFA(D), TheIndex(Index), TheState(State), TheNode(N),
+          ChildrenBegin(Begin) {}
 
     const DFA *getDFA() const { return TheDFA; }
+    int getDFAIndex() const { return TheIndex; }
     int getState() const { return TheState; }
     Node *getNode() const { return TheNode; }
+    unsigned getChildrenBegin() const { return ChildrenBegin; }
     void setState(int S) { TheState = S; }
+    void setNode(Node *N) { TheNode = N; }
 
     /// @brief Debug helper.
     void Format(std::ostream &O) const;
   };
 
-  /// @brief Lookup the label value for a token type and token value.
-  /// Return -1 for failure.
-  int Classify(Symbol Type, const std::string &Value);
-
   /// @brief Shift a token, update the state.
   void Shift(const TokenInfo &T, int NewState);
 
   /// @brief Push a non-terminal onto the stack, update the state.
-  void Push(Symbol Ty, const DFA *NewDFA, int NewState, Location Loc);
+  void Push(Symbol Ty, int NewState, Location Loc);
 
   /// @brief Pop the stack, add the node of the old TOS as a child to the node of the new TOS.
+  /// The children of the old TOS are moved into the arena as a contiguous array.
   void Pop();
 
+  /// @brief Hand the completed parse tree over to the caller.
+  std::unique_ptr<ParseTree> TakeTree();
+
+  /// @brief Start the parse tree afresh once the handler has taken all the
+  /// completed children of the start rule.
+  void RecycleTree();
+
   /// @brief Add one token, loop until:
   /// 1. we are done. Return 1.
   /// 2. error. Return -1.
   /// 3. the token was shifted. Return 0.
   int AddToken(const TokenInfo &T);
 
-  /// @brief Return if the label is in the first set of \param D.
-  static bool IsInFirstSet(const DFA *D, int Label);
-
   /// @brief Return if the \param State is an accept-only state.
   /// Accept-only state means this state can only transform to an accept state.
   static bool IsAcceptOnlyState(const DFAState *State);
 
 public:
+  /// @brief The type of a callback that takes a completed child of the start rule.
+  using TopLevelHandler = std::function<void(const Node *)>;
+
   /// @brief Construct a Parser from a Grammar object.
   explicit Parser(const Grammar *G);
-  // TODO: cleanup the stack.
   ~Parser() = default;
 
-  /// @brief Parse the tokens, return the root of a parse tree if no errors.
+  /// @brief Hand each completed child of the start rule to \param H instead of
+  /// attaching it to the root. The memory of the child is reused once \param H
+  /// returns, so the full parse tree is never materialized. The tree returned by
+  /// ParseTokens() then has only the terminal children of the root.
+  void setTopLevelHandler(TopLevelHandler H) { Handler = std::move(H); }
+
+  /// @brief Parse the tokens, return the parse tree if no errors.
   /// Return nullptr on errors.
-  std::unique_ptr<Node> ParseTokens(const std::vector<TokenInfo> &Tokens);
+  std::unique_ptr<ParseTree> ParseTokens(const std::vector<TokenInfo> &Tokens);
+
+  /// @brief Parse the tokens pulled from a Lexer one at a time, return the
+  /// parse tree if no errors. Return nullptr on errors.
+  std::unique_ptr<ParseTree> ParseTokens(Lexer &L);
 
 private:
   // The parse stack.
   std::stack<StackEntry> TheStack;
   // The grammar rule table.
   const Grammar *TheGrammar;
-  // Borrowed pointer to the root of the parse tree.
-  Node *RootNode = nullptr;
+  // Lookup tables precomputed from TheGrammar.
+  const GrammarTables &TheTables;
+  // The parse tree being built. All Nodes are allocated in it.
+  std::unique_ptr<ParseTree> TheTree;
+  // Children of the Nodes on the stack, which are not completed yet.
+  std::vector<Node *> PendingChildren;
+  // Optional consumer of the children of the start rule.
+  TopLevelHandler Handler;
   // Report syntax error.
   ErrorManager EM;
 };
@@ -0,0 +1,122 @@
+#ifndef SIMPLECC_SUPPORT_BUMPPTRALLOCATOR_H
+#define SIMPLECC_SUPPORT_BUMPPTRALLOCATOR_H
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+/// This class allocates memory by bumping a pointer within big slabs.
+/// Individual allocations are never freed. All the memory is released at once
+/// when the allocator is reset, rewound or destroyed. Destructors of objects created
+/// in it are **not** run, so only trivially destructible objects or ones whose
+/// owner runs the destructor should be put here.
+class BumpPtrAllocator {
+public:
+  BumpPtrAllocator() = default;
+  BumpPtrAllocator(const BumpPtrAllocator &) = delete;
+  BumpPtrAllocator &operator=(const BumpPtrAllocator &) = delete;
+  BumpPtrAllocator(BumpPtrAllocator &&) = default;
+  BumpPtrAllocator &operator=(BumpPtrAllocator &&) = default;
+
+  /// Return Size bytes of memory aligned to Alignment.
+  void *Allocate(size_t Size, size_t Alignment) {
+    assert(Alignment && (Alignment & (Alignment - 1)) == 0 &&
+           "Alignment must be a power of two");
+    BytesAllocated += Size;
+    auto Ptr = reinterpret_cast<uintptr_t>(CurPtr);
+    auto Aligned = (Ptr + Alignment - 1) & ~uintptr_t(Alignment - 1);
+    if (CurPtr && Aligned + Size <= reinterpret_cast<uintptr_t>(End)) {
+      CurPtr = reinterpret_cast<char *>(Aligned + Size);
+      return reinterpret_cast<void *>(Aligned);
+    }
+    return AllocateSlow(Size, Alignment);
+  }
+
+  /// Return uninitialized memory for Num objects of type T.
+  template <typename T> T *Allocate(size_t Num = 1) {
+    return static_cast<T *>(Allocate(Num * sizeof(T), alignof(T)));
+  }
+
+  /// Construct an object of type T in the allocator.
+  template <typename T, typename... Args> T *Create(Args &&... args) {
+    return new (Allocate<T>()) T(std::forward<Args>(args)...);
+  }
+
+  /// Release all the memory.
+  void Reset() {
+    Slabs.clear();
+    CustomSlabs.clear();
+    CurPtr = End = nullptr;
+    BytesAllocated = 0;
+  }
+
+  /// Release all the memory but the first slab, and allocate from its start
+  /// again. An allocator filled and emptied over and over then keeps the
+  /// slab rather than freeing it and getting a new one each time.
+  void Rewind() {
+    CustomSlabs.clear();
+    BytesAllocated = 0;
+    if (Slabs.empty())
+      return;
+    Slabs.resize(1);
+    CurPtr = Slabs.front().get();
+    End = CurPtr + SlabSize;
+  }
+
+  /// Take over all the memory of another allocator, which becomes empty.
+  /// Objects in it stay where they are and live as long as this one.
+  void Adopt(BumpPtrAllocator &Other) {
+    for (auto &Slab : Other.Slabs)
+      Slabs.push_back(std::move(Slab));
+    for (auto &Slab : Other.CustomSlabs)
+      CustomSlabs.push_back(std::move(Slab));
+    BytesAllocated += Other.BytesAllocated;
+    Other.Slabs.clear();
+    Other.CustomSlabs.clear();
+    Other.CurPtr = Other.End = nullptr;
+    Other.BytesAllocated = 0;
+  }
+
+  /// Return the number of bytes requested so far.
+  size_t getBytesAllocated() const { return BytesAllocated; }
+
+  /// Return the number of slabs obtained from the system.
+  size_t getNumSlabs() const { return Slabs.size() + CustomSlabs.size(); }
+
+private:
+  static constexpr size_t SlabSize = 4096 * 16;
+
+  void *AllocateSlow(size_t Size, size_t Alignment) {
+    // Oversized requests get a slab of their own so that the current one
+    // can still be used.
+    size_t PaddedSize = Size + Alignment - 1;
+    if (PaddedSize > SlabSize) {
+      CustomSlabs.emplace_back(new char[PaddedSize]);
+      auto Ptr = reinterpret_cast<uintptr_t>(CustomSlabs.back().get());
+      auto Aligned = (Ptr + Alignment - 1) & ~uintptr_t(Alignment - 1);
+      return reinterpret_cast<void *>(Aligned);
+    }
+    Slabs.emplace_back(new char[SlabSize]);
+    CurPtr = Slabs.back().get();
+    End = CurPtr + SlabSize;
+    auto Ptr = reinterpret_cast<uintptr_t>(CurPtr);
+    auto Aligned = (Ptr + Alignment - 1) & ~uintptr_t(Alignment - 1);
+    CurPtr = reinterpret_cast<char *>(Aligned + Size);
+    return reinterpret_cast<void *>(Aligned);
+  }
+
+  /// The slabs of SlabSize bytes, the current one last.
+  std::vector<std::unique_ptr<char[]>> Slabs;
+  /// The slabs of the oversized requests.
+  std::vector<std::unique_ptr<char[]>> CustomSlabs;
+  char *CurPtr = nullptr;
+  char *End = nullptr;
+  size_t BytesAllocated = 0;
+};
+} // namespace simplecc
+
+#endif // SIMPLECC_SUPPORT_BUMPPTRALLOCATOR_H
@@ -11,12 +11,14 @@ inline std::string Quote(const std::string &string) {
   return '\'' + string + '\'';
 }
 
-class ErrorManager : private Printer {
+/// ErrorManager reports errors to getErrs(), which is looked up for each
+/// error so that a redirection applies to ErrorManagers created before it.
+class ErrorManager {
   int ErrorCount = 0;
   const char *ErrorType;
 
 public:
-  ErrorManager(const char *ET = nullptr) : Printer(std::cerr) {
+  ErrorManager(const char *ET = nullptr) {
     setErrorType(ET);
   }
 
@@ -31,16 +33,18 @@ public:
 
   /// TODO: these 2 overloads are too easy to be ambiguous.
   template <typename... Args> void Error(Location loc, Args &&... args) {
-    getOuts() << getErrorType() << " at ";
-    loc.FormatCompact(getOuts());
-    getOuts() << " ";
-    WriteLine(std::forward<Args>(args)...);
+    std::ostream &O = getErrs();
+    O << getErrorType() << " at ";
+    loc.FormatCompact(O);
+    O << " ";
+    Print(O, std::forward<Args>(args)...);
     increaseErrorCount();
   }
 
   template <typename... Args> void Error(Args &&... args) {
-    getOuts() << getErrorType() << ": ";
-    WriteLine(std::forward<Args>(args)...);
+    std::ostream &O = getErrs();
+    O << getErrorType() << ": ";
+    Print(O, std::forward<Args>(args)...);
     increaseErrorCount();
   }
 
@@ -0,0 +1,77 @@
+#ifndef SIMPLECC_SUPPORT_IDENTIFIER_H
+#define SIMPLECC_SUPPORT_IDENTIFIER_H
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace simplecc {
+namespace detail {
+/// The interned data of an Identifier.
+struct IdentifierEntry {
+  unsigned ID;
+  unsigned Hash;
+  std::string Name;
+};
+/// The entry of the empty Identifier, which always has ID 0.
+extern const IdentifierEntry EmptyIdentifierEntry;
+} // namespace detail
+
+/// @brief Identifier is a name interned in a global table.
+/// All the Identifiers with the same spelling refer to the same entry, so
+/// comparing and hashing them costs no more than an integer. The lexer
+/// interns each NAME once and every later stage passes the Identifier
+/// along instead of a ``std::string``.
+///
+/// Entries are never freed, so an Identifier stays valid for the lifetime
+/// of the process. Interning is thread-safe while reading an Identifier
+/// never touches the table.
+class Identifier {
+  const detail::IdentifierEntry *Entry;
+  explicit Identifier(const detail::IdentifierEntry *E) : Entry(E) {}
+
+public:
+  /// Construct the empty Identifier.
+  Identifier() : Entry(&detail::EmptyIdentifierEntry) {}
+
+  /// Return the Identifier spelled by a range of chars, interning it if
+  /// it is new.
+  static Identifier get(const char *Data, size_t Length);
+  static Identifier get(const std::string &Name) {
+    return get(Name.data(), Name.size());
+  }
+
+  /// Return the Identifier whose getID() is ID, which must come from an
+  /// Identifier. This never takes a lock.
+  static Identifier getByID(unsigned ID);
+
+  /// Return the number of Identifiers interned so far.
+  static size_t getNumIdentifiers();
+
+  /// Return a small integer that is unique to this spelling.
+  unsigned getID() const { return Entry->ID; }
+
+  /// Return the spelling.
+  const std::string &str() const { return Entry->Name; }
+  const char *c_str() const { return Entry->Name.c_str(); }
+  size_t size() const { return Entry->Name.size(); }
+  bool empty() const { return getID() == 0; }
+
+  bool operator==(Identifier RHS) const { return Entry == RHS.Entry; }
+  bool operator!=(Identifier RHS) const { return Entry != RHS.Entry; }
+  /// Order by ID, which is the order of interning.
+  bool operator<(Identifier RHS) const { return getID() < RHS.getID(); }
+};
+
+inline std::ostream &operator<<(std::ostream &O, Identifier I) {
+  return O << I.str();
+}
+} // namespace simplecc
+
+namespace std {
+template <> struct hash<simplecc::Identifier> {
+  size_t operator()(simplecc::Identifier I) const { return I.getID(); }
+};
+} // namespace std
+
+#endif // SIMPLECC_SUPPORT_IDENTIFIER_H
@@ -23,8 +23,36 @@ template <typename... Args> void PrintOuts(Args &&... args) {
   Print(std::cout, std::forward<Args>(args)...);
 }
 
+namespace detail {
+/// The stream the diagnostics of this thread are redirected to, if any.
+inline std::ostream *&getErrsRedirect() {
+  thread_local std::ostream *Redirect = nullptr;
+  return Redirect;
+}
+} // namespace detail
+
+/// Return the stream for diagnostics, which is ``std::cerr`` unless this
+/// thread has redirected it with an ErrsRedirect.
+inline std::ostream &getErrs() {
+  std::ostream *Redirect = detail::getErrsRedirect();
+  return Redirect ? *Redirect : std::cerr;
+}
+
+/// Redirect the diagnostics of this thread to another stream in a scope.
+class ErrsRedirect {
+  std::ostream *Saved;
+
+public:
+  explicit ErrsRedirect(std::ostream &O) : Saved(detail::getErrsRedirect()) {
+    detail::getErrsRedirect() = &O;
+  }
+  ErrsRedirect(const ErrsRedirect &) = delete;
+  ErrsRedirect &operator=(const ErrsRedirect &) = delete;
+  ~ErrsRedirect() { detail::getErrsRedirect() = Saved; }
+};
+
 template <typename... Args> void PrintErrs(Args &&... args) {
-  Print(std::cerr, std::forward<Args>(args)...);
+  Print(getErrs(), std::forward<Args>(args)...);
 }
 
 class Printer {
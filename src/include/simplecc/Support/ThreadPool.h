@@ -0,0 +1,76 @@
+#ifndef SIMPLECC_SUPPORT_THREADPOOL_H
+#define SIMPLECC_SUPPORT_THREADPOOL_H
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simplecc {
+/// @brief ThreadPool runs tasks on a fixed number of worker threads.
+/// Each worker owns a queue. A task submitted by a worker goes to its own
+/// queue, and other tasks are spread over the queues in turn. A worker
+/// takes tasks from the back of its own queue first and steals from the
+/// front of the others when it runs out, so no worker idles while any queue
+/// has work.
+///
+/// Tasks don't return anything. They usually write their results into a
+/// slot of their own, which the submitter reads in order after wait(),
+/// so the result does not depend on the scheduling.
+class ThreadPool {
+public:
+  using TaskTy = std::function<void()>;
+
+  /// Create a pool of NumThreads workers. 0 means one per hardware thread.
+  explicit ThreadPool(unsigned NumThreads = 0);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /// Wait for all the tasks and stop the workers.
+  ~ThreadPool();
+
+  /// Submit a task to be run by some worker.
+  void async(TaskTy Task);
+
+  /// Block until all the submitted tasks have finished.
+  /// It must not be called from a task.
+  void wait();
+
+  /// Return the number of workers.
+  unsigned getNumThreads() const {
+    return static_cast<unsigned>(Workers.size());
+  }
+
+  /// Return the number of hardware threads, at least 1.
+  static unsigned getHardwareConcurrency();
+
+private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<TaskTy> Tasks;
+  };
+
+  /// The loop of the worker owning the queue at Index.
+  void Run(unsigned Index);
+  /// Take a task from our queue or steal one from the others.
+  bool PopTask(unsigned Index, TaskTy &Task);
+
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
+  std::vector<std::thread> Workers;
+
+  /// Guard the counters below.
+  std::mutex Mutex;
+  std::condition_variable WorkAvailable;
+  std::condition_variable AllDone;
+  /// The number of tasks in the queues.
+  unsigned Queued = 0;
+  /// The number of tasks not finished yet.
+  unsigned Pending = 0;
+  /// The queue to put the next task submitted from outside.
+  unsigned NextQueue = 0;
+  bool Stopping = false;
+};
+} // namespace simplecc
+
+#endif // SIMPLECC_SUPPORT_THREADPOOL_H
@@ -0,0 +1,111 @@
+#ifndef SIMPLECC_SUPPORT_TIMEREPORT_H
+#define SIMPLECC_SUPPORT_TIMEREPORT_H
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace simplecc {
+/// @brief TimeRecord is the resource usage of the process at a point of
+/// time, or the difference of two of them.
+struct TimeRecord {
+  /// Wall time in seconds.
+  double WallTime = 0;
+  /// CPU time of the process in seconds, all threads included.
+  double CPUTime = 0;
+  /// Peak resident set size in kilobytes, 0 where it is not available.
+  long PeakRSS = 0;
+  /// The number of calls to the global operator new, 0 unless the program
+  /// counts them.
+  size_t NumAllocations = 0;
+
+  /// Return the usage of now.
+  static TimeRecord getCurrentTime();
+
+  /// Return the usage between Start and this.
+  TimeRecord since(const TimeRecord &Start) const;
+};
+
+/// The calls to the global operator new on the calling thread not yet
+/// flushed. A program counts its allocations by incrementing it in its own
+/// operator new, which simplecc does unless built without
+/// SIMPLECC_COUNT_ALLOCATIONS. Each thread has its own so that counting
+/// does not make the threads contend.
+extern thread_local size_t NumThreadAllocations;
+
+/// Add the allocations of the calling thread to those of the process. A
+/// ThreadPool worker does it after each task.
+void flushThreadAllocations();
+
+/// Return the number of calls to the global operator new so far: those
+/// flushed by every thread and those of the calling thread.
+size_t getNumAllocations();
+
+/// @brief TimeReport collects the usage of each phase of the compiler.
+/// Regions are nested: a region started while another is running is
+/// reported as part of it. Each region can carry counts of the items it
+/// processed, like tokens or AST nodes.
+class TimeReport {
+public:
+  struct Region {
+    std::string Name;
+    /// The number of regions that enclose this one.
+    unsigned Depth;
+    TimeRecord Time;
+    std::vector<std::pair<std::string, size_t>> Counts;
+  };
+
+  TimeReport() = default;
+  TimeReport(const TimeReport &) = delete;
+  TimeReport &operator=(const TimeReport &) = delete;
+
+  /// Start a region nested in the running one. Return its index.
+  unsigned startRegion(std::string Name);
+  /// Stop the running region, which must be at Index.
+  void stopRegion(unsigned Index);
+  /// Add a count of items to the region at Index.
+  void addCount(unsigned Index, std::string Name, size_t Value);
+
+  /// Return the regions in the order they were started.
+  const std::vector<Region> &getRegions() const { return Regions; }
+
+  /// Print a table of the regions for humans.
+  void PrintText(std::ostream &O) const;
+  /// Print the regions as a JSON object.
+  void PrintJSON(std::ostream &O) const;
+
+  void clear();
+
+private:
+  std::vector<Region> Regions;
+  /// The running regions with their start usage, innermost last.
+  std::vector<std::pair<unsigned, TimeRecord>> Running;
+};
+
+/// @brief TimeRegion times the code in its scope as a region of a TimeReport.
+/// It does nothing if the report is nullptr, so it can be put in code
+/// that only sometimes reports time.
+class TimeRegion {
+public:
+  TimeRegion(TimeReport *R, const char *Name)
+      : Report(R), Index(R ? R->startRegion(Name) : 0) {}
+  TimeRegion(const TimeRegion &) = delete;
+  TimeRegion &operator=(const TimeRegion &) = delete;
+  ~TimeRegion() {
+    if (Report)
+      Report->stopRegion(Index);
+  }
+
+  /// Add a count of items processed in this region.
+  void addCount(const char *Name, size_t Value) {
+    if (Report)
+      Report->addCount(Index, Name, Value);
+  }
+
+private:
+  TimeReport *Report;
+  unsigned Index;
+};
+} // namespace simplecc
+#endif // SIMPLECC_SUPPORT_TIMEREPORT_H
@@ -76,6 +76,20 @@ class ByteCodeToMipsTranslator : ByteCodeVisitor<ByteCodeToMipsTranslator> {
 
   void visitPopTop(const ByteCode &C) { POP(); }
 
+  /// Superinstructions.
+  void AddConst(int Val);
+  void visitPrintStringLiteral(const ByteCode &C);
+  void visitStoreLocalConst(const ByteCode &C);
+  void visitIncrementLocal(const ByteCode &C);
+  void visitAddLocalConst(const ByteCode &C);
+  void visitBinaryJumpIfConst(const char *Op, const ByteCode &C);
+  void visitJumpIfEqualConst(const ByteCode &C);
+  void visitJumpIfNotEqualConst(const ByteCode &C);
+  void visitJumpIfGreaterConst(const ByteCode &C);
+  void visitJumpIfGreaterEqualConst(const ByteCode &C);
+  void visitJumpIfLessConst(const ByteCode &C);
+  void visitJumpIfLessEqualConst(const ByteCode &C);
+
   /// Forward WriteLine() to ThePrinter.
   template <typename... Args> void WriteLine(Args &&... Arguments) {
     ThePrinter.WriteLine(std::forward<Args>(Arguments)...);
@@ -85,10 +99,10 @@ public:
   ByteCodeToMipsTranslator(std::ostream &O, const LocalContext &C)
       : ThePrinter(O), ByteCodeVisitor(), TheContext(C) {}
 
-  /// Write one ByteCode translating to MIPS.
+  /// Write one ByteCode at offset Off translating to MIPS.
   /// Wrap OpcodeDispatcher::dispatch() to provide label
   /// generation.
-  void Write(const ByteCode &C);
+  void Write(const ByteCode &C, unsigned Off);
 
 private:
   friend ByteCodeVisitor;
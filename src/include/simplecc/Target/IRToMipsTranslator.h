@@ -0,0 +1,85 @@
+#ifndef SIMPLECC_TARGET_IRTOMIPSTRANSLATOR_H
+#define SIMPLECC_TARGET_IRTOMIPSTRANSLATOR_H
+#include "simplecc/IR/IRInstruction.h"
+#include "simplecc/Support/Print.h"
+#include "simplecc/Target/MipsRegisterAllocator.h"
+#include "simplecc/Target/MipsSupport.h"
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+
+namespace simplecc {
+class IRFunction;
+
+/// @brief IRToMipsTranslator translates an IRFunction to MIPS with the
+/// registers from MipsRegisterAllocator.
+///
+/// The calling convention is its own. The caller stores the arguments at the
+/// bottom of its frame, where the callee finds them above its own frame, and
+/// the result comes back in $v0. The frame is fixed on entry, so everything in
+/// it is addressed from $sp, with the outgoing arguments, the spill slots,
+/// the local arrays, the saved registers and $ra from bottom to top.
+class IRToMipsTranslator {
+public:
+  explicit IRToMipsTranslator(std::ostream &O) : ThePrinter(O) {}
+
+  /// Write a function, its prologue and epilogue included.
+  void Write(const IRFunction &F);
+
+private:
+  void ComputeFrame();
+  void WritePrologue();
+  void WriteEpilogue();
+  void WriteBlock(unsigned B);
+  void WriteInstruction(const IRInstruction &I);
+  void WriteBranch(const IRInstruction &I);
+
+  /// Return the offset from $sp of a spilled register.
+  int getSpillOffset(unsigned Reg) const;
+  /// Return the register an operand is in, loading it into Scratch if it is
+  /// spilled or an immediate.
+  const char *getOperand(const IROperand &Op, const char *Scratch);
+  /// Load an operand into a specific register.
+  void LoadOperand(const char *Dst, const IROperand &Op);
+  /// Return the register to compute the Dest of I in, and write the value
+  /// back by StoreDest().
+  const char *getDest(const IRInstruction &I);
+  void StoreDest(const IRInstruction &I);
+  /// Write Dst = Src + Val.
+  void AddImmediate(const char *Dst, const char *Src, int Val);
+  JumpTargetLabel getBlockLabel(unsigned B, bool NeedColon) const;
+
+  /// Forward WriteLine() to ThePrinter.
+  template <typename... Args> void WriteLine(Args &&... Arguments) {
+    ThePrinter.WriteLine(std::forward<Args>(Arguments)...);
+  }
+
+  /// Write an instruction with no operand.
+  void WriteInstr(const char *Op) { ThePrinter.getOuts() << Op << "\n"; }
+
+  /// Write an instruction with its operands separated by commas.
+  template <typename First, typename... Rest>
+  void WriteInstr(const char *Op, First &&Operand, Rest &&... Operands) {
+    std::ostream &O = ThePrinter.getOuts();
+    O << Op << " " << Operand;
+    int Expand[] = {0, ((O << ", " << Operands), 0)...};
+    (void)Expand;
+    O << "\n";
+  }
+
+  Printer ThePrinter;
+
+  const IRFunction *TheFunction = nullptr;
+  MipsRegisterAllocator TheAllocator;
+  /// The frame layout in bytes.
+  int FrameSize = 0;
+  int SpillBase = 0;
+  int SavedBase = 0;
+  bool SavesRA = false;
+  std::unordered_map<Identifier, int> ArrayOffsets;
+  /// The block written after the current one.
+  unsigned NextBlock = 0;
+};
+
+} // namespace simplecc
+#endif // SIMPLECC_TARGET_IRTOMIPSTRANSLATOR_H
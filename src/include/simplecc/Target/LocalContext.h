@@ -1,5 +1,6 @@
 #ifndef SIMPLECC_TARGET_LOCALCONTEXT_H
 #define SIMPLECC_TARGET_LOCALCONTEXT_H
+#include "simplecc/Support/Identifier.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
@@ -31,19 +32,19 @@ public:
   }
 
   /// Return the offset of local name related to frame pointer.
-  signed int getLocalOffset(const char *Name) const;
+  signed int getLocalOffset(Identifier Name) const;
 
   /// Return whether a name is a variable.
-  bool IsVariable(const char *Name) const;
+  bool IsVariable(Identifier Name) const;
 
   /// Return whether a name is an array.
-  bool IsArray(const char *Name) const;
+  bool IsArray(Identifier Name) const;
 
   /// Return the name of the function being translated.
-  const std::string &getFuncName() const;
+  Identifier getFuncName() const;
 
 private:
-  std::unordered_map<std::string, signed> LocalOffsets;
+  std::unordered_map<Identifier, signed> LocalOffsets;
   std::unordered_set<unsigned> JumpTargets;
   const ByteCodeFunction *TheFunction = nullptr;
 };
@@ -7,6 +7,9 @@
 namespace simplecc {
 class ByteCodeFunction;
 class ByteCodeModule;
+class IRFunction;
+class IRModule;
+class ThreadPool;
 
 class MipsAssemblyWriter {
   // Return the total bytes consumed by local objects, including
@@ -15,14 +18,24 @@ class MipsAssemblyWriter {
 
   /// Write data segment -- strings, arrays and variables.
   void WriteData(Printer &W, const ByteCodeModule &Module);
+  void WriteData(Printer &W, const IRModule &Module);
+  /// Write the start of the text segment.
+  void WriteTextHeader(Printer &W);
   /// Write text segment -- the bundle of functions.
   void WriteText(Printer &W, const ByteCodeModule &Module);
+  /// Write text segment with the functions translated in parallel.
+  void WriteText(Printer &W, const ByteCodeModule &Module, ThreadPool &Pool);
+  /// Write text segment from the register-based IR.
+  void WriteText(Printer &W, const IRModule &Module);
+  void WriteText(Printer &W, const IRModule &Module, ThreadPool &Pool);
   /// Write prologue for TheFunction.
   void WritePrologue(Printer &W, const ByteCodeFunction &TheFunction);
   /// Write epilogue for TheFunction.
   void WriteEpilogue(Printer &W, const ByteCodeFunction &TheFunction);
   /// Write one ByteCodeFunction to MIPS assembly.
   void WriteFunction(Printer &W, const ByteCodeFunction &TheFunction);
+  /// Write one IRFunction to MIPS assembly with its registers allocated.
+  void WriteFunction(Printer &W, const IRFunction &TheFunction);
 
 public:
   MipsAssemblyWriter() = default;
@@ -30,6 +43,11 @@ public:
 
   /// Write one ByteCodeModule to output translating to MIPS.
   void Write(const ByteCodeModule &M, std::ostream &O);
+  /// Same as above but translate the functions in parallel on a ThreadPool.
+  void Write(const ByteCodeModule &M, std::ostream &O, ThreadPool &Pool);
+  /// Write one IRModule to output translating to MIPS.
+  void Write(const IRModule &M, std::ostream &O);
+  void Write(const IRModule &M, std::ostream &O, ThreadPool &Pool);
 
 private:
   LocalContext TheContext;
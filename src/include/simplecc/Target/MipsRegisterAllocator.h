@@ -0,0 +1,78 @@
+#ifndef SIMPLECC_TARGET_MIPSREGISTERALLOCATOR_H
+#define SIMPLECC_TARGET_MIPSREGISTERALLOCATOR_H
+#include "simplecc/IR/Liveness.h"
+#include <vector>
+
+namespace simplecc {
+class IRFunction;
+
+/// @brief MipsRegisterAllocator assigns the virtual registers of an
+/// IRFunction to MIPS registers by linear scan, spilling the rest to the
+/// frame.
+///
+/// The instructions are numbered in the order of the blocks, and the live
+/// interval of a virtual register spans from the first to the last point it
+/// is live at. An interval that lives across a call only takes a saved
+/// register ($s0-$s7), which the function saves itself. The others take a
+/// temporary register ($t2-$t9) first. $t0, $t1 and $v1 are left for the
+/// translator to load spilled values and immediates into.
+class MipsRegisterAllocator {
+public:
+  MipsRegisterAllocator() = default;
+
+  /// Allocate the registers of a function.
+  void Allocate(const IRFunction &F);
+
+  /// Return the MIPS register of a virtual register, or nullptr if it is
+  /// spilled or never live.
+  const char *getRegister(unsigned Reg) const {
+    return Assigned[Reg] < 0 ? nullptr : getRegisterName(Assigned[Reg]);
+  }
+  /// Return if a virtual register is spilled to the frame.
+  bool IsSpilled(unsigned Reg) const { return Assigned[Reg] == Spilled; }
+  /// Return the index of the frame slot of a spilled register, which is not
+  /// an argument. An argument is spilled to where it is passed.
+  unsigned getSpillSlot(unsigned Reg) const { return SpillSlots[Reg]; }
+  unsigned getNumSpillSlots() const { return NumSpillSlots; }
+
+  /// Return the saved registers that are used, which the function must
+  /// preserve.
+  const std::vector<const char *> &getUsedSavedRegisters() const {
+    return UsedSavedRegisters;
+  }
+
+  /// Return the liveness the allocation is based on.
+  const Liveness &getLiveness() const { return TheLiveness; }
+
+private:
+  /// The saved registers come first in the pool.
+  static const char *getRegisterName(int Index);
+  static constexpr int NumSavedRegisters = 8;
+  static constexpr int NumRegisters = 16;
+  /// Assigned is this for a spilled register and NoInterval for a register
+  /// that is never live.
+  static constexpr int Spilled = -1;
+  static constexpr int NoInterval = -2;
+
+  struct Interval {
+    unsigned Reg;
+    int Start;
+    int End;
+    bool CrossesCall;
+  };
+
+  void BuildIntervals(const IRFunction &F);
+  /// Spill the interval, which may be an active one.
+  void Spill(const Interval &I);
+
+  Liveness TheLiveness;
+  std::vector<Interval> Intervals;
+  std::vector<int> Assigned;
+  std::vector<unsigned> SpillSlots;
+  unsigned NumSpillSlots = 0;
+  unsigned NumArguments = 0;
+  std::vector<const char *> UsedSavedRegisters;
+};
+
+} // namespace simplecc
+#endif // SIMPLECC_TARGET_MIPSREGISTERALLOCATOR_H
@@ -1,5 +1,6 @@
 #ifndef SIMPLECC_TARGET_MIPSSUPPORT_H
 #define SIMPLECC_TARGET_MIPSSUPPORT_H
+#include "simplecc/Support/Identifier.h"
 #include "simplecc/Support/Macros.h"
 #include <iostream>
 #include <string>
@@ -58,8 +59,8 @@ class JumpTargetLabel : public LabelBase<JumpTargetLabel> {
 public:
   JumpTargetLabel(const char *PN, unsigned T, bool NeedColon)
       : LabelBase(NeedColon), ParentName(PN), Target(T) {}
-  JumpTargetLabel(const std::string &PN, unsigned T, bool NeedColon)
-      : JumpTargetLabel(PN.data(), T, NeedColon) {}
+  JumpTargetLabel(Identifier PN, unsigned T, bool NeedColon)
+      : JumpTargetLabel(PN.c_str(), T, NeedColon) {}
 
   void FormatImpl(std::ostream &O) const;
 };
@@ -68,8 +69,8 @@ class ReturnLabel : public LabelBase<ReturnLabel> {
   const char *ParentName;
 
 public:
-  ReturnLabel(const std::string &PN, bool NeedColon)
-      : LabelBase(NeedColon), ParentName(PN.data()) {}
+  ReturnLabel(Identifier PN, bool NeedColon)
+      : LabelBase(NeedColon), ParentName(PN.c_str()) {}
   void FormatImpl(std::ostream &O) const;
 };
 
@@ -79,8 +80,8 @@ class GlobalLabel : public LabelBase<GlobalLabel> {
 
 public:
   GlobalLabel(const char *N, bool NeedColon) : LabelBase(NeedColon), Name(N) {}
-  GlobalLabel(const std::string &N, bool NeedColon)
-      : GlobalLabel(N.data(), NeedColon) {}
+  GlobalLabel(Identifier N, bool NeedColon)
+      : GlobalLabel(N.c_str(), NeedColon) {}
 
   void FormatImpl(std::ostream &O) const;
 };
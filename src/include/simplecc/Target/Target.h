@@ -5,9 +5,17 @@
 
 namespace simplecc {
 class ByteCodeModule;
+class IRModule;
+class ThreadPool;
 
 /// This function emits MIPS assembly from a ByteCodeModule.
 /// Data will be written to M.
 void AssembleMips(const ByteCodeModule &M, std::ostream &O);
+/// Translate the functions in parallel on a ThreadPool.
+void AssembleMips(const ByteCodeModule &M, std::ostream &O, ThreadPool &Pool);
+/// Emit MIPS assembly from the register-based IR, allocating the registers
+/// of each function.
+void AssembleMips(const IRModule &M, std::ostream &O);
+void AssembleMips(const IRModule &M, std::ostream &O, ThreadPool &Pool);
 } // namespace simplecc
 #endif // SIMPLECC_TARGET_TARGET_H
\ No newline at end of file
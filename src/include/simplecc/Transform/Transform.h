@@ -8,8 +8,11 @@
 namespace simplecc {
 class ProgramAST;
 class SymbolTable;
+class TimeReport;
 
 /// This function performs all the transformations on the AST.
-void TransformProgram(ProgramAST *P, SymbolTable &S);
+/// If Report is not nullptr, each transformation is timed in it.
+void TransformProgram(ProgramAST *P, SymbolTable &S,
+                      TimeReport *Report = nullptr);
 } // namespace simplecc
 #endif // SIMPLECC_TRANSFORM_TRANSFORM_H
\ No newline at end of file
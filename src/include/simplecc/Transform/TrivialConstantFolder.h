@@ -16,7 +16,14 @@ class TrivialConstantFolder : ExpressionTransformer<TrivialConstantFolder> {
 
 public:
   TrivialConstantFolder() = default;
-  using ExpressionTransformer::Transform;
+  void Transform(ProgramAST *P, SymbolTable &S) {
+    TheContext = &P->getContext();
+    ExpressionTransformer::Transform(P, S);
+  }
+
+private:
+  /// The folded nodes are created in the context of the program.
+  ASTContext *TheContext = nullptr;
 };
 
 } // namespace simplecc
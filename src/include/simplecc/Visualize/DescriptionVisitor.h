@@ -30,9 +30,11 @@ class DescriptionVisitor : public VisitorBase<DescriptionVisitor> {
   std::string visitNum(NumExpr *N);
   std::string visitChar(CharExpr *C);
   std::string visitStr(StrExpr *S);
-  std::string visitCall(CallExpr *C) { return C->getCallee(); }
-  std::string visitName(NameExpr *N) { return N->getName(); }
-  std::string visitSubscript(SubscriptExpr *SB) { return SB->getArrayName(); }
+  std::string visitCall(CallExpr *C) { return C->getCallee().str(); }
+  std::string visitName(NameExpr *N) { return N->getName().str(); }
+  std::string visitSubscript(SubscriptExpr *SB) {
+    return SB->getArrayName().str();
+  }
 
   std::string visitBinOp(BinOpExpr *BO) {
     return CStringFromOperatorKind(BO->getOp());
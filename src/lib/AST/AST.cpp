@@ -4,6 +4,8 @@
 
 using namespace simplecc;
 
+constexpr unsigned ExprAST::NoSymbolSlot;
+
 template <typename AstT>
 static inline void SetterImpl(AstT *&LHS, AstT *RHS, bool Optional = false) {
   assert((Optional || RHS) && "Only optional field can be null");
@@ -16,11 +18,11 @@ static inline void SetterImpl(AstT *&LHS, AstT *RHS, bool Optional = false) {
 ReadStmt::ReadStmt(std::vector<NameExpr *> names, Location loc)
     : StmtAST(StmtAST::ReadStmtKind, loc), Names(std::move(names)) {}
 
-ConstDecl::ConstDecl(BasicTypeKind type, std::string name, ExprAST *value, Location loc)
-    : DeclAST(DeclAST::ConstDeclKind, type, std::move(name), loc), Value(value) {}
+ConstDecl::ConstDecl(BasicTypeKind type, Identifier name, ExprAST *value, Location loc)
+    : DeclAST(DeclAST::ConstDeclKind, type, name, loc), Value(value) {}
 
-VarDecl::VarDecl(BasicTypeKind Type, std::string Name, bool isArray, int size, Location loc)
-    : DeclAST(DeclAST::VarDeclKind, Type, std::move(Name), loc), IsArray(isArray), Size(size) {}
+VarDecl::VarDecl(BasicTypeKind Type, Identifier Name, bool isArray, int size, Location loc)
+    : DeclAST(DeclAST::VarDeclKind, Type, Name, loc), IsArray(isArray), Size(size) {}
 
 FuncDef::~FuncDef() {
   DeleteAST::apply(Args);
@@ -32,23 +34,24 @@ FuncDef::FuncDef(BasicTypeKind return_type,
                  std::vector<ArgDecl *> args,
                  std::vector<DeclAST *> decls,
                  FuncDef::StmtListType stmts,
-                 std::string name,
+                 Identifier name,
                  Location loc)
-    : DeclAST(DeclAST::FuncDefKind, return_type, std::move(name), loc),
+    : DeclAST(DeclAST::FuncDefKind, return_type, name, loc),
       Args(std::move(args)), Decls(std::move(decls)), Stmts(std::move(stmts)) {}
 
-ArgDecl::ArgDecl(BasicTypeKind type, std::string name, Location loc)
-    : DeclAST(DeclAST::ArgDeclKind, type, std::move(name), loc) {}
+ArgDecl::ArgDecl(BasicTypeKind type, Identifier name, Location loc)
+    : DeclAST(DeclAST::ArgDeclKind, type, name, loc) {}
 
 WriteStmt::WriteStmt(ExprAST *str, ExprAST *value, Location loc)
     : StmtAST(StmtAST::WriteStmtKind, loc), Str(str), Value(value) {}
 
-ProgramAST::ProgramAST(std::string Filename, std::vector<DeclAST *> decls)
-    : AST(ProgramASTKind, Location()), Filename(std::move(Filename)),
-      Decls(std::move(decls)) {}
+ProgramAST::ProgramAST(std::string Filename, std::vector<DeclAST *> decls,
+                       std::unique_ptr<ASTContext> Context)
+    : AST(ProgramASTKind, Location()), Context(std::move(Context)),
+      Filename(std::move(Filename)), Decls(std::move(decls)) {}
 
-NameExpr::NameExpr(std::string id, ExprContextKind ctx, Location loc)
-    : ExprAST(NameExprKind, loc), TheName(std::move(id)), context(ctx) {}
+NameExpr::NameExpr(Identifier id, ExprContextKind ctx, Location loc)
+    : ExprAST(NameExprKind, loc), TheName(id), context(ctx) {}
 
 IfStmt::~IfStmt() {
   DeleteAST::apply(Then);
@@ -94,9 +97,9 @@ bool BoolOpExpr::isCompareOp(BinaryOpKind Op) {
   }
 }
 
-SubscriptExpr::SubscriptExpr(std::string name, ExprAST *index, ExprContextKind ctx, Location loc)
+SubscriptExpr::SubscriptExpr(Identifier name, ExprAST *index, ExprContextKind ctx, Location loc)
     : ExprAST(SubscriptExprKind, loc),
-      ArrayName(std::move(name)), Index(index), Context(ctx) {}
+      ArrayName(name), Index(index), Context(ctx) {}
 
 StrExpr::StrExpr(std::string s, Location loc)
     : ExprAST(ExprAST::StrExprKind, loc), TheStr(std::move(s)) {}
@@ -115,9 +118,9 @@ void CallExpr::setArgAt(unsigned I, ExprAST *Val) { SetterImpl(Args[I], Val); }
 UnaryOpExpr::UnaryOpExpr(UnaryOpKind op, ExprAST *operand, Location loc)
     : ExprAST(UnaryOpExprKind, loc), Op(op), Operand(operand) {}
 
-CallExpr::CallExpr(std::string func, std::vector<ExprAST *> args, Location loc)
+CallExpr::CallExpr(Identifier func, std::vector<ExprAST *> args, Location loc)
     : ExprAST(ExprAST::CallExprKind, loc),
-      Callee(std::move(func)), Args(std::move(args)) {}
+      Callee(func), Args(std::move(args)) {}
 
 const char *AST::getClassName(unsigned Kind) {
   switch (Kind) {
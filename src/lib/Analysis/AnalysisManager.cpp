@@ -1,38 +1,67 @@
 #include "simplecc/Analysis/AnalysisManager.h"
 #include "simplecc/AST/ASTVerifier.h"
 #include "simplecc/Analysis/ArrayBoundChecker.h"
+#include "simplecc/Analysis/FusedAnalyzer.h"
 #include "simplecc/Analysis/ImplicitCallTransformer.h"
 #include "simplecc/Analysis/SymbolTableBuilder.h"
 #include "simplecc/Analysis/SyntaxChecker.h"
 #include "simplecc/Analysis/TypeChecker.h"
+#include "simplecc/Support/TimeReport.h"
 
 using namespace simplecc;
 
 AnalysisManager::~AnalysisManager() = default;
 
 bool AnalysisManager::runAllAnalyses(ProgramAST *P) {
-  if (SyntaxChecker().Check(P)) {
-    return true;
+  {
+    TimeRegion R(Report, "SyntaxChecker");
+    if (SyntaxChecker().Check(P)) {
+      return true;
+    }
   }
 
-  if (SymbolTableBuilder().Build(P, TheTable)) {
-    return true;
+  // A well-formed program is done in one traversal. Otherwise run the
+  // separate passes to report the errors.
+  if (!isFusedAnalysis() || runFusedAnalyzer(P)) {
+    if (runSeparateAnalyses(P))
+      return true;
   }
 
-  ImplicitCallTransformer().Transform(P, TheTable);
-
-  if (TypeChecker().Check(P, TheTable)) {
+  TimeRegion R(Report, "ASTVerifier");
+  if (ASTVerifier().Check(P)) {
+    PrintErrs("ProgramAST should be well-formed after all analyses run!");
     return true;
   }
 
-  if (ArrayBoundChecker().Check(P, TheTable)) {
-    return true;
+  return false;
+}
+bool AnalysisManager::runSeparateAnalyses(ProgramAST *P) {
+  {
+    TimeRegion R(Report, "SymbolTableBuilder");
+    if (SymbolTableBuilder().Build(P, TheTable)) {
+      return true;
+    }
   }
 
-  if (ASTVerifier().Check(P)) {
-    PrintErrs("ProgramAST should be well-formed after all analyses run!");
-    return true;
+  {
+    TimeRegion R(Report, "ImplicitCallTransformer");
+    ImplicitCallTransformer().Transform(P, TheTable);
   }
 
-  return false;
-}
\ No newline at end of file
+  {
+    TimeRegion R(Report, "TypeChecker");
+    if (TypeChecker().Check(P, TheTable)) {
+      return true;
+    }
+  }
+
+  TimeRegion R(Report, "ArrayBoundChecker");
+  return ArrayBoundChecker().Check(P, TheTable);
+}
+
+bool AnalysisManager::runFusedAnalyzer(ProgramAST *P) {
+  TimeRegion R(Report, "FusedAnalyzer");
+  if (ThePool)
+    return FusedAnalyzer().Analyze(P, TheTable, *ThePool);
+  return FusedAnalyzer().Analyze(P, TheTable);
+}
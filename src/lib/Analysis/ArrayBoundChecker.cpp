@@ -3,12 +3,12 @@
 using namespace simplecc;
 
 void ArrayBoundChecker::visitSubscript(SubscriptExpr *SB) {
-  auto Entry = getSymbolEntry(SB->getArrayName());
+  auto Entry = getSymbolEntry(SB);
   if (!Entry.IsArray()) {
     return;
   }
   ArrayType AT(Entry.AsArray());
-  std::pair<bool, int> Idx = getIndex(SB->getIndex());
+  std::pair<bool, int> Idx = getIndex(SB->getIndex(), getLocalTable());
   if (!Idx.first)
     return;
   int Val = Idx.second;
@@ -17,7 +17,8 @@ void ArrayBoundChecker::visitSubscript(SubscriptExpr *SB) {
   }
 }
 
-std::pair<bool, int> ArrayBoundChecker::getIndex(ExprAST *E) const {
+std::pair<bool, int> ArrayBoundChecker::getIndex(ExprAST *E,
+                                                 LocalSymbolTable Local) {
   std::pair<bool, int> False(false, 0);
   // Case-1: NumExpr.
   if (IsInstance<NumExpr>(E)) {
@@ -39,7 +40,7 @@ std::pair<bool, int> ArrayBoundChecker::getIndex(ExprAST *E) const {
     return False;
 
   auto N = static_cast<NameExpr *>(E);
-  auto Entry = getSymbolEntry(N->getName());
+  const auto &Entry = Local[N];
   if (!Entry.IsConstant())
     return False;
 
@@ -0,0 +1,356 @@
+#include "simplecc/Analysis/FusedAnalyzer.h"
+#include "simplecc/Analysis/ArrayBoundChecker.h"
+#include "simplecc/Support/ThreadPool.h"
+#include <memory>
+#include <vector>
+
+using namespace simplecc;
+
+void FusedAnalyzer::visitProgram(ProgramAST *P) {
+  for (auto D : P->getDecls()) {
+    visitDecl(D);
+    // The separate passes will find out the errors. Stop wasting time.
+    if (HasError)
+      return;
+  }
+}
+
+void FusedAnalyzer::visitDecl(DeclAST *D) {
+  switch (D->getKind()) {
+  case DeclAST::FuncDefKind:
+    TheLocal = &TheTable->getLocal(static_cast<FuncDef *>(D));
+    /// Define this function globally.
+    DefineGlobalDecl(D);
+    return AnalyzeFunction(static_cast<FuncDef *>(D), TheGlobal->size());
+
+  case DeclAST::ConstDeclKind:
+  case DeclAST::VarDeclKind:
+  case DeclAST::ArgDeclKind:
+    /* Fall through */
+    return TheLocal ? DefineLocalDecl(D) : DefineGlobalDecl(D);
+  default:
+    assert(false && "Unhandled DeclAST subclass!");
+  }
+}
+
+void FusedAnalyzer::AnalyzeFunction(FuncDef *FD, unsigned NumGlobals) {
+  TheFuncDef = FD;
+  TheLocalTable = TheTable->getLocalTable(FD);
+  NumVisibleGlobals = NumGlobals;
+  ChildrenVisitor::visitFuncDef(FD);
+}
+
+int FusedAnalyzer::getVisibleGlobalSlot(Identifier Name) const {
+  int Slot = TheGlobal->getSlot(Name);
+  return Slot < static_cast<int>(NumVisibleGlobals) ? Slot : -1;
+}
+
+void FusedAnalyzer::DefineLocalDecl(DeclAST *D) {
+  if (TheLocal->count(D->getName())) {
+    return setError();
+  }
+  int GlobalSlot = getVisibleGlobalSlot(D->getName());
+  if (GlobalSlot >= 0 && (*TheGlobal)[GlobalSlot].IsFunction()) {
+    return setError();
+  }
+  TheLocal->insert(D->getName(), SymbolEntry(Scope::Local, D));
+}
+
+void FusedAnalyzer::DefineGlobalDecl(DeclAST *D) {
+  if (TheGlobal->count(D->getName())) {
+    return setError();
+  }
+  TheGlobal->insert(D->getName(), SymbolEntry(Scope::Global, D));
+}
+
+int FusedAnalyzer::ResolveName(Identifier Name) {
+  int Slot = TheLocal->getSlot(Name);
+  if (Slot >= 0)
+    return Slot;
+  int GlobalSlot = getVisibleGlobalSlot(Name);
+  if (GlobalSlot >= 0)
+    return TheLocal->insert(Name, (*TheGlobal)[GlobalSlot]);
+  setError();
+  return -1;
+}
+
+void FusedAnalyzer::visitRead(ReadStmt *RD) {
+  for (auto N : RD->getNames()) {
+    int Slot = ResolveName(N->getName());
+    if (Slot < 0)
+      continue;
+    N->setSymbolSlot(Slot);
+    if (!(*TheLocal)[Slot].IsVariable())
+      setError();
+  }
+}
+
+void FusedAnalyzer::visitWrite(WriteStmt *W) {
+  if (W->getValue()) {
+    W->setValue(TransformOperand(W->getValue()));
+  }
+}
+
+void FusedAnalyzer::visitAssign(AssignStmt *A) {
+  // Don't transform the target!
+  auto LHS = visitExpr(A->getTarget());
+  auto RHS = BasicTypeKind::Void;
+  A->setValue(TransformExpr(A->getValue(), RHS));
+  if (RHS == BasicTypeKind::Void || LHS != RHS)
+    setError();
+}
+
+void FusedAnalyzer::visitFor(ForStmt *F) {
+  auto Ty = BasicTypeKind::Void;
+  visitStmt(F->getInitial());
+  F->setCondition(TransformExpr(F->getCondition(), Ty));
+  visitStmt(F->getStep());
+  for (auto S : F->getBody()) {
+    visitStmt(S);
+  }
+}
+
+void FusedAnalyzer::visitWhile(WhileStmt *W) {
+  auto Ty = BasicTypeKind::Void;
+  W->setCondition(TransformExpr(W->getCondition(), Ty));
+  for (auto S : W->getBody()) {
+    visitStmt(S);
+  }
+}
+
+void FusedAnalyzer::visitReturn(ReturnStmt *R) {
+  auto ActuallyReturn = BasicTypeKind::Void;
+  R->setValue(TransformExpr(R->getValue(), ActuallyReturn));
+  if (ActuallyReturn != TheFuncDef->getReturnType())
+    setError();
+}
+
+void FusedAnalyzer::visitIf(IfStmt *I) {
+  auto Ty = BasicTypeKind::Void;
+  I->setCondition(TransformExpr(I->getCondition(), Ty));
+  for (auto S : I->getThen()) {
+    visitStmt(S);
+  }
+  for (auto S : I->getElse()) {
+    visitStmt(S);
+  }
+}
+
+void FusedAnalyzer::visitExprStmt(ExprStmt *ES) { visitExpr(ES->getValue()); }
+
+ExprAST *FusedAnalyzer::TransformExpr(ExprAST *E, BasicTypeKind &Type) {
+  Type = BasicTypeKind::Void;
+  if (!E)
+    return E;
+  if (!IsInstance<NameExpr>(E)) {
+    Type = visitExpr(E);
+    return E;
+  }
+  NameExpr *N = static_cast<NameExpr *>(E);
+  int Slot = ResolveName(N->getName());
+  if (Slot < 0)
+    return E;
+  N->setSymbolSlot(Slot);
+  const SymbolEntry &Entry = (*TheLocal)[Slot];
+  if (!Entry.IsFunction()) {
+    Type = getNameType(N);
+    N->setType(Type);
+    return E;
+  }
+  // An implicit call has no argument.
+  FuncType Ty = Entry.AsFunction();
+  if (Ty.getNumArgs() != 0)
+    setError();
+  Type = Ty.getReturnType();
+  auto C = new (*TheContext) CallExpr(N->getName(), {}, E->getLocation());
+  C->setSymbolSlot(Slot);
+  C->setType(Type);
+  return C;
+}
+
+ExprAST *FusedAnalyzer::TransformOperand(ExprAST *E) {
+  auto Ty = BasicTypeKind::Void;
+  E = TransformExpr(E, Ty);
+  if (Ty == BasicTypeKind::Void)
+    setError();
+  return E;
+}
+
+BasicTypeKind FusedAnalyzer::visitBinOp(BinOpExpr *B) {
+  B->setLeft(TransformOperand(B->getLeft()));
+  B->setRight(TransformOperand(B->getRight()));
+  return BasicTypeKind::Int;
+}
+
+BasicTypeKind FusedAnalyzer::visitBoolOp(BoolOpExpr *B) {
+  auto Ty = BasicTypeKind::Void;
+  if (B->hasCompareOp()) {
+    // Both operands of a comparison must be int.
+    auto Bin = static_cast<BinOpExpr *>(B->getValue());
+    Bin->setLeft(TransformExpr(Bin->getLeft(), Ty));
+    if (Ty != BasicTypeKind::Int)
+      setError();
+    Bin->setRight(TransformExpr(Bin->getRight(), Ty));
+  } else {
+    B->setValue(TransformExpr(B->getValue(), Ty));
+  }
+  if (Ty != BasicTypeKind::Int)
+    setError();
+  return BasicTypeKind::Int;
+}
+
+BasicTypeKind FusedAnalyzer::visitUnaryOp(UnaryOpExpr *U) {
+  U->setOperand(TransformOperand(U->getOperand()));
+  return BasicTypeKind::Int;
+}
+
+BasicTypeKind FusedAnalyzer::visitParenExpr(ParenExpr *PE) {
+  PE->setValue(TransformOperand(PE->getValue()));
+  return BasicTypeKind::Int;
+}
+
+BasicTypeKind FusedAnalyzer::visitCall(CallExpr *C) {
+  int Slot = ResolveName(C->getCallee());
+  if (Slot < 0)
+    return BasicTypeKind::Void;
+  C->setSymbolSlot(Slot);
+  // Copy it since resolving the arguments can grow the table.
+  SymbolEntry Entry = (*TheLocal)[Slot];
+  if (!Entry.IsFunction()) {
+    setError();
+    return BasicTypeKind::Void;
+  }
+
+  auto Ty = Entry.AsFunction();
+  auto NumFormal = Ty.getNumArgs();
+  auto NumActual = C->getNumArgs();
+  if (NumFormal != NumActual)
+    setError();
+  for (unsigned I = 0; I < NumActual; I++) {
+    auto ActualTy = BasicTypeKind::Void;
+    C->setArgAt(I, TransformExpr(C->getArgAt(I), ActualTy));
+    if (I < NumFormal && ActualTy != Ty.getArgTypeAt(I))
+      setError();
+  }
+  return Ty.getReturnType();
+}
+
+BasicTypeKind FusedAnalyzer::visitSubscript(SubscriptExpr *SB) {
+  int Slot = ResolveName(SB->getArrayName());
+  if (Slot < 0)
+    return BasicTypeKind::Void;
+  SB->setSymbolSlot(Slot);
+  auto Idx = BasicTypeKind::Void;
+  SB->setIndex(TransformExpr(SB->getIndex(), Idx));
+
+  const SymbolEntry &Entry = (*TheLocal)[Slot];
+  if (!Entry.IsArray()) {
+    setError();
+    return BasicTypeKind::Void;
+  }
+  ArrayType AT(Entry.AsArray());
+  if (Idx != BasicTypeKind::Int) {
+    setError();
+    return AT.getElementType();
+  }
+
+  std::pair<bool, int> Val =
+      ArrayBoundChecker::getIndex(SB->getIndex(), TheLocalTable);
+  if (Val.first && (Val.second < 0 ||
+                    static_cast<unsigned>(Val.second) >= AT.getSize()))
+    setError();
+  return AT.getElementType();
+}
+
+BasicTypeKind FusedAnalyzer::visitName(NameExpr *N) {
+  int Slot = ResolveName(N->getName());
+  if (Slot < 0)
+    return BasicTypeKind::Void;
+  N->setSymbolSlot(Slot);
+  return getNameType(N);
+}
+
+BasicTypeKind FusedAnalyzer::getNameType(NameExpr *N) {
+  const SymbolEntry &Entry = (*TheLocal)[N->getSymbolSlot()];
+  if (Entry.IsFunction() || Entry.IsArray()) {
+    // A function in load context should have been an implicit call.
+    setError();
+    return BasicTypeKind::Void;
+  }
+  if (N->getContext() == ExprContextKind::Store && !Entry.IsVariable()) {
+    setError();
+    return BasicTypeKind::Void;
+  }
+  if (Entry.IsConstant())
+    return Entry.AsConstant().getType();
+  return Entry.AsVariable().getType();
+}
+
+bool FusedAnalyzer::Analyze(ProgramAST *P, SymbolTable &S) {
+  S.clear();
+  TheTable = &S;
+  TheGlobal = &S.getGlobal();
+  TheLocal = nullptr;
+  TheFuncDef = nullptr;
+  TheContext = &P->getContext();
+  HasError = false;
+  visitProgram(P);
+  return HasError;
+}
+
+bool FusedAnalyzer::Analyze(ProgramAST *P, SymbolTable &S, ThreadPool &Pool) {
+  S.clear();
+  TheTable = &S;
+  TheGlobal = &S.getGlobal();
+  TheLocal = nullptr;
+  HasError = false;
+
+  // Define all the globals first and create all the local tables, so that
+  // the tables don't move while the functions are analyzed. A function only
+  // sees the globals defined before it and itself.
+  std::vector<FuncDef *> Functions;
+  std::vector<unsigned> NumGlobals;
+  for (auto D : P->getDecls()) {
+    if (auto FD = subclass_cast<FuncDef>(D)) {
+      S.getLocal(FD);
+      DefineGlobalDecl(FD);
+      Functions.push_back(FD);
+      NumGlobals.push_back(TheGlobal->size());
+    } else if (Functions.empty()) {
+      DefineGlobalDecl(D);
+    } else {
+      // SyntaxChecker rejects it.
+      setError();
+    }
+    if (HasError)
+      return true;
+  }
+
+  std::vector<TableType *> Locals;
+  for (auto FD : Functions)
+    Locals.push_back(&S.getLocal(FD));
+
+  // Each function creates its implicit calls in a context of its own.
+  std::vector<std::unique_ptr<ASTContext>> Contexts(Functions.size());
+  std::vector<char> Errors(Functions.size(), false);
+  for (unsigned I = 0, E = Functions.size(); I < E; ++I) {
+    Pool.async([this, I, &Functions, &NumGlobals, &Locals, &Contexts,
+                &Errors]() {
+      Contexts[I].reset(new ASTContext);
+      FusedAnalyzer Worker;
+      Worker.TheTable = TheTable;
+      Worker.TheGlobal = TheGlobal;
+      Worker.TheLocal = Locals[I];
+      Worker.TheContext = Contexts[I].get();
+      Worker.AnalyzeFunction(Functions[I], NumGlobals[I]);
+      Errors[I] = Worker.HasError;
+    });
+  }
+  Pool.wait();
+
+  for (unsigned I = 0, E = Functions.size(); I < E; ++I) {
+    P->getContext().Adopt(*Contexts[I]);
+    HasError |= Errors[I];
+  }
+  return HasError;
+}
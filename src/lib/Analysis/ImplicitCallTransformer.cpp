@@ -75,16 +75,19 @@ ExprAST *ImplicitCallTransformer::TransformExpr(ExprAST *E) {
     return E;
   }
   NameExpr *N = static_cast<NameExpr *>(E);
-  if (!TheLocalTable[N->getName()].IsFunction()) {
+  if (!TheLocalTable[N].IsFunction()) {
     return E;
   }
-  return new CallExpr(N->getName(), {}, E->getLocation());
+  auto C = new (*TheContext) CallExpr(N->getName(), {}, E->getLocation());
+  C->setSymbolSlot(N->getSymbolSlot());
+  return C;
 }
 
 /// Perform implicit call transform on the program using a SymbolTable.
 void ImplicitCallTransformer::Transform(ProgramAST *P, const SymbolTable &S) {
   assert(P);
   setTable(&S);
+  TheContext = &P->getContext();
   visitProgram(P);
 }
 
@@ -4,35 +4,34 @@ using namespace simplecc;
 
 void SymbolTable::Format(std::ostream &O) const {
   O << "Global:\n";
-  for (const auto &Pair : GlobalTable) {
-    O << "  " << Pair.first << ": " << Pair.second << "\n";
+  for (const SymbolEntry &Entry : GlobalTable) {
+    O << "  " << Entry.getName() << ": " << Entry << "\n";
   }
   O << "\n";
   for (const auto &Pair : LocalTables) {
     O << "Local(" << Pair.first->getName() << "):\n";
-    for (const auto &Item : Pair.second) {
-      O << "  " << Item.first << ": " << Item.second << "\n";
+    for (const SymbolEntry &Entry : Pair.second) {
+      O << "  " << Entry.getName() << ": " << Entry << "\n";
     }
     O << "\n";
   }
 }
 
 void SymbolTable::clear() {
-  GlobalTable.clear();
+  GlobalTable = TableType();
   LocalTables.clear();
+  LocalTableIndices.clear();
 }
 
 LocalSymbolTable SymbolTable::getLocalTable(const FuncDef *FD) const {
-  assert(LocalTables.count(FD));
-  return LocalSymbolTable(LocalTables.find(FD)->second);
+  assert(LocalTableIndices.count(FD));
+  return LocalSymbolTable(
+      LocalTables[LocalTableIndices.find(FD)->second].second);
 }
 
-SymbolEntry SymbolTable::getGlobalEntry(const std::string &Name) const {
-  assert(GlobalTable.count(Name));
-  return GlobalTable.find(Name)->second;
+TableType &SymbolTable::getLocal(const FuncDef *FD) {
+  auto Result = LocalTableIndices.emplace(FD, LocalTables.size());
+  if (Result.second)
+    LocalTables.emplace_back(FD, TableType());
+  return LocalTables[Result.first->second].second;
 }
-
-SymbolEntry LocalSymbolTable::operator[](const std::string &Name) const {
-  assert(TheTable->count(Name) && "Undefined Name");
-  return TheTable->find(Name)->second;
-}
\ No newline at end of file
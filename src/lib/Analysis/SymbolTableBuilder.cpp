@@ -16,7 +16,7 @@ void SymbolTableBuilder::DefineLocalDecl(DeclAST *D) {
     return;
   }
   /// Now we successfully define the name
-  TheLocal->emplace(D->getName(), SymbolEntry(Scope::Local, D));
+  TheLocal->insert(D->getName(), SymbolEntry(Scope::Local, D));
 }
 
 void SymbolTableBuilder::DefineGlobalDecl(DeclAST *D) {
@@ -26,30 +26,42 @@ void SymbolTableBuilder::DefineGlobalDecl(DeclAST *D) {
              "in <module>");
     return;
   }
-  TheGlobal->emplace(D->getName(), SymbolEntry(Scope::Global, D));
+  TheGlobal->insert(D->getName(), SymbolEntry(Scope::Global, D));
 }
 
-void SymbolTableBuilder::ResolveName(const std::string &Name, Location L) {
+int SymbolTableBuilder::ResolveName(Identifier Name, Location L) {
   assert(TheLocal && TheGlobal && TheFuncDef);
-  if (TheLocal->count(Name))
-    return;
-  if (TheGlobal->count(Name)) {
+  int Slot = TheLocal->getSlot(Name);
+  if (Slot >= 0)
+    return Slot;
+  int GlobalSlot = TheGlobal->getSlot(Name);
+  if (GlobalSlot >= 0) {
     /// Fall back to globally.
-    TheLocal->emplace(Name, (*TheGlobal)[Name]);
-    return;
+    return TheLocal->insert(Name, (*TheGlobal)[GlobalSlot]);
   }
   /// Undefined
   EM.Error(L, "undefined identifier", Name, "in", TheFuncDef->getName());
+  return -1;
+}
+
+void SymbolTableBuilder::visitName(NameExpr *N) {
+  int Slot = ResolveName(N->getName(), N->getLocation());
+  if (Slot >= 0)
+    N->setSymbolSlot(Slot);
 }
 
 void SymbolTableBuilder::visitCall(CallExpr *C) {
-  ResolveName(C->getCallee(), C->getLocation());
+  int Slot = ResolveName(C->getCallee(), C->getLocation());
+  if (Slot >= 0)
+    C->setSymbolSlot(Slot);
   /// Recurse into children.
   ChildrenVisitor::visitCall(C);
 }
 
 void SymbolTableBuilder::visitSubscript(SubscriptExpr *SB) {
-  ResolveName(SB->getArrayName(), SB->getLocation());
+  int Slot = ResolveName(SB->getArrayName(), SB->getLocation());
+  if (Slot >= 0)
+    SB->setSymbolSlot(Slot);
   /// Recurse into children.
   ChildrenVisitor::visitSubscript(SB);
 }
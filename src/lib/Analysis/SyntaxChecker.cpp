@@ -90,7 +90,7 @@ bool SyntaxChecker::isMainFunction(DeclAST *D) const {
   if (!IsInstance<FuncDef>(D))
     return false;
   auto FD = static_cast<FuncDef *>(D);
-  if (FD->getName() != "main")
+  if (FD->getName().str() != "main")
     return false;
   if (FD->getReturnType() != BasicTypeKind::Void)
     return false;
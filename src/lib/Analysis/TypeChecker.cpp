@@ -4,7 +4,7 @@ using namespace simplecc;
 
 void TypeChecker::visitRead(ReadStmt *RD) {
   for (auto N : RD->getNames()) {
-    const auto &Entry = getSymbolEntry(N->getName());
+    const auto &Entry = getSymbolEntry(N);
     if (!Entry.IsVariable()) {
       Error(N->getLocation(), "scanf() only applies to variables.");
       continue;
@@ -90,7 +90,7 @@ BasicTypeKind TypeChecker::visitParenExpr(ParenExpr *PE) {
 }
 
 BasicTypeKind TypeChecker::visitCall(CallExpr *C) {
-  const auto &Entry = getSymbolEntry(C->getCallee());
+  const auto &Entry = getSymbolEntry(C);
   if (!Entry.IsFunction()) {
     Error(C->getLocation(), Entry.getName(), "is not a function");
     return BasicTypeKind::Void;
@@ -118,7 +118,7 @@ BasicTypeKind TypeChecker::visitCall(CallExpr *C) {
 }
 
 BasicTypeKind TypeChecker::visitSubscript(SubscriptExpr *SB) {
-  const auto &Entry = getSymbolEntry(SB->getArrayName());
+  const auto &Entry = getSymbolEntry(SB);
   if (!Entry.IsArray()) {
     Error(SB->getLocation(), Entry.getName(), "is not an array");
     return BasicTypeKind::Void;
@@ -139,7 +139,7 @@ static void CheckNoLoadFunction(SymbolEntry Entry, NameExpr *N) {
 }
 
 BasicTypeKind TypeChecker::visitName(NameExpr *N) {
-  const auto &Entry = getSymbolEntry(N->getName());
+  const auto &Entry = getSymbolEntry(N);
   // Catch this frequent error first.
   CheckNoLoadFunction(Entry, N);
 
@@ -162,9 +162,11 @@ BasicTypeKind TypeChecker::visitStr(StrExpr *) {
   return BasicTypeKind::Void;
 }
 
-// Return the type of evaluating the expression
+// Return the type of evaluating the expression and record it in the node
 BasicTypeKind TypeChecker::visitExpr(ExprAST *E) {
-  return VisitorBase::visitExpr<BasicTypeKind>(E);
+  auto Ty = VisitorBase::visitExpr<BasicTypeKind>(E);
+  E->setType(Ty);
+  return Ty;
 }
 
 void TypeChecker::visitFuncDef(FuncDef *FD) {
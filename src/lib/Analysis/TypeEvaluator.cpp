@@ -4,14 +4,14 @@
 using namespace simplecc;
 
 BasicTypeKind TypeEvaluator::visitSubscript(SubscriptExpr *S) {
-  auto Entry = TheLocal[S->getArrayName()];
+  auto Entry = TheLocal[S];
   assert(Entry.IsArray() && "invalid access to non array");
   return Entry.AsArray().getElementType();
 }
 
 BasicTypeKind TypeEvaluator::visitName(NameExpr *N) {
   // TODO: fix the mixture of SymbolEntry and type judgement.
-  auto Entry = TheLocal[N->getName()];
+  auto Entry = TheLocal[N];
   if (Entry.IsVariable())
     return Entry.AsVariable().getType();
   if (Entry.IsConstant())
@@ -20,11 +20,13 @@ BasicTypeKind TypeEvaluator::visitName(NameExpr *N) {
 }
 
 BasicTypeKind TypeEvaluator::visitCall(CallExpr *C) {
-  auto Entry = TheLocal[C->getCallee()];
+  auto Entry = TheLocal[C];
   assert(Entry.IsFunction() && "invalid access to non function");
   return Entry.AsFunction().getReturnType();
 }
 
 BasicTypeKind TypeEvaluator::getExprType(const ExprAST *E) const {
+  if (E->hasType())
+    return E->getType();
   return const_cast<TypeEvaluator *>(this)->visitExpr(const_cast<ExprAST *>(E));
 }
@@ -93,7 +93,7 @@ Location SymbolEntry::getLocation() const {
   return TheDecl->getLocation();
 }
 
-const std::string &SymbolEntry::getName() const {
+Identifier SymbolEntry::getName() const {
   assert(TheDecl);
   return TheDecl->getName();
 }
@@ -10,13 +10,13 @@ ByteCode ByteCode::Create(Opcode Op, int Val) {
   return B;
 }
 
-ByteCode ByteCode::Create(Opcode Op, const char *Val) {
+ByteCode ByteCode::Create(Opcode Op, Identifier Val) {
   ByteCode B(Op);
   B.setStrOperand(Val);
   return B;
 }
 
-ByteCode ByteCode::Create(Opcode Op, const char *Str, int Int) {
+ByteCode ByteCode::Create(Opcode Op, Identifier Str, int Int) {
   ByteCode B(Op);
   B.setStrOperand(Str);
   B.setIntOperand(Int);
@@ -50,6 +50,27 @@ bool ByteCode::HasStrOperand(Opcode Op) {
   }
 }
 
+bool ByteCode::HasConstOperand(Opcode Op) {
+  switch (Op) {
+  default:return false;
+#define HANDLE_FUSED_LOCAL(OP, NAME) case OP:
+#define HANDLE_FUSED_JUMP(OP, NAME) case OP:
+#include "simplecc/CodeGen/Opcode.def"
+    return true;
+  }
+}
+
+bool ByteCode::IsSuperinstruction(Opcode Op) {
+  switch (Op) {
+  default:return false;
+#define HANDLE_FUSED_LOCAL(OP, NAME) case OP:
+#define HANDLE_FUSED_JUMP(OP, NAME) case OP:
+#define HANDLE_FUSED_OUTPUT(OP, NAME) case OP:
+#include "simplecc/CodeGen/Opcode.def"
+    return true;
+  }
+}
+
 bool ByteCode::HasNoOperand(Opcode Op) {
   switch (Op) {
   default:return false;
@@ -60,7 +81,6 @@ bool ByteCode::HasNoOperand(Opcode Op) {
 }
 
 void ByteCode::Format(std::ostream &O) const {
-  O << std::left << std::setw(4) << getByteCodeOffset();
   O << std::left << std::setw(25) << getOpcodeName();
 
   if (HasIntOperand()) {
@@ -70,6 +90,10 @@ void ByteCode::Format(std::ostream &O) const {
   if (HasStrOperand()) {
     O << std::setw(20) << getStrOperand();
   }
+
+  if (HasConstOperand()) {
+    O << std::setw(10) << getConstOperand();
+  }
 }
 
 const char *ByteCode::getOpcodeName(unsigned Op) {
@@ -117,14 +117,8 @@ unsigned ByteCodeBuilder::Insert(ByteCode Code) {
   /// get the function being built.
   ByteCodeFunction &TheFunction = *getInsertPoint();
 
-  /// Fill in other members of Code.
-  auto Off = TheFunction.size();
-  Code.setSourceLineno(getLineno());
-  Code.setByteCodeOffset(Off);
-
   /// Insert Code at the back of the function.
-  TheFunction.getByteCodeList().push_back(Code);
-  return Off;
+  return TheFunction.append(Code, getLineno());
 }
 
 void ByteCodeBuilder::setJumpTargetAt(unsigned Idx, unsigned Target) {
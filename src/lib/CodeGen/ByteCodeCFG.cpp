@@ -0,0 +1,309 @@
+#include "simplecc/CodeGen/ByteCodeCFG.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace simplecc;
+
+constexpr unsigned ByteCodeCFG::None;
+
+/// Return if control never goes on to the next ByteCode.
+static bool IsBlockEnd(const ByteCode &C) {
+  switch (C.getOpcode()) {
+  case ByteCode::JUMP_FORWARD:
+  case ByteCode::RETURN_VALUE:
+  case ByteCode::RETURN_NONE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void ByteCodeCFG::Compute(const ByteCodeFunction &F) {
+  TheFunction = &F;
+  ComputeBlocks();
+  ComputeDominators();
+  ComputeLoops();
+}
+
+void ByteCodeCFG::ComputeBlocks() {
+  const ByteCodeFunction &F = *TheFunction;
+  unsigned Size = F.size();
+  std::vector<bool> IsLeader(Size + 1, false);
+  IsLeader[0] = true;
+  for (unsigned I = 0; I < Size; ++I) {
+    const ByteCode &C = F.getByteCodeAt(I);
+    assert((!C.IsJump() || C.getJumpTarget() <= Size) && "Bad jump target");
+    if (C.IsJump())
+      IsLeader[C.getJumpTarget()] = true;
+    if (C.IsJump() || IsBlockEnd(C))
+      IsLeader[I + 1] = true;
+  }
+
+  // The blocks are resized rather than cleared so that the lists of edges
+  // keep their storage when the graph is computed again.
+  Blocks.resize(Size ? std::count(IsLeader.begin(), IsLeader.end() - 1, true)
+                     : 0);
+  BlockAt.resize(Size);
+  unsigned NumBlocks = 0;
+  for (unsigned I = 0; I < Size; ++I) {
+    if (IsLeader[I]) {
+      if (NumBlocks)
+        Blocks[NumBlocks - 1].End = I;
+      BasicBlock &BB = Blocks[NumBlocks++];
+      BB.Begin = I;
+      BB.End = Size;
+      BB.Predecessors.clear();
+      BB.Successors.clear();
+      BB.IDom = None;
+      BB.Loop = None;
+    }
+    BlockAt[I] = NumBlocks - 1;
+  }
+
+  auto AddEdge = [this, Size](unsigned From, unsigned Offset) {
+    // Going to the end of the code returns.
+    if (Offset == Size)
+      return;
+    unsigned To = BlockAt[Offset];
+    std::vector<unsigned> &Succs = Blocks[From].Successors;
+    // Both edges of a jump to the next block are one edge.
+    if (std::find(Succs.begin(), Succs.end(), To) != Succs.end())
+      return;
+    Succs.push_back(To);
+    Blocks[To].Predecessors.push_back(From);
+  };
+  for (unsigned B = 0, E = Blocks.size(); B < E; ++B) {
+    const ByteCode &Last = F.getByteCodeAt(Blocks[B].End - 1);
+    if (!IsBlockEnd(Last))
+      AddEdge(B, Blocks[B].End);
+    if (Last.IsJump())
+      AddEdge(B, Last.getJumpTarget());
+  }
+}
+
+unsigned ByteCodeCFG::Intersect(unsigned A, unsigned B) const {
+  while (A != B) {
+    while (RPONumbers[A] > RPONumbers[B])
+      A = Blocks[A].IDom;
+    while (RPONumbers[B] > RPONumbers[A])
+      B = Blocks[B].IDom;
+  }
+  return A;
+}
+
+void ByteCodeCFG::ComputeDominators() {
+  unsigned NumBlocks = Blocks.size();
+  RPO.clear();
+  RPONumbers.assign(NumBlocks, None);
+  if (!NumBlocks)
+    return;
+
+  // Depth first from the entry, keeping the next successor of each block on
+  // the way down.
+  std::vector<bool> Visited(NumBlocks, false);
+  std::vector<std::pair<unsigned, unsigned>> Path;
+  Path.emplace_back(0, 0);
+  Visited[0] = true;
+  while (!Path.empty()) {
+    unsigned B = Path.back().first;
+    unsigned &Next = Path.back().second;
+    if (Next == Blocks[B].Successors.size()) {
+      RPO.push_back(B);
+      Path.pop_back();
+      continue;
+    }
+    unsigned S = Blocks[B].Successors[Next++];
+    if (!Visited[S]) {
+      Visited[S] = true;
+      Path.emplace_back(S, 0);
+    }
+  }
+  std::reverse(RPO.begin(), RPO.end());
+  for (unsigned I = 0, E = RPO.size(); I < E; ++I)
+    RPONumbers[RPO[I]] = I;
+
+  // The iterative algorithm of Cooper, Harvey and Kennedy. The entry is its
+  // own dominator until the end.
+  Blocks[0].IDom = 0;
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    for (unsigned I = 1, E = RPO.size(); I < E; ++I) {
+      BasicBlock &BB = Blocks[RPO[I]];
+      unsigned NewIDom = None;
+      for (unsigned P : BB.Predecessors) {
+        if (Blocks[P].IDom == None)
+          continue;
+        NewIDom = NewIDom == None ? P : Intersect(P, NewIDom);
+      }
+      if (NewIDom != BB.IDom) {
+        BB.IDom = NewIDom;
+        Changed = true;
+      }
+    }
+  }
+  Blocks[0].IDom = None;
+}
+
+bool ByteCodeCFG::Dominates(unsigned A, unsigned B) const {
+  if (!IsReachable(B))
+    return A == B;
+  for (; B != None; B = Blocks[B].IDom) {
+    if (B == A)
+      return true;
+  }
+  return false;
+}
+
+void ByteCodeCFG::ComputeLoops() {
+  Loops.clear();
+  std::vector<unsigned> LoopOfHeader(Blocks.size(), None);
+  std::vector<bool> InLoop(Blocks.size(), false);
+  std::vector<unsigned> Worklist;
+
+  for (unsigned B : RPO) {
+    for (unsigned H : Blocks[B].Successors) {
+      if (!Dominates(H, B))
+        continue;
+      if (LoopOfHeader[H] == None) {
+        LoopOfHeader[H] = Loops.size();
+        Loops.push_back(Loop{H, {H}, None, 0});
+      }
+      // The body is what reaches B without going through the header.
+      Loop &L = Loops[LoopOfHeader[H]];
+      for (unsigned Member : L.Blocks)
+        InLoop[Member] = true;
+      if (!InLoop[B]) {
+        InLoop[B] = true;
+        L.Blocks.push_back(B);
+        Worklist.push_back(B);
+      }
+      while (!Worklist.empty()) {
+        unsigned Cur = Worklist.back();
+        Worklist.pop_back();
+        for (unsigned P : Blocks[Cur].Predecessors) {
+          if (InLoop[P] || !IsReachable(P))
+            continue;
+          InLoop[P] = true;
+          L.Blocks.push_back(P);
+          Worklist.push_back(P);
+        }
+      }
+      for (unsigned Member : L.Blocks)
+        InLoop[Member] = false;
+    }
+  }
+
+  for (Loop &L : Loops)
+    std::sort(L.Blocks.begin(), L.Blocks.end());
+  std::sort(Loops.begin(), Loops.end(), [](const Loop &A, const Loop &B) {
+    return A.Header < B.Header;
+  });
+
+  // Two loops are either nested or disjoint, so going from the largest,
+  // each block ends up in the innermost loop containing it, and what the
+  // header is in before is the parent.
+  std::vector<unsigned> BySize(Loops.size());
+  for (unsigned L = 0, E = Loops.size(); L < E; ++L)
+    BySize[L] = L;
+  std::stable_sort(BySize.begin(), BySize.end(),
+                   [this](unsigned A, unsigned B) {
+                     return Loops[A].Blocks.size() > Loops[B].Blocks.size();
+                   });
+  for (unsigned L : BySize) {
+    Loop &Lp = Loops[L];
+    Lp.Parent = Blocks[Lp.Header].Loop;
+    Lp.Depth = Lp.Parent == None ? 1 : Loops[Lp.Parent].Depth + 1;
+    for (unsigned B : Lp.Blocks)
+      Blocks[B].Loop = L;
+  }
+}
+
+/// Print a list of blocks, or "none".
+static void FormatBlockList(std::ostream &O, const std::vector<unsigned> &L) {
+  if (L.empty()) {
+    O << " none";
+    return;
+  }
+  for (unsigned B : L)
+    O << " B" << B;
+}
+
+void ByteCodeCFG::Format(std::ostream &O) const {
+  O << TheFunction->getName() << ":\n";
+  for (unsigned B = 0, E = Blocks.size(); B < E; ++B) {
+    const BasicBlock &BB = Blocks[B];
+    O << "B" << B << ": offsets " << BB.Begin << "-" << BB.End - 1
+      << ", preds";
+    FormatBlockList(O, BB.Predecessors);
+    O << ", succs";
+    FormatBlockList(O, BB.Successors);
+    O << ", idom ";
+    if (BB.IDom == None)
+      O << (IsReachable(B) ? "none" : "unreachable");
+    else
+      O << "B" << BB.IDom;
+    O << ", loop depth " << getLoopDepth(B) << "\n";
+    for (unsigned I = BB.Begin; I < BB.End; ++I) {
+      O << std::left << std::setw(4) << I << TheFunction->getByteCodeAt(I)
+        << "\n";
+    }
+  }
+  for (unsigned L = 0, E = Loops.size(); L < E; ++L) {
+    const Loop &Lp = Loops[L];
+    O << "loop " << L << ": header B" << Lp.Header << ", depth " << Lp.Depth
+      << ", parent ";
+    if (Lp.Parent == None)
+      O << "none";
+    else
+      O << Lp.Parent;
+    O << ", blocks";
+    FormatBlockList(O, Lp.Blocks);
+    O << "\n";
+  }
+}
+
+/// Escape a string for a quoted dot id.
+static std::string EscapeDOT(const std::string &Str) {
+  std::string Result;
+  for (char C : Str) {
+    if (C == '"' || C == '\\')
+      Result.push_back('\\');
+    Result.push_back(C);
+  }
+  return Result;
+}
+
+void ByteCodeCFG::WriteDOT(std::ostream &O) const {
+  std::string Name = EscapeDOT(TheFunction->getName().str());
+  O << "  subgraph \"cluster_" << Name << "\" {\n";
+  O << "    label=\"" << Name << "\";\n";
+  for (unsigned B = 0, E = Blocks.size(); B < E; ++B) {
+    const BasicBlock &BB = Blocks[B];
+    // Each line of the label is left justified by a \l.
+    std::ostringstream Label;
+    Label << "B" << B << "\\l";
+    for (unsigned I = BB.Begin; I < BB.End; ++I) {
+      std::ostringstream Code;
+      Code << std::left << std::setw(4) << I << TheFunction->getByteCodeAt(I);
+      std::string Line = Code.str();
+      Line.erase(Line.find_last_not_of(' ') + 1);
+      Label << EscapeDOT(Line) << "\\l";
+    }
+    O << "    \"" << Name << ".B" << B << "\" [shape=box, label=\""
+      << Label.str() << "\"];\n";
+  }
+  // Back edges are dashed.
+  for (unsigned B = 0, E = Blocks.size(); B < E; ++B) {
+    for (unsigned S : Blocks[B].Successors) {
+      O << "    \"" << Name << ".B" << B << "\" -> \"" << Name << ".B" << S
+        << "\"";
+      if (IsBackEdge(B, S))
+        O << " [style=dashed]";
+      O << ";\n";
+    }
+  }
+  O << "  }\n";
+}
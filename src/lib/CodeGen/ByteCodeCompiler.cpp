@@ -1,6 +1,9 @@
 #include <simplecc/Analysis/TypeEvaluator.h>
 #include "simplecc/CodeGen/ByteCodeCompiler.h"
 #include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/Support/ThreadPool.h"
+#include <memory>
+#include <vector>
 
 using namespace simplecc;
 
@@ -21,7 +24,7 @@ void ByteCodeCompiler::visitVarDecl(VarDecl *VD) {
 
 void ByteCodeCompiler::visitRead(ReadStmt *RD) {
   for (auto N : RD->getNames()) {
-    const auto &Entry = TheLocalTable[N->getName()];
+    const auto &Entry = TheLocalTable[N];
     Builder.CreateRead(Entry.AsVariable().getType());
     Builder.CreateStore(Entry.getScope(), Entry.getName());
   }
@@ -134,7 +137,7 @@ void ByteCodeCompiler::visitStr(simplecc::StrExpr *S) {
 }
 
 void ByteCodeCompiler::visitSubscript(SubscriptExpr *SB) {
-  const auto &Entry = TheLocalTable[SB->getArrayName()];
+  const auto &Entry = TheLocalTable[SB];
   // load array
   Builder.CreateLoad(Entry.getScope(), SB->getArrayName());
   // calculate index
@@ -144,7 +147,7 @@ void ByteCodeCompiler::visitSubscript(SubscriptExpr *SB) {
 }
 
 void ByteCodeCompiler::visitName(NameExpr *N) {
-  const auto &Entry = TheLocalTable[N->getName()];
+  const auto &Entry = TheLocalTable[N];
   if (Entry.IsConstant()) {
     Builder.CreateLoadConst(Entry.AsConstant().getValue());
     return;
@@ -155,8 +158,12 @@ void ByteCodeCompiler::visitName(NameExpr *N) {
 }
 
 void ByteCodeCompiler::visitFuncDef(FuncDef *FD) {
-  /// Create the function and set members.
-  auto TheFunction = ByteCodeFunction::Create(TheModule);
+  CompileFunction(FD, ByteCodeFunction::Create(TheModule));
+}
+
+void ByteCodeCompiler::CompileFunction(FuncDef *FD,
+                                       ByteCodeFunction *TheFunction) {
+  /// Set members of the function.
   TheFunction->setName(FD->getName());
   setLocalTable(TheTable->getLocalTable(FD));
   TheFunction->setLocalTable(TheLocalTable);
@@ -167,6 +174,7 @@ void ByteCodeCompiler::visitFuncDef(FuncDef *FD) {
 
   // It is important we always return since we don't
   // construct any BasicBlock to detect improper returns.
+  // ByteCodePeephole removes it if it cannot be reached.
   Builder.CreateReturnNone();
 }
 
@@ -222,4 +230,46 @@ void ByteCodeCompiler::Compile(ProgramAST *P, const SymbolTable &S, ByteCodeModu
   setTable(&S);
   setModule(&M);
   visitProgram(P);
-}
\ No newline at end of file
+}
+
+void ByteCodeCompiler::Compile(ProgramAST *P, const SymbolTable &S,
+                               ByteCodeModule &M, ThreadPool &Pool) {
+  EM.clear();
+  M.clear();
+  setTable(&S);
+  setModule(&M);
+
+  // Create the functions in order and collect the globals.
+  std::vector<std::pair<FuncDef *, ByteCodeFunction *>> Functions;
+  for (DeclAST *D : P->getDecls()) {
+    if (auto FD = subclass_cast<FuncDef>(D))
+      Functions.emplace_back(FD, ByteCodeFunction::Create(&M));
+    else if (IsInstance<VarDecl>(D))
+      M.getGlobalVariables().push_back(S.getGlobalEntry(D->getName()));
+  }
+
+  // Each function collects its string literals in a module of its own.
+  std::vector<std::unique_ptr<ByteCodeModule>> Strings(Functions.size());
+  for (unsigned I = 0, E = Functions.size(); I < E; ++I) {
+    Pool.async([this, I, &Functions, &Strings]() {
+      Strings[I].reset(new ByteCodeModule);
+      ByteCodeCompiler Worker;
+      Worker.setTable(TheTable);
+      Worker.setModule(Strings[I].get());
+      Worker.CompileFunction(Functions[I].first, Functions[I].second);
+    });
+  }
+  Pool.wait();
+
+  // Give the string literals their IDs in the order the serial compiler
+  // meets them and patch the LOAD_STRING's.
+  for (unsigned I = 0, E = Functions.size(); I < E; ++I) {
+    std::vector<unsigned> IDs;
+    for (const std::string &Str : Strings[I]->getStringLiterals())
+      IDs.push_back(M.getStringLiteralID(Str));
+    for (ByteCode &C : *Functions[I].second) {
+      if (C.getOpcode() == ByteCode::LOAD_STRING)
+        C.setIntOperand(IDs[C.getIntOperand()]);
+    }
+  }
+}
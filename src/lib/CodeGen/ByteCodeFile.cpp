@@ -0,0 +1,549 @@
+#include "simplecc/CodeGen/ByteCodeFile.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIMPLECC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace simplecc;
+
+static const char ByteCodeMagic[8] = {'S', 'C', 'C', 'B', 'C', '\0', '\r', '\n'};
+static const uint32_t ByteOrderMark = 0x01020304;
+
+/// The number of opcodes.
+static const unsigned NumOpcodes = 0
+#define HANDLE_OPCODE(opcode, camelName) +1
+#include "simplecc/CodeGen/Opcode.def"
+    ;
+
+/// The number of BasicTypeKind's.
+static const unsigned NumBasicTypes = 0
+#define HANDLE_BASICTYPE(Val, Str) +1
+#include "simplecc/AST/Enums.def"
+    ;
+
+namespace {
+/// Collect the strings of a module into a pool, giving each an ID.
+class StringPool {
+  std::unordered_map<std::string, uint32_t> IDs;
+  std::vector<uint32_t> Offsets;
+  std::string Data;
+
+public:
+  StringPool() { getID(""); }
+
+  uint32_t getID(const std::string &Str) {
+    auto Result = IDs.emplace(Str, static_cast<uint32_t>(Offsets.size()));
+    if (Result.second) {
+      Offsets.push_back(static_cast<uint32_t>(Data.size()));
+      Data.append(Str.c_str(), Str.size() + 1);
+    }
+    return Result.first->second;
+  }
+
+  const std::vector<uint32_t> &getOffsets() const { return Offsets; }
+  const std::string &getData() const { return Data; }
+};
+
+/// Return the Object of a symbol.
+ByteCodeFile::Object MakeObject(const SymbolEntry &E, StringPool &Strings) {
+  ByteCodeFile::Object O;
+  O.Name = Strings.getID(E.getName().str());
+  if (E.IsArray()) {
+    O.Kind = ByteCodeFile::Object::Array;
+    O.Type = static_cast<uint32_t>(E.AsArray().getElementType());
+    O.Size = E.AsArray().getSize();
+  } else {
+    O.Kind = E.IsFormalArgument() ? ByteCodeFile::Object::Argument
+                                  : ByteCodeFile::Object::Variable;
+    O.Type = static_cast<uint32_t>(E.AsVariable().getType());
+    O.Size = 0;
+  }
+  O.Line = E.getLocation().getLine();
+  O.Column = E.getLocation().getColumn();
+  return O;
+}
+
+/// Write the content of a vector and return its offset in the file.
+template <typename T>
+uint32_t WriteTable(std::ostream &O, const std::vector<T> &Table,
+                    uint32_t &Offset) {
+  uint32_t Start = Offset;
+  O.write(reinterpret_cast<const char *>(Table.data()),
+          Table.size() * sizeof(T));
+  Offset += static_cast<uint32_t>(Table.size() * sizeof(T));
+  return Start;
+}
+} // namespace
+
+void ByteCodeFile::Write(const ByteCodeModule &M, std::ostream &O) {
+  StringPool Strings;
+  std::vector<Object> Globals, Objects;
+  std::vector<Function> Functions;
+  std::vector<Code> Codes;
+
+  for (const SymbolEntry &E : M.getGlobalVariables())
+    Globals.push_back(MakeObject(E, Strings));
+
+  std::vector<uint32_t> StringLiterals;
+  for (const std::string &Str : M.getStringLiterals())
+    StringLiterals.push_back(Strings.getID(Str));
+
+  for (const ByteCodeFunction *Fn : M) {
+    Function F;
+    F.Name = Strings.getID(Fn->getName().str());
+    F.FirstObject = static_cast<uint32_t>(Objects.size());
+    F.NumArguments = static_cast<uint32_t>(Fn->getFormalArgumentCount());
+    F.NumLocals = static_cast<uint32_t>(Fn->getLocalVariables().size());
+    for (const SymbolEntry &E : Fn->getFormalArguments())
+      Objects.push_back(MakeObject(E, Strings));
+    for (const SymbolEntry &E : Fn->getLocalVariables())
+      Objects.push_back(MakeObject(E, Strings));
+    F.FirstCode = static_cast<uint32_t>(Codes.size());
+    F.NumCodes = static_cast<uint32_t>(Fn->size());
+    for (unsigned J = 0; J < F.NumCodes; ++J) {
+      const ByteCode &B = Fn->getByteCodeAt(J);
+      assert(!B.IsSuperinstruction() && "Superinstructions are not written");
+      Code C;
+      C.Opcode = B.getOpcode();
+      C.IntOperand = B.HasIntOperand() ? B.getIntOperand() : 0;
+      C.StrOperand =
+          B.HasStrOperand() ? Strings.getID(B.getStrOperand().str()) : 0;
+      C.SourceLineno = Fn->getSourceLinenoAt(J);
+      Codes.push_back(C);
+    }
+    Functions.push_back(F);
+  }
+
+  // Lay out the tables after the header, keeping the records aligned.
+  Header H;
+  std::memset(&H, 0, sizeof H);
+  std::memcpy(H.Magic, ByteCodeMagic, sizeof H.Magic);
+  H.Version = CurrentVersion;
+  H.ByteOrder = ByteOrderMark;
+  uint32_t Offset = sizeof H;
+  H.NumStrings = static_cast<uint32_t>(Strings.getOffsets().size());
+  H.StringOffsetsOffset = Offset;
+  Offset += H.NumStrings * sizeof(uint32_t);
+  H.NumStringLiterals = static_cast<uint32_t>(StringLiterals.size());
+  H.StringLiteralsOffset = Offset;
+  Offset += H.NumStringLiterals * sizeof(uint32_t);
+  H.NumGlobals = static_cast<uint32_t>(Globals.size());
+  H.GlobalsOffset = Offset;
+  Offset += H.NumGlobals * sizeof(Object);
+  H.NumFunctions = static_cast<uint32_t>(Functions.size());
+  H.FunctionsOffset = Offset;
+  Offset += H.NumFunctions * sizeof(Function);
+  H.NumObjects = static_cast<uint32_t>(Objects.size());
+  H.ObjectsOffset = Offset;
+  Offset += H.NumObjects * sizeof(Object);
+  H.NumCodes = static_cast<uint32_t>(Codes.size());
+  H.CodesOffset = Offset;
+  Offset += H.NumCodes * sizeof(Code);
+  H.StringDataOffset = Offset;
+  H.StringDataSize = static_cast<uint32_t>(Strings.getData().size());
+  H.FileSize = Offset + H.StringDataSize;
+
+  O.write(reinterpret_cast<const char *>(&H), sizeof H);
+  Offset = sizeof H;
+  WriteTable(O, Strings.getOffsets(), Offset);
+  WriteTable(O, StringLiterals, Offset);
+  WriteTable(O, Globals, Offset);
+  WriteTable(O, Functions, Offset);
+  WriteTable(O, Objects, Offset);
+  WriteTable(O, Codes, Offset);
+  O.write(Strings.getData().data(), Strings.getData().size());
+}
+
+bool ByteCodeFile::IsByteCodeFile(const std::string &Filename) {
+#if defined(SIMPLECC_HAVE_MMAP)
+  // Reading a pipe would take the bytes away from whoever reads it next.
+  struct stat Stat;
+  if (::stat(Filename.c_str(), &Stat) || !S_ISREG(Stat.st_mode))
+    return false;
+#endif
+  std::ifstream IS(Filename, std::ios::binary);
+  char Magic[sizeof ByteCodeMagic];
+  return IS.read(Magic, sizeof Magic) &&
+         std::memcmp(Magic, ByteCodeMagic, sizeof Magic) == 0;
+}
+
+ByteCodeFile::ByteCodeFile() { EM.setErrorType("ByteCodeFileError"); }
+
+ByteCodeFile::~ByteCodeFile() { close(); }
+
+void ByteCodeFile::close() {
+  if (!Data)
+    return;
+#if defined(SIMPLECC_HAVE_MMAP)
+  if (IsMapped)
+    ::munmap(const_cast<char *>(Data), Size);
+  else
+    delete[] Data;
+#else
+  delete[] Data;
+#endif
+  Data = nullptr;
+  Size = 0;
+  IsMapped = false;
+}
+
+bool ByteCodeFile::Open(const std::string &Filename) {
+  close();
+  EM.clear();
+  this->Filename = Filename;
+#if defined(SIMPLECC_HAVE_MMAP)
+  int FD = ::open(Filename.c_str(), O_RDONLY);
+  struct stat St;
+  if (FD >= 0 && ::fstat(FD, &St) == 0 && St.st_size > 0) {
+    void *Addr = ::mmap(nullptr, static_cast<size_t>(St.st_size), PROT_READ,
+                        MAP_PRIVATE, FD, 0);
+    if (Addr != MAP_FAILED) {
+      Data = static_cast<const char *>(Addr);
+      Size = static_cast<size_t>(St.st_size);
+      IsMapped = true;
+    }
+  }
+  if (FD >= 0)
+    ::close(FD);
+#endif
+  if (!Data) {
+    // Read the file into memory where it can't be mapped.
+    std::ifstream IS(Filename, std::ios::binary | std::ios::ate);
+    if (!IS) {
+      EM.setErrorType("FileReadError");
+      EM.Error(Quote(Filename));
+      EM.setErrorType("ByteCodeFileError");
+      return true;
+    }
+    Size = static_cast<size_t>(IS.tellg());
+    char *Buffer = new char[Size ? Size : 1];
+    IS.seekg(0);
+    IS.read(Buffer, Size);
+    Data = Buffer;
+  }
+  if (Verify()) {
+    close();
+    return true;
+  }
+  return false;
+}
+
+bool ByteCodeFile::Verify() {
+  if (Size < sizeof(Header) ||
+      std::memcmp(getHeader().Magic, ByteCodeMagic, sizeof ByteCodeMagic)) {
+    EM.Error(Quote(Filename), "is not a byte code file");
+    return true;
+  }
+  const Header &H = getHeader();
+  if (H.ByteOrder != ByteOrderMark || H.Version != CurrentVersion) {
+    EM.Error(Quote(Filename), "is written by an incompatible compiler");
+    return true;
+  }
+
+  // Each table must lie in the file.
+  auto InFile = [this](uint32_t Offset, uint64_t Count, size_t Bytes) {
+    return Offset % 4 == 0 && Offset <= Size &&
+           Count * Bytes <= Size - Offset;
+  };
+  if (H.FileSize != Size ||
+      !InFile(H.StringOffsetsOffset, H.NumStrings, sizeof(uint32_t)) ||
+      !InFile(H.StringLiteralsOffset, H.NumStringLiterals, sizeof(uint32_t)) ||
+      !InFile(H.GlobalsOffset, H.NumGlobals, sizeof(Object)) ||
+      !InFile(H.FunctionsOffset, H.NumFunctions, sizeof(Function)) ||
+      !InFile(H.ObjectsOffset, H.NumObjects, sizeof(Object)) ||
+      !InFile(H.CodesOffset, H.NumCodes, sizeof(Code)) ||
+      H.StringDataOffset > Size ||
+      H.StringDataSize > Size - H.StringDataOffset) {
+    EM.Error(Quote(Filename), "is truncated");
+    return true;
+  }
+
+  // Each string must end in the pool, which ends with a NUL.
+  const uint32_t *StringOffsets = getAt<uint32_t>(H.StringOffsetsOffset);
+  bool OK = H.NumStrings > 0 && H.StringDataSize > 0 &&
+            getAt<char>(H.StringDataOffset)[H.StringDataSize - 1] == '\0';
+  for (uint32_t I = 0; OK && I < H.NumStrings; ++I)
+    OK = StringOffsets[I] < H.StringDataSize;
+
+  // Each reference must be in range.
+  const uint32_t *StringLiterals = getAt<uint32_t>(H.StringLiteralsOffset);
+  for (uint32_t I = 0; OK && I < H.NumStringLiterals; ++I)
+    OK = StringLiterals[I] < H.NumStrings;
+  auto VerifyObjects = [&H](const Object *Objects, uint32_t Count) {
+    for (uint32_t I = 0; I < Count; ++I) {
+      if (Objects[I].Name >= H.NumStrings ||
+          Objects[I].Kind > Object::Argument ||
+          Objects[I].Type >= NumBasicTypes)
+        return false;
+    }
+    return true;
+  };
+  OK = OK && VerifyObjects(getGlobals(), H.NumGlobals);
+  for (uint32_t I = 0; OK && I < H.NumFunctions; ++I) {
+    const Function &F = getFunctions()[I];
+    OK = F.Name < H.NumStrings && F.FirstObject <= H.NumObjects &&
+         uint64_t(F.NumArguments) + F.NumLocals <=
+             H.NumObjects - F.FirstObject &&
+         F.FirstCode <= H.NumCodes && F.NumCodes <= H.NumCodes - F.FirstCode &&
+         VerifyObjects(getObjects(F), F.NumArguments + F.NumLocals);
+    const Code *Codes = getCode(F);
+    for (uint32_t J = 0; OK && J < F.NumCodes; ++J) {
+      const Code &C = Codes[J];
+      OK = C.Opcode < NumOpcodes && C.StrOperand < H.NumStrings;
+      if (!OK)
+        break;
+      ByteCode B = ByteCode::Create(static_cast<ByteCode::Opcode>(C.Opcode));
+      if (B.IsSuperinstruction()) {
+        OK = false;
+        break;
+      }
+      // A jump may target the end of the function but not beyond.
+      if (B.IsJump())
+        OK = C.IntOperand >= 0 &&
+             static_cast<uint32_t>(C.IntOperand) <= F.NumCodes;
+      else if (B.HasIntOperand() && B.HasStrOperand())
+        OK = C.IntOperand >= 0 && C.IntOperand <= ByteCode::MaxSmallIntOperand;
+    }
+  }
+  if (!OK) {
+    EM.Error(Quote(Filename), "is corrupted");
+    return true;
+  }
+
+  // The writer pools each string once, so a name is known by its ID.
+  std::vector<const Object *> GlobalOf(H.NumStrings, nullptr);
+  std::vector<const Function *> FunctionOf(H.NumStrings, nullptr);
+  for (uint32_t I = 0; I < H.NumGlobals; ++I)
+    GlobalOf[getGlobals()[I].Name] = &getGlobals()[I];
+  for (uint32_t I = 0; I < H.NumFunctions; ++I)
+    FunctionOf[getFunctions()[I].Name] = &getFunctions()[I];
+  for (uint32_t I = 0; I < H.NumFunctions; ++I) {
+    if (VerifyCode(getFunctions()[I], GlobalOf, FunctionOf))
+      return true;
+  }
+  return false;
+}
+
+/// Return the number of operands a ByteCode pops and pushes.
+static std::pair<unsigned, unsigned> getStackEffect(ByteCode::Opcode Op,
+                                                    int32_t IntOperand) {
+  switch (Op) {
+  case ByteCode::LOAD_LOCAL:
+  case ByteCode::LOAD_GLOBAL:
+  case ByteCode::LOAD_CONST:
+  case ByteCode::LOAD_STRING:
+  case ByteCode::READ_INTEGER:
+  case ByteCode::READ_CHARACTER:
+    return {0, 1};
+  case ByteCode::BINARY_ADD:
+  case ByteCode::BINARY_SUB:
+  case ByteCode::BINARY_MULTIPLY:
+  case ByteCode::BINARY_DIVIDE:
+  case ByteCode::BINARY_SUBSCR:
+    return {2, 1};
+  case ByteCode::UNARY_POSITIVE:
+  case ByteCode::UNARY_NEGATIVE:
+    return {1, 1};
+  case ByteCode::STORE_SUBSCR:
+    return {3, 0};
+  case ByteCode::CALL_FUNCTION:
+    return {static_cast<unsigned>(IntOperand), 1};
+  case ByteCode::JUMP_FORWARD:
+  case ByteCode::PRINT_NEWLINE:
+  case ByteCode::RETURN_NONE:
+    return {0, 0};
+  case ByteCode::JUMP_IF_EQUAL:
+  case ByteCode::JUMP_IF_NOT_EQUAL:
+  case ByteCode::JUMP_IF_GREATER:
+  case ByteCode::JUMP_IF_GREATER_EQUAL:
+  case ByteCode::JUMP_IF_LESS:
+  case ByteCode::JUMP_IF_LESS_EQUAL:
+    return {2, 0};
+  default:
+    // The stores, the prints, the unary jumps, RETURN_VALUE and POP_TOP.
+    assert(!ByteCode::Create(Op).IsSuperinstruction() && "Not in a file");
+    return {1, 0};
+  }
+}
+
+bool ByteCodeFile::VerifyCode(const Function &F,
+                              const std::vector<const Object *> &GlobalOf,
+                              const std::vector<const Function *> &FunctionOf) {
+  const Header &H = getHeader();
+  std::unordered_map<uint32_t, const Object *> LocalOf;
+  const Object *Objects = getObjects(F);
+  for (uint32_t I = 0; I < F.NumArguments + F.NumLocals; ++I)
+    LocalOf.emplace(Objects[I].Name, &Objects[I]);
+
+  // Only a jump or a return ends a block, and the stack is empty at every
+  // jump target, so the code can be walked in order.
+  const Code *Codes = getCode(F);
+  std::vector<bool> IsTarget(F.NumCodes + 1, false);
+  for (uint32_t J = 0; J < F.NumCodes; ++J) {
+    if (ByteCode::Create(static_cast<ByteCode::Opcode>(Codes[J].Opcode))
+            .IsJump())
+      IsTarget[Codes[J].IntOperand] = true;
+  }
+
+  const char *FnName = getString(F.Name);
+  unsigned Depth = 0;
+  for (uint32_t J = 0; J <= F.NumCodes; ++J) {
+    if ((IsTarget[J] || J == F.NumCodes) && Depth) {
+      EM.Error(Quote(Filename), "is corrupted: the operand stack of",
+               Quote(FnName), "is not empty at", J);
+      return true;
+    }
+    if (J == F.NumCodes)
+      break;
+    const Code &C = Codes[J];
+    auto Op = static_cast<ByteCode::Opcode>(C.Opcode);
+    ByteCode B = ByteCode::Create(Op);
+    const Object *Obj = nullptr;
+    switch (Op) {
+    case ByteCode::LOAD_LOCAL:
+    case ByteCode::STORE_LOCAL: {
+      auto Iter = LocalOf.find(C.StrOperand);
+      if (Iter != LocalOf.end())
+        Obj = Iter->second;
+      break;
+    }
+    case ByteCode::LOAD_GLOBAL:
+    case ByteCode::STORE_GLOBAL:
+      // A global shadowed by a local is not visible.
+      if (!LocalOf.count(C.StrOperand))
+        Obj = GlobalOf[C.StrOperand];
+      break;
+    case ByteCode::CALL_FUNCTION: {
+      const Function *Callee = FunctionOf[C.StrOperand];
+      if (!Callee || Callee->NumArguments != uint32_t(C.IntOperand)) {
+        EM.Error(Quote(Filename), "is corrupted:", Quote(FnName), "calls",
+                 Quote(getString(C.StrOperand)), "wrongly at", J);
+        return true;
+      }
+      break;
+    }
+    case ByteCode::LOAD_STRING:
+      if (C.IntOperand < 0 || uint32_t(C.IntOperand) >= H.NumStringLiterals) {
+        EM.Error(Quote(Filename), "is corrupted:", Quote(FnName),
+                 "loads undefined string literal", C.IntOperand, "at", J);
+        return true;
+      }
+      break;
+    default:
+      break;
+    }
+    if (B.HasStrOperand() && Op != ByteCode::CALL_FUNCTION) {
+      bool IsStore =
+          Op == ByteCode::STORE_LOCAL || Op == ByteCode::STORE_GLOBAL;
+      if (!Obj || (IsStore && Obj->Kind == Object::Array)) {
+        EM.Error(Quote(Filename), "is corrupted:", Quote(FnName),
+                 "refers to undefined name", Quote(getString(C.StrOperand)),
+                 "at", J);
+        return true;
+      }
+    }
+
+    std::pair<unsigned, unsigned> Effect = getStackEffect(Op, C.IntOperand);
+    if (Depth < Effect.first) {
+      EM.Error(Quote(Filename), "is corrupted: the operand stack of",
+               Quote(FnName), "is popped when empty at", J);
+      return true;
+    }
+    Depth = Depth - Effect.first + Effect.second;
+    bool EndsBlock = B.IsJump() || Op == ByteCode::RETURN_VALUE ||
+                     Op == ByteCode::RETURN_NONE;
+    if (EndsBlock && Depth) {
+      EM.Error(Quote(Filename), "is corrupted: the operand stack of",
+               Quote(FnName), "is not empty at", J);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ByteCodeFile::Load(ByteCodeModule &M) {
+  assert(Data && "File not open");
+  M.clear();
+  ASTContext &Context = M.getContext();
+  auto getIdentifier = [this](uint32_t ID) {
+    const char *Str = getString(ID);
+    return Identifier::get(Str, std::strlen(Str));
+  };
+  auto CreateDecl = [&](const Object &O) -> DeclAST * {
+    auto Type = static_cast<BasicTypeKind>(O.Type);
+    Location Loc(O.Line, O.Column);
+    if (O.Kind == Object::Argument)
+      return new (Context) ArgDecl(Type, getIdentifier(O.Name), Loc);
+    return new (Context) VarDecl(Type, getIdentifier(O.Name),
+                                 O.Kind == Object::Array, O.Size, Loc);
+  };
+
+  std::unordered_map<Identifier, SymbolEntry> Globals;
+  for (size_t I = 0, E = getNumGlobals(); I < E; ++I) {
+    SymbolEntry Entry(Scope::Global, CreateDecl(getGlobals()[I]));
+    if (!Globals.emplace(Entry.getName(), Entry).second) {
+      EM.Error(Quote(Filename), "redefines", Quote(Entry.getName().str()));
+      return true;
+    }
+    M.getGlobalVariables().push_back(Entry);
+  }
+
+  for (uint32_t I = 0, E = getHeader().NumStringLiterals; I < E; ++I) {
+    if (M.getStringLiteralID(getStringLiteral(I)) != I) {
+      EM.Error(Quote(Filename), "has duplicate string literals");
+      return true;
+    }
+  }
+
+  for (size_t I = 0, E = getNumFunctions(); I < E; ++I) {
+    const Function &F = getFunctions()[I];
+    ByteCodeFunction *Fn = ByteCodeFunction::Create(&M);
+    Fn->setName(getIdentifier(F.Name));
+
+    // The local table holds the locals and the globals the code uses, just
+    // like the one built by the SymbolTableBuilder.
+    TableType &Table = M.createLocalTable();
+    const Object *Objects = getObjects(F);
+    for (uint32_t J = 0; J < F.NumArguments + F.NumLocals; ++J) {
+      SymbolEntry Entry(Scope::Local, CreateDecl(Objects[J]));
+      if (Table.count(Entry.getName())) {
+        EM.Error(Quote(Filename), "redefines", Quote(Entry.getName().str()));
+        return true;
+      }
+      Table.insert(Entry.getName(), Entry);
+      if (J < F.NumArguments)
+        Fn->getFormalArguments().push_back(Entry);
+      else
+        Fn->getLocalVariables().push_back(Entry);
+    }
+
+    const Code *Codes = getCode(F);
+    Fn->reserve(F.NumCodes);
+    for (uint32_t J = 0; J < F.NumCodes; ++J) {
+      auto Op = static_cast<ByteCode::Opcode>(Codes[J].Opcode);
+      ByteCode B = ByteCode::Create(Op);
+      if (B.HasIntOperand())
+        B.setIntOperand(Codes[J].IntOperand);
+      if (B.HasStrOperand()) {
+        Identifier Name = getIdentifier(Codes[J].StrOperand);
+        B.setStrOperand(Name);
+        auto Iter = Globals.find(Name);
+        if (!Table.count(Name) && Iter != Globals.end())
+          Table.insert(Name, Iter->second);
+      }
+      Fn->append(B, Codes[J].SourceLineno);
+    }
+    Fn->setLocalTable(LocalSymbolTable(Table));
+  }
+  return false;
+}
@@ -22,7 +22,30 @@ void ByteCodeFunction::Format(std::ostream &O) const {
     O << LocalVar << "\n";
   }
 
-  for (const ByteCode &Code : *this) {
-    O << Code << "\n";
+  for (unsigned I = 0, E = size(); I < E; ++I) {
+    O << std::left << std::setw(4) << I << getByteCodeAt(I) << "\n";
   }
-}
\ No newline at end of file
+}
+
+void ByteCodeFunction::removeByteCodes(const std::vector<bool> &Removed) {
+  assert(Removed.size() == size() && "One entry for each ByteCode");
+  // Map each offset to that of the first ByteCode kept at or after it.
+  std::vector<unsigned> NewOffsets(size() + 1);
+  unsigned NewSize = 0;
+  for (unsigned I = 0, E = size(); I < E; ++I) {
+    NewOffsets[I] = NewSize;
+    if (Removed[I])
+      continue;
+    ByteCodeList[NewSize] = ByteCodeList[I];
+    SourceLinenos[NewSize] = SourceLinenos[I];
+    ++NewSize;
+  }
+  NewOffsets[size()] = NewSize;
+  ByteCodeList.erase(ByteCodeList.begin() + NewSize, ByteCodeList.end());
+  SourceLinenos.resize(NewSize);
+
+  for (ByteCode &C : ByteCodeList) {
+    if (C.IsJump())
+      C.setJumpTarget(NewOffsets[C.getJumpTarget()]);
+  }
+}
@@ -0,0 +1,143 @@
+#include "simplecc/CodeGen/ByteCodeFuser.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include <algorithm>
+
+using namespace simplecc;
+
+static bool FitsConstOperand(int64_t Val) {
+  return Val >= ByteCode::MinConstOperand && Val <= ByteCode::MaxConstOperand;
+}
+
+void ByteCodeFuser::Fuse(ByteCodeModule &M) {
+  for (ByteCodeFunction *Fn : M)
+    Fuse(*Fn);
+}
+
+void ByteCodeFuser::Fuse(ByteCodeFunction &F) {
+  IsJumpTarget.assign(F.size() + 1, false);
+  for (const ByteCode &C : F) {
+    if (C.IsJump())
+      IsJumpTarget[C.getJumpTarget()] = true;
+  }
+  // A local array cannot be added to.
+  Arrays.clear();
+  for (const SymbolEntry &E : F.getLocalVariables()) {
+    if (E.IsArray())
+      Arrays.insert(E.getName());
+  }
+
+  Removed.assign(F.size(), false);
+  bool Changed = false;
+  for (unsigned I = 0, E = F.size(); I < E;) {
+    unsigned Len = FuseAt(F, I);
+    if (!Len) {
+      ++I;
+      continue;
+    }
+    std::fill(Removed.begin() + I + 1, Removed.begin() + I + Len, true);
+    I += Len;
+    ++NumFused;
+    Changed = true;
+  }
+  if (Changed)
+    F.removeByteCodes(Removed);
+}
+
+ByteCode::Opcode ByteCodeFuser::getJumpWithConst(ByteCode::Opcode Op) {
+  switch (Op) {
+  case ByteCode::JUMP_IF_EQUAL:
+    return ByteCode::JUMP_IF_EQUAL_CONST;
+  case ByteCode::JUMP_IF_NOT_EQUAL:
+    return ByteCode::JUMP_IF_NOT_EQUAL_CONST;
+  case ByteCode::JUMP_IF_GREATER:
+    return ByteCode::JUMP_IF_GREATER_CONST;
+  case ByteCode::JUMP_IF_GREATER_EQUAL:
+    return ByteCode::JUMP_IF_GREATER_EQUAL_CONST;
+  case ByteCode::JUMP_IF_LESS:
+    return ByteCode::JUMP_IF_LESS_CONST;
+  case ByteCode::JUMP_IF_LESS_EQUAL:
+    return ByteCode::JUMP_IF_LESS_EQUAL_CONST;
+  default:
+    return Op;
+  }
+}
+
+unsigned ByteCodeFuser::FuseAt(ByteCodeFunction &F, unsigned Idx) {
+  // Return if a sequence of Len at Idx is in the code and only entered
+  // at its start.
+  auto IsSequence = [this, &F, Idx](unsigned Len) {
+    if (Idx + Len > F.size())
+      return false;
+    for (unsigned I = Idx + 1; I < Idx + Len; ++I) {
+      if (IsJumpTarget[I])
+        return false;
+    }
+    return true;
+  };
+  auto getOpcodeAt = [&F](unsigned I) {
+    return F.getByteCodeAt(I).getOpcode();
+  };
+  ByteCode &Head = F.getByteCodeAt(Idx);
+
+  switch (Head.getOpcode()) {
+  case ByteCode::LOAD_STRING:
+    if (!IsSequence(2) || getOpcodeAt(Idx + 1) != ByteCode::PRINT_STRING)
+      return 0;
+    Head = ByteCode::Create(ByteCode::PRINT_STRING_LITERAL,
+                            Head.getIntOperand());
+    return 2;
+
+  case ByteCode::LOAD_CONST: {
+    int Val = Head.getIntOperand();
+    if (!IsSequence(2) || !FitsConstOperand(Val))
+      return 0;
+    const ByteCode &Next = F.getByteCodeAt(Idx + 1);
+    if (Next.getOpcode() == ByteCode::STORE_LOCAL) {
+      ByteCode Fused = ByteCode::Create(ByteCode::STORE_LOCAL_CONST,
+                                        Next.getStrOperand());
+      Fused.setConstOperand(Val);
+      Head = Fused;
+      return 2;
+    }
+    ByteCode::Opcode Op = getJumpWithConst(Next.getOpcode());
+    if (Op == Next.getOpcode())
+      return 0;
+    ByteCode Fused = ByteCode::Create(Op, Next.getJumpTarget());
+    Fused.setConstOperand(Val);
+    Head = Fused;
+    return 2;
+  }
+
+  case ByteCode::LOAD_LOCAL: {
+    Identifier Name = Head.getStrOperand();
+    if (Arrays.count(Name) || !IsSequence(3) ||
+        getOpcodeAt(Idx + 1) != ByteCode::LOAD_CONST)
+      return 0;
+    int64_t Val = F.getByteCodeAt(Idx + 1).getIntOperand();
+    switch (getOpcodeAt(Idx + 2)) {
+    case ByteCode::BINARY_ADD:
+      break;
+    case ByteCode::BINARY_SUB:
+      Val = -Val;
+      break;
+    default:
+      return 0;
+    }
+    if (!FitsConstOperand(Val))
+      return 0;
+    // Adding to a local in place: x = x + c.
+    bool InPlace = IsSequence(4) &&
+                   getOpcodeAt(Idx + 3) == ByteCode::STORE_LOCAL &&
+                   F.getByteCodeAt(Idx + 3).getStrOperand() == Name;
+    ByteCode Fused = ByteCode::Create(
+        InPlace ? ByteCode::INCREMENT_LOCAL : ByteCode::ADD_LOCAL_CONST, Name);
+    Fused.setConstOperand(static_cast<int>(Val));
+    Head = Fused;
+    return InPlace ? 4 : 3;
+  }
+
+  default:
+    return 0;
+  }
+}
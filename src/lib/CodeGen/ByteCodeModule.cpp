@@ -12,7 +12,21 @@ void ByteCodeModule::clear() {
   std::for_each(begin(), end(), std::default_delete<ByteCodeFunction>());
   FunctionList.clear();
   StringLiterals.clear();
+  StringLiteralList.clear();
   GlobalVariables.clear();
+  LocalTables.clear();
+  TheContext.reset();
+}
+
+ASTContext &ByteCodeModule::getContext() {
+  if (!TheContext)
+    TheContext.reset(new ASTContext());
+  return *TheContext;
+}
+
+TableType &ByteCodeModule::createLocalTable() {
+  LocalTables.emplace_back(new TableType());
+  return *LocalTables.back();
 }
 
 ByteCodeModule::~ByteCodeModule() {
@@ -22,7 +36,10 @@ ByteCodeModule::~ByteCodeModule() {
 
 unsigned ByteCodeModule::getStringLiteralID(const std::string &Str) {
   auto ID = static_cast<unsigned int>(StringLiterals.size());
-  return StringLiterals.emplace(Str, ID).first->second;
+  auto Result = StringLiterals.emplace(Str, ID);
+  if (Result.second)
+    StringLiteralList.push_back(Str);
+  return Result.first->second;
 }
 
 // TODO: make the printing better (currently like a shut).
@@ -32,8 +49,9 @@ void ByteCodeModule::Format(std::ostream &O) const {
   }
 
   O << "\n";
-  for (const auto &Pair : getStringLiteralTable()) {
-    O << std::setw(4) << Pair.second << ": " << Pair.first << "\n";
+  const std::vector<std::string> &Strings = getStringLiterals();
+  for (unsigned I = 0, E = Strings.size(); I < E; ++I) {
+    O << std::setw(4) << I << ": " << Strings[I] << "\n";
   }
 
   O << "\n";
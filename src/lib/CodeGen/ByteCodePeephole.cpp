@@ -0,0 +1,211 @@
+#include "simplecc/CodeGen/ByteCodePeephole.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+
+using namespace simplecc;
+
+/// Return if LOAD_CONST Val followed by Op leaves the other operand as it is.
+static bool IsIdentity(int Val, ByteCode::Opcode Op) {
+  switch (Op) {
+  case ByteCode::BINARY_ADD:
+  case ByteCode::BINARY_SUB:
+    return Val == 0;
+  case ByteCode::BINARY_MULTIPLY:
+  case ByteCode::BINARY_DIVIDE:
+    return Val == 1;
+  default:
+    return false;
+  }
+}
+
+void ByteCodePeephole::Optimize(ByteCodeModule &M) {
+  for (ByteCodeFunction *Fn : M)
+    Optimize(*Fn);
+}
+
+bool ByteCodePeephole::Optimize(ByteCodeFunction &F) {
+  for (const ByteCode &C : F) {
+    if (C.IsSuperinstruction())
+      return false;
+  }
+  unsigned Before = F.size();
+  while (RunOnce(F))
+    ;
+  Stats.push_back(FunctionStats{F.getName(), Before, unsigned(F.size())});
+  NumRemoved += Before - F.size();
+  return Before != F.size();
+}
+
+bool ByteCodePeephole::RunOnce(ByteCodeFunction &F) {
+  bool Changed = false;
+  if (Opts.ThreadJumps)
+    Changed |= ThreadJumps(F);
+  TheCFG.Compute(F);
+  // Only the variables stored and loaded back right away are tracked.
+  Variables.clear();
+  if (Opts.RemoveDeadStores) {
+    for (unsigned I = 1, E = F.size(); I < E; ++I) {
+      const ByteCode &Store = F.getByteCodeAt(I - 1);
+      const ByteCode &Load = F.getByteCodeAt(I);
+      if (Store.getOpcode() == ByteCode::STORE_LOCAL &&
+          Load.getOpcode() == ByteCode::LOAD_LOCAL &&
+          Store.getStrOperand() == Load.getStrOperand())
+        Variables.emplace(Store.getStrOperand(), Variables.size());
+    }
+    if (!Variables.empty())
+      ComputeLiveness(F);
+  }
+
+  Removed.assign(F.size(), false);
+  bool HasRemoved = false;
+  auto Remove = [this, &HasRemoved](unsigned I) {
+    Removed[I] = true;
+    HasRemoved = true;
+  };
+  for (unsigned B = 0, E = TheCFG.getNumBlocks(); B < E; ++B) {
+    const ByteCodeCFG::BasicBlock &BB = TheCFG.getBlock(B);
+    if (!TheCFG.IsReachable(B)) {
+      if (Opts.RemoveUnreachable) {
+        for (unsigned I = BB.Begin; I < BB.End; ++I)
+          Remove(I);
+      }
+      continue;
+    }
+    if (!Variables.empty())
+      MarkDeadStores(F, B);
+    for (unsigned I = BB.Begin; I < BB.End; ++I) {
+      if (Removed[I]) {
+        HasRemoved = true;
+        continue;
+      }
+      const ByteCode &C = F.getByteCodeAt(I);
+      if (Opts.RemoveJumpsToNext && C.getOpcode() == ByteCode::JUMP_FORWARD &&
+          C.getJumpTarget() == I + 1) {
+        Remove(I);
+        continue;
+      }
+      if (!Opts.RemoveIdentities)
+        continue;
+      if (C.getOpcode() == ByteCode::UNARY_POSITIVE) {
+        Remove(I);
+        continue;
+      }
+      if (C.getOpcode() == ByteCode::LOAD_CONST && I + 1 < BB.End &&
+          !Removed[I + 1] &&
+          IsIdentity(C.getIntOperand(), F.getByteCodeAt(I + 1).getOpcode())) {
+        Remove(I);
+        Remove(I + 1);
+        ++I;
+      }
+    }
+  }
+
+  if (!HasRemoved)
+    return Changed;
+  F.removeByteCodes(Removed);
+  return true;
+}
+
+bool ByteCodePeephole::ThreadJumps(ByteCodeFunction &F) {
+  bool Changed = false;
+  unsigned Size = F.size();
+  for (ByteCode &C : F) {
+    if (!C.IsJump())
+      continue;
+    // A chain longer than the code is a cycle, which is left alone.
+    unsigned Target = C.getJumpTarget();
+    unsigned Steps = 0;
+    while (Target < Size && Steps < Size &&
+           F.getByteCodeAt(Target).getOpcode() == ByteCode::JUMP_FORWARD) {
+      Target = F.getByteCodeAt(Target).getJumpTarget();
+      ++Steps;
+    }
+    if (Steps == Size || Target == C.getJumpTarget())
+      continue;
+    C.setJumpTarget(Target);
+    Changed = true;
+  }
+  return Changed;
+}
+
+unsigned ByteCodePeephole::getVariable(const ByteCode &C) const {
+  if (C.getOpcode() != ByteCode::LOAD_LOCAL &&
+      C.getOpcode() != ByteCode::STORE_LOCAL)
+    return ByteCodeCFG::None;
+  auto Iter = Variables.find(C.getStrOperand());
+  return Iter == Variables.end() ? ByteCodeCFG::None : Iter->second;
+}
+
+void ByteCodePeephole::ComputeLiveness(const ByteCodeFunction &F) {
+  unsigned NumBlocks = TheCFG.getNumBlocks();
+  NumWords = (Variables.size() + 63) / 64;
+  // The sets of all blocks are kept in a row, NumWords for each.
+  auto Row = [this](std::vector<uint64_t> &Sets, unsigned B) {
+    return Sets.begin() + B * NumWords;
+  };
+  Use.assign(NumBlocks * NumWords, 0);
+  Def.assign(NumBlocks * NumWords, 0);
+  LiveIn.assign(NumBlocks * NumWords, 0);
+  LiveOut.assign(NumBlocks * NumWords, 0);
+  for (unsigned B = 0; B < NumBlocks; ++B) {
+    const ByteCodeCFG::BasicBlock &BB = TheCFG.getBlock(B);
+    auto BlockUse = Row(Use, B), BlockDef = Row(Def, B);
+    for (unsigned I = BB.Begin; I < BB.End; ++I) {
+      const ByteCode &C = F.getByteCodeAt(I);
+      unsigned V = getVariable(C);
+      if (V == ByteCodeCFG::None)
+        continue;
+      uint64_t Bit = uint64_t(1) << (V % 64);
+      if (C.getOpcode() == ByteCode::STORE_LOCAL)
+        BlockDef[V / 64] |= Bit;
+      else if (!(BlockDef[V / 64] & Bit))
+        BlockUse[V / 64] |= Bit;
+    }
+  }
+
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    for (unsigned B = NumBlocks; B-- > 0;) {
+      auto Out = Row(LiveOut, B), In = Row(LiveIn, B);
+      for (unsigned S : TheCFG.getBlock(B).Successors) {
+        auto SuccIn = Row(LiveIn, S);
+        for (unsigned W = 0; W < NumWords; ++W)
+          Out[W] |= SuccIn[W];
+      }
+      auto BlockUse = Row(Use, B), BlockDef = Row(Def, B);
+      for (unsigned W = 0; W < NumWords; ++W) {
+        uint64_t New = BlockUse[W] | (Out[W] & ~BlockDef[W]);
+        Changed |= New != In[W];
+        In[W] = New;
+      }
+    }
+  }
+}
+
+void ByteCodePeephole::MarkDeadStores(const ByteCodeFunction &F, unsigned B) {
+  const ByteCodeCFG::BasicBlock &BB = TheCFG.getBlock(B);
+  // What is live after the ByteCode being looked at.
+  Live.assign(LiveOut.begin() + B * NumWords,
+              LiveOut.begin() + (B + 1) * NumWords);
+  for (unsigned I = BB.End; I-- > BB.Begin;) {
+    const ByteCode &C = F.getByteCodeAt(I);
+    unsigned V = getVariable(C);
+    if (V == ByteCodeCFG::None)
+      continue;
+    uint64_t Bit = uint64_t(1) << (V % 64);
+    if (C.getOpcode() == ByteCode::STORE_LOCAL) {
+      Live[V / 64] &= ~Bit;
+      continue;
+    }
+    // The pair neither uses nor defines the variable once removed.
+    if (!(Live[V / 64] & Bit) && I > BB.Begin &&
+        F.getByteCodeAt(I - 1).getOpcode() == ByteCode::STORE_LOCAL &&
+        getVariable(F.getByteCodeAt(I - 1)) == V) {
+      Removed[I] = Removed[I - 1] = true;
+      --I;
+      continue;
+    }
+    Live[V / 64] |= Bit;
+  }
+}
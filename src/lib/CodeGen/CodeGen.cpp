@@ -1,5 +1,9 @@
 #include "simplecc/CodeGen/CodeGen.h"
+#include "simplecc/CodeGen/ByteCodeCFG.h"
 #include "simplecc/CodeGen/ByteCodeCompiler.h"
+#include "simplecc/CodeGen/ByteCodeFuser.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/CodeGen/ByteCodePeephole.h"
 #include "simplecc/CodeGen/ByteCodePrinter.h"
 
 namespace simplecc {
@@ -10,4 +14,45 @@ void PrintByteCode(ProgramAST *P, std::ostream &O) {
 void CompileToByteCode(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M) {
   ByteCodeCompiler().Compile(P, S, M);
 }
+
+void CompileToByteCode(ProgramAST *P, const SymbolTable &S, ByteCodeModule &M,
+                       ThreadPool &Pool) {
+  ByteCodeCompiler().Compile(P, S, M, Pool);
+}
+
+unsigned OptimizeByteCode(ByteCodeModule &M, std::ostream *Report) {
+  ByteCodePeephole Peephole;
+  Peephole.Optimize(M);
+  if (Report) {
+    for (const ByteCodePeephole::FunctionStats &S : Peephole.getStats()) {
+      *Report << S.Name << ": " << S.Before << " -> " << S.After
+              << " bytecodes (-" << S.Before - S.After << ")\n";
+    }
+  }
+  return Peephole.getNumRemoved();
+}
+
+unsigned FuseByteCode(ByteCodeModule &M) {
+  ByteCodeFuser Fuser;
+  Fuser.Fuse(M);
+  return Fuser.getNumFused();
+}
+
+void PrintByteCodeCFG(const ByteCodeModule &M, std::ostream &O) {
+  ByteCodeCFG CFG;
+  for (const ByteCodeFunction *Fn : M) {
+    CFG.Compute(*Fn);
+    O << CFG << "\n";
+  }
+}
+
+void WriteByteCodeCFGGraph(const ByteCodeModule &M, std::ostream &O) {
+  ByteCodeCFG CFG;
+  O << "digraph CFG {\n";
+  for (const ByteCodeFunction *Fn : M) {
+    CFG.Compute(*Fn);
+    CFG.WriteDOT(O);
+  }
+  O << "}\n";
+}
 } // namespace simplecc
\ No newline at end of file
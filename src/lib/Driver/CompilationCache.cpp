@@ -0,0 +1,223 @@
+#include "simplecc/Driver/CompilationCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIMPLECC_HAVE_POSIX_FS 1
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#elif defined(_WIN32)
+#include <direct.h>
+#endif
+
+using namespace simplecc;
+
+/// Bump this when the format of the entries changes.
+static const char CacheMagic[] = "simplecc-cache 1";
+
+namespace {
+/// 64-bit FNV-1a, which can be fed in pieces.
+class Hasher {
+  uint64_t H = 14695981039346656037ull;
+
+public:
+  void update(const char *Data, size_t Size) {
+    for (size_t I = 0; I < Size; ++I) {
+      H ^= static_cast<unsigned char>(Data[I]);
+      H *= 1099511628211ull;
+    }
+  }
+  void update(const std::string &S) {
+    // Hash the terminating NUL too so that pieces can't run together.
+    update(S.c_str(), S.size() + 1);
+  }
+  uint64_t get() const { return H; }
+};
+
+/// Read the whole file into Text. Return false on failure.
+bool ReadWholeFile(const std::string &Filename, std::string &Text) {
+  std::ifstream IS(Filename, std::ios::binary);
+  if (!IS)
+    return false;
+  std::ostringstream OS;
+  OS << IS.rdbuf();
+  Text = OS.str();
+  return !IS.bad();
+}
+
+/// Return a hash of the running compiler. The executable is hashed where it
+/// can be found, so that every build has its own entries.
+uint64_t HashCompiler() {
+  Hasher H;
+  H.update(CacheMagic);
+  H.update("simplecc 3.0");
+  std::string Exe;
+  if (ReadWholeFile("/proc/self/exe", Exe))
+    H.update(Exe);
+  return H.get();
+}
+} // namespace
+
+CompilationCache::CompilationCache(std::string Dir, uint64_t MaxSize)
+    : Dir(std::move(Dir)), MaxSize(MaxSize), CompilerHash(HashCompiler()) {
+#if defined(SIMPLECC_HAVE_POSIX_FS)
+  ::mkdir(this->Dir.c_str(), 0755);
+#elif defined(_WIN32)
+  ::_mkdir(this->Dir.c_str());
+#endif
+}
+
+bool CompilationCache::getKey(const std::string &Command,
+                              const std::string &Input,
+                              std::string &Key) const {
+  std::string Text;
+  if (!ReadWholeFile(Input, Text))
+    return false;
+  Hasher H;
+  H.update(reinterpret_cast<const char *>(&CompilerHash), sizeof CompilerHash);
+  H.update(Command);
+  // Some outputs have the name of the input in them.
+  H.update(Input);
+  H.update(Text);
+  char Buf[64];
+  std::snprintf(Buf, sizeof Buf, "%016llx-%llx",
+                static_cast<unsigned long long>(H.get()),
+                static_cast<unsigned long long>(Text.size()));
+  Key = Buf;
+  return true;
+}
+
+std::string CompilationCache::getEntryPath(const std::string &Key) const {
+  return Dir + "/" + Key + ".entry";
+}
+
+bool CompilationCache::lookup(const std::string &Key, Entry &E) {
+  std::string Path = getEntryPath(Key);
+  std::ifstream IS(Path, std::ios::binary);
+  std::string Line;
+  if (!std::getline(IS, Line)) {
+    ++NumMisses;
+    return false;
+  }
+  std::istringstream Header(Line);
+  std::string Magic, Version;
+  size_t OutputSize = 0, DiagnosticsSize = 0;
+  Header >> Magic >> Version >> E.Status >> E.HasOutput >> OutputSize >>
+      DiagnosticsSize;
+  // Read the sizes told by the header and require the file to end there.
+  E.Output.resize(OutputSize);
+  E.Diagnostics.resize(DiagnosticsSize);
+  if (!Header || Magic + " " + Version != CacheMagic ||
+      !IS.read(&E.Output[0], OutputSize) ||
+      !IS.read(&E.Diagnostics[0], DiagnosticsSize) ||
+      IS.peek() != std::ifstream::traits_type::eof()) {
+    // A broken entry is a miss, which overwrites it.
+    ++NumMisses;
+    return false;
+  }
+#if defined(SIMPLECC_HAVE_POSIX_FS)
+  // Mark it as recently used.
+  ::utime(Path.c_str(), nullptr);
+#endif
+  ++NumHits;
+  return true;
+}
+
+void CompilationCache::store(const std::string &Key, const Entry &E) {
+  std::string Path = getEntryPath(Key);
+  std::ostringstream TempName;
+  TempName << Path << ".tmp." << std::this_thread::get_id() << "."
+           << NumStores++;
+  {
+    std::ofstream OS(TempName.str(), std::ios::binary);
+    if (!OS)
+      return;
+    OS << CacheMagic << " " << E.Status << " " << E.HasOutput << " "
+       << E.Output.size() << " "
+       << E.Diagnostics.size() << "\n"
+       << E.Output << E.Diagnostics;
+    if (!OS.flush()) {
+      OS.close();
+      std::remove(TempName.str().c_str());
+      return;
+    }
+  }
+  // Windows can't rename over an existing file.
+#if !defined(SIMPLECC_HAVE_POSIX_FS)
+  std::remove(Path.c_str());
+#endif
+  if (std::rename(TempName.str().c_str(), Path.c_str())) {
+    std::remove(TempName.str().c_str());
+    return;
+  }
+  Evict(E.Output.size() + E.Diagnostics.size());
+}
+
+void CompilationCache::Evict(uint64_t AddedSize) {
+#if defined(SIMPLECC_HAVE_POSIX_FS)
+  std::lock_guard<std::mutex> Lock(EvictMutex);
+  // Only scan the directory when the cache may be full.
+  KnownSize += AddedSize;
+  if (HasScanned && KnownSize <= MaxSize)
+    return;
+  HasScanned = true;
+  DIR *D = ::opendir(Dir.c_str());
+  if (!D)
+    return;
+  struct Item {
+    time_t MTime;
+    uint64_t Size;
+    std::string Path;
+  };
+  std::vector<Item> Items;
+  uint64_t Total = 0;
+  static const std::string Suffix = ".entry";
+  while (struct dirent *Ent = ::readdir(D)) {
+    std::string Name(Ent->d_name);
+    if (Name.size() <= Suffix.size() ||
+        Name.compare(Name.size() - Suffix.size(), Suffix.size(), Suffix))
+      continue;
+    std::string Path = Dir + "/" + Name;
+    struct stat St;
+    if (::stat(Path.c_str(), &St))
+      continue;
+    Items.push_back(Item{St.st_mtime, static_cast<uint64_t>(St.st_size),
+                         std::move(Path)});
+    Total += St.st_size;
+  }
+  ::closedir(D);
+  KnownSize = Total;
+  if (Total <= MaxSize)
+    return;
+
+  // Remove the oldest entries until the cache is well below the limit,
+  // so that the next few stores don't scan it again.
+  std::sort(Items.begin(), Items.end(), [](const Item &L, const Item &R) {
+    return L.MTime < R.MTime;
+  });
+  uint64_t Target = MaxSize / 10 * 9;
+  for (const Item &I : Items) {
+    if (Total <= Target)
+      break;
+    if (::unlink(I.Path.c_str()) == 0) {
+      Total -= I.Size;
+      ++NumEvictions;
+    }
+  }
+  KnownSize = Total;
+#else
+  (void)AddedSize;
+#endif
+}
+
+void CompilationCache::PrintStats(std::ostream &O) const {
+  O << "Cache: " << getNumHits() << " hits, " << getNumMisses()
+    << " misses, " << getNumEvictions() << " evictions\n";
+}
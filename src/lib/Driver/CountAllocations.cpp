@@ -0,0 +1,27 @@
+#include "simplecc/Support/TimeReport.h"
+#include <cstdlib>
+#include <new>
+
+// Replace the global operator new of simplecc to count the allocations for
+// the time report. Each thread counts its own, so the cost is one increment
+// of a thread-local.
+
+void *operator new(std::size_t Size) {
+  ++simplecc::NumThreadAllocations;
+  if (Size == 0)
+    Size = 1;
+  for (;;) {
+    if (void *P = std::malloc(Size))
+      return P;
+    std::new_handler Handler = std::get_new_handler();
+    if (!Handler)
+      throw std::bad_alloc();
+    Handler();
+  }
+}
+
+void *operator new[](std::size_t Size) { return ::operator new(Size); }
+void operator delete(void *P) noexcept { std::free(P); }
+void operator delete[](void *P) noexcept { std::free(P); }
+void operator delete(void *P, std::size_t) noexcept { std::free(P); }
+void operator delete[](void *P, std::size_t) noexcept { std::free(P); }
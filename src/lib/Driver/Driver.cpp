@@ -1,13 +1,23 @@
 #include "simplecc/Driver/Driver.h"
+#include "simplecc/Driver/CompilationCache.h"
+#include "simplecc/CodeGen/ByteCodeFile.h"
 #include "simplecc/CodeGen/CodeGen.h"
+#include "simplecc/IR/IR.h"
+#include "simplecc/Interpreter/ByteCodeInterpreter.h"
 #include "simplecc/Lex/Tokenize.h"
 #include "simplecc/Target/Target.h"
 #include "simplecc/Transform/Transform.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <tclap/CmdLine.h>
+#include <unordered_map>
 
 #if SIMPLE_COMPILER_USE_LLVM
 #include "simplecc/LLVM/LLVM.h"
 #include "simplecc/Visualize/Visualize.h"
+#include <llvm/Support/raw_os_ostream.h>
 #endif
 
 using namespace simplecc;
@@ -40,10 +50,13 @@ void Driver::runWriteCSTGraph() {
   auto OS = getLLVMRawOstream();
   if (!OS)
     return;
-  WriteCSTGraph(TheCST.get(), *OS);
+  WriteCSTGraph(TheCST->getRoot(), *OS);
 }
 
 std::unique_ptr<llvm::raw_ostream> Driver::getLLVMRawOstream() {
+  // "-" stands for the stream set by setStdOutput(), which may be captured.
+  if (getOutputFile() == "-")
+    return llvm::make_unique<llvm::raw_os_ostream>(*getStdOstream());
   std::error_code EC;
   auto OS = llvm::make_unique<llvm::raw_fd_ostream>(getOutputFile(), EC);
   if (EC) {
@@ -57,14 +70,18 @@ std::unique_ptr<llvm::raw_ostream> Driver::getLLVMRawOstream() {
 }
 #endif // SIMPLE_COMPILER_USE_LLVM
 
-std::unique_ptr<Node> Driver::runBuildCST() {
-  if (runTokenize())
+std::unique_ptr<ParseTree> Driver::runBuildCST() {
+  auto L = getLexer();
+  if (!L)
     return nullptr;
-  auto CST = BuildCST(getTokens());
+  TimeRegion R(getTimeReport(), "Parse");
+  auto CST = BuildCST(*L);
+  R.addCount("tokens", L->getNumTokens());
   if (!CST) {
     getEM().increaseErrorCount();
     return nullptr;
   }
+  R.addCount("cst-nodes", CST->getNumNodes());
   return CST;
 }
 
@@ -79,6 +96,17 @@ void Driver::runPrintTokens() {
 
 void Driver::runAssembleMips() { runAssemble(); }
 
+void Driver::runAssembleStackMips() { runAssembleByteCode(); }
+
+void Driver::runPrintIR() {
+  if (runLowerToIR())
+    return;
+  auto OS = getStdOstream();
+  if (!OS)
+    return;
+  PrintIR(getIRModule(), *OS);
+}
+
 void Driver::runPrintByteCode() {
   if (runAnalyses())
     return;
@@ -119,6 +147,46 @@ void Driver::runPrintByteCodeModule() {
   Print(*OS, getByteCodeModule());
 }
 
+void Driver::runPrintCFG() {
+  if (runCodeGen())
+    return;
+  auto OS = getStdOstream();
+  if (!OS)
+    return;
+  PrintByteCodeCFG(getByteCodeModule(), *OS);
+}
+
+void Driver::runWriteCFGGraph() {
+  if (runCodeGen())
+    return;
+  auto OS = getStdOstream();
+  if (!OS)
+    return;
+  WriteByteCodeCFGGraph(getByteCodeModule(), *OS);
+}
+
+void Driver::runEmitByteCode() {
+  if (runPeephole())
+    return;
+  auto OS = getStdOstream(/* Binary */ true);
+  if (!OS)
+    return;
+  ByteCodeFile::Write(getByteCodeModule(), *OS);
+}
+
+void Driver::runExecute() {
+  if (runFuse())
+    return;
+  auto OS = getStdOstream();
+  if (!OS)
+    return;
+  TimeRegion R(getTimeReport(), "Run");
+  ByteCodeInterpreter Interp;
+  if (Interp.Run(getByteCodeModule(), getStdInput(), *OS)) {
+    getEM().increaseErrorCount();
+  }
+}
+
 void Driver::runDumpSymbolTable() {
   if (runAnalyses())
     return;
@@ -138,17 +206,386 @@ void Driver::runTransform() {
   PrettyPrintAST(*getProgram(), *OS);
 }
 
+/// Return the suffix of the output file of a command, nullptr if it has none.
+static const char *getOutputSuffix(Driver::CommandKind Cmd) {
+  switch (Cmd) {
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix)                         \
+  case Driver::CommandKind::Name:                                              \
+    return Suffix;
+#include "simplecc/Driver/Driver.def"
+  }
+  assert(false && "Unhandled CommandKind");
+  return nullptr;
+}
+
+/// Return the output file of Input in batch mode, which is Input with its
+/// extension replaced by Suffix, put in OutputDir if it is not empty.
+static std::string getBatchOutputFile(const std::string &Input,
+                                      const std::string &OutputDir,
+                                      const char *Suffix) {
+  auto Slash = Input.find_last_of("/\\");
+  auto Begin = Slash == std::string::npos ? 0 : Slash + 1;
+  auto Dot = Input.find_last_of('.');
+  auto End = Dot == std::string::npos || Dot < Begin ? Input.size() : Dot;
+  if (OutputDir.empty())
+    return Input.substr(0, End) + Suffix;
+  return OutputDir + "/" + Input.substr(Begin, End - Begin) + Suffix;
+}
+
+/// Return the size of a file, or 0 if it cannot be read.
+static size_t getFileSize(const std::string &Filename) {
+  std::ifstream IS(Filename, std::ios::binary | std::ios::ate);
+  return IS ? static_cast<size_t>(IS.tellg()) : 0;
+}
+
+/// Expand the response files in Args, which are named with a leading '@'
+/// and list one input per line. Set HasResponseFile if there is one.
+/// Return true on errors.
+static bool ExpandInputs(const std::vector<std::string> &Args,
+                         std::vector<std::string> &Inputs,
+                         bool &HasResponseFile, ErrorManager &EM) {
+  HasResponseFile = false;
+  for (const std::string &Arg : Args) {
+    if (Arg.empty() || Arg[0] != '@') {
+      Inputs.push_back(Arg);
+      continue;
+    }
+    HasResponseFile = true;
+    std::ifstream IS(Arg.substr(1));
+    if (IS.fail()) {
+      EM.setErrorType("FileReadError");
+      EM.Error(Quote(Arg.substr(1)));
+      return true;
+    }
+    std::string Line;
+    while (std::getline(IS, Line)) {
+      auto Begin = Line.find_first_not_of(" \t\r");
+      if (Begin == std::string::npos)
+        continue;
+      auto End = Line.find_last_not_of(" \t\r");
+      Inputs.push_back(Line.substr(Begin, End - Begin + 1));
+    }
+  }
+  return false;
+}
+
+/// Return the switch of a command.
+static const char *getCommandName(Driver::CommandKind Cmd) {
+  switch (Cmd) {
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix)                         \
+  case Driver::CommandKind::Name:                                              \
+    return Arg;
+#include "simplecc/Driver/Driver.def"
+  }
+  assert(false && "Unhandled CommandKind");
+  return nullptr;
+}
+
+/// Return the command whose switch is Name. Return false if there is none.
+static bool getCommandByName(const std::string &Name, Driver::CommandKind &Cmd) {
+#define HANDLE_COMMAND(CommandName, Arg, Description, Suffix)                  \
+  if (Name == Arg) {                                                           \
+    Cmd = Driver::CommandKind::CommandName;                                    \
+    return true;                                                               \
+  }
+#include "simplecc/Driver/Driver.def"
+  return false;
+}
+
+void Driver::runServe() { ServeRequests(std::cin, std::cout); }
+
+void Driver::ServeRequests(std::istream &In, std::ostream &Out) {
+  std::string Line;
+  while (std::getline(In, Line)) {
+    if (!Line.empty() && Line.back() == '\r')
+      Line.pop_back();
+    std::string Name, Input, Output;
+    if (Line.find('\t') != std::string::npos) {
+      // Tabs allow spaces in the file names.
+      std::istringstream Fields(Line);
+      std::getline(Fields, Name, '\t');
+      std::getline(Fields, Input, '\t');
+      std::getline(Fields, Output, '\t');
+    } else {
+      std::istringstream Fields(Line);
+      Fields >> Name >> Input >> Output;
+    }
+    if (Name.empty())
+      continue;
+    if (Name == "quit")
+      break;
+
+    std::ostringstream Result, Errs;
+    // The requests come from In, so a program run reads nothing.
+    std::istringstream Empty;
+    int Status = 1;
+    {
+      ErrsRedirect Redirect(Errs);
+      CommandKind Cmd;
+      if (!getCommandByName(Name, Cmd) || Cmd == CommandKind::Serve) {
+        PrintErrs("RequestError: unknown command", Quote(Name));
+      } else if (Input.empty() || Input == "-") {
+        PrintErrs("RequestError: an input file is required");
+      } else {
+        setInputFile(Input);
+        setOutputFile(Output.empty() ? "-" : Output);
+        setStdOutput(&Result);
+        setStdInput(&Empty);
+        Status = runCommand(Cmd);
+        // Close the output file before replying.
+        clear();
+      }
+    }
+    std::string ResultStr = Result.str(), ErrsStr = Errs.str();
+    Out << Status << " " << ResultStr.size() << " " << ErrsStr.size() << "\n"
+        << ResultStr << ErrsStr;
+    Out.flush();
+  }
+}
+
+void Driver::DispatchCommand(CommandKind Cmd) {
+  switch (Cmd) {
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix)                         \
+  case CommandKind::Name:                                                      \
+    run##Name();                                                               \
+    break;
+#include "simplecc/Driver/Driver.def"
+  }
+}
+
+int Driver::runCommand(CommandKind Cmd) {
+  TimeRegion R(getTimeReport(), "Total");
+  std::string Key;
+  // The options that change the output are part of the command.
+  std::string Command = getCommandName(Cmd);
+  if (!isPeepholeEnabled())
+    Command += " --no-peephole";
+  else if (isPeepholeReportEnabled())
+    Command += " --peephole-report";
+  if (!isFuseEnabled())
+    Command += " --no-fuse";
+  // The output of a program run depends on its input as well.
+  if (Cache && Cmd != CommandKind::Serve && Cmd != CommandKind::Execute &&
+      getInputFile() != "-" && Cache->getKey(Command, getInputFile(), Key))
+    return runCommandCached(Cmd, Key);
+  DispatchCommand(Cmd);
+  return status();
+}
+
+int Driver::runCommandCached(CommandKind Cmd, const std::string &Key) {
+  CompilationCache::Entry E;
+  bool HasOutput;
+  if (Cache->lookup(Key, E)) {
+    HasOutput = E.HasOutput;
+    if (E.Status)
+      getEM().increaseErrorCount();
+  } else {
+    // Run the command with its output and diagnostics captured.
+    std::ostringstream Output, Diagnostics;
+    std::string OutputFile = getOutputFile();
+    std::ostream *StdOutput = getStdOutput();
+    setOutputFile("-");
+    setStdOutput(&Output);
+    {
+      ErrsRedirect Redirect(Diagnostics);
+      DispatchCommand(Cmd);
+    }
+    setOutputFile(OutputFile);
+    setStdOutput(StdOutput);
+    HasOutput = hasOpenedOutput();
+    E.Status = status();
+    E.HasOutput = HasOutput;
+    E.Output = Output.str();
+    E.Diagnostics = Diagnostics.str();
+    Cache->store(Key, E);
+  }
+
+  // Replay the run.
+  getErrs() << E.Diagnostics;
+  if (HasOutput) {
+    if (std::ostream *OS = getStdOstream())
+      *OS << E.Output;
+  }
+  return status();
+}
+
+int Driver::runBatch(CommandKind Cmd, const std::vector<std::string> &Inputs,
+                     const std::string &OutputDir, unsigned NumThreads,
+                     bool FusedAnalysis, bool TimeReportText) {
+  struct Result {
+    std::string Errs;
+    int Status = 0;
+    size_t NumBytes = 0;
+  };
+  std::vector<Result> Results(Inputs.size());
+  const char *Suffix = getOutputSuffix(Cmd);
+  std::vector<std::string> OutputFiles(Inputs.size());
+  if (Suffix) {
+    // Two inputs writing the same file would overwrite each other.
+    std::unordered_map<std::string, unsigned> Writers;
+    for (unsigned I = 0, E = Inputs.size(); I < E; ++I) {
+      OutputFiles[I] = getBatchOutputFile(Inputs[I], OutputDir, Suffix);
+      auto Pair = Writers.emplace(OutputFiles[I], I);
+      if (!Pair.second) {
+        PrintErrs("BatchError:", Quote(Inputs[Pair.first->second]), "and",
+                  Quote(Inputs[I]), "both write", Quote(OutputFiles[I]));
+        return 1;
+      }
+    }
+  }
+
+  auto Compile = [&](unsigned I) {
+    Result &R = Results[I];
+    // Keep the diagnostics of each input together.
+    std::ostringstream Errs;
+    ErrsRedirect Redirect(Errs);
+    // The inputs run at once cannot share the standard input.
+    std::istringstream Empty;
+    Driver D;
+    D.setCache(Cache);
+    D.setStdInput(&Empty);
+    D.setInputFile(Inputs[I]);
+    // The output is kept until the command succeeds, so that an input that
+    // fails leaves no output file.
+    std::ostringstream Output;
+    D.setOutputFile("-");
+    if (Suffix)
+      D.setStdOutput(&Output);
+    D.setFusedAnalysis(FusedAnalysis);
+    D.setPeephole(isPeepholeEnabled());
+    D.setFuse(isFuseEnabled());
+    D.setPeepholeReport(isPeepholeReportEnabled());
+    if (TimeReportText)
+      D.enableTimeReport();
+    R.Status = D.runCommand(Cmd);
+    if (Suffix && !R.Status && D.hasOpenedOutput()) {
+      std::ofstream OS(OutputFiles[I], std::ios::out | std::ios::binary);
+      OS << Output.str();
+      if (OS.fail()) {
+        D.getEM().setErrorType("FileWriteError");
+        D.getEM().Error(OutputFiles[I]);
+        R.Status = 1;
+      }
+    }
+    // The input is not read on a hit of the cache.
+    R.NumBytes = D.getSource().size();
+    if (!R.NumBytes)
+      R.NumBytes = getFileSize(Inputs[I]);
+    D.PrintTimeReport(TimeReportText, "");
+    R.Errs = Errs.str();
+  };
+
+  using Clock = std::chrono::steady_clock;
+  auto Start = Clock::now();
+  if (NumThreads == 0)
+    NumThreads = ThreadPool::getHardwareConcurrency();
+  if (NumThreads > 1) {
+    ThreadPool Pool(NumThreads);
+    for (unsigned I = 0, E = Inputs.size(); I < E; ++I)
+      Pool.async([&Compile, I]() { Compile(I); });
+    Pool.wait();
+  } else {
+    for (unsigned I = 0, E = Inputs.size(); I < E; ++I)
+      Compile(I);
+  }
+  std::chrono::duration<double> Elapsed = Clock::now() - Start;
+
+  unsigned NumFailed = 0;
+  size_t NumBytes = 0;
+  std::ostream &Errs = getErrs();
+  for (unsigned I = 0, E = Inputs.size(); I < E; ++I) {
+    if (!Results[I].Errs.empty())
+      Errs << Inputs[I] << ":\n" << Results[I].Errs;
+    if (Results[I].Status)
+      ++NumFailed;
+    NumBytes += Results[I].NumBytes;
+  }
+  double Seconds = std::max(Elapsed.count(), 1e-9);
+  Errs << "Compiled " << Inputs.size() << " inputs (" << NumFailed
+       << " failed, " << NumBytes << " bytes) in " << std::fixed
+       << std::setprecision(3) << Seconds << " s: " << std::setprecision(1)
+       << Inputs.size() / Seconds << " inputs/s, " << std::setprecision(2)
+       << NumBytes / Seconds / (1024 * 1024) << " MB/s\n";
+  return NumFailed != 0;
+}
+
+void Driver::PrintTimeReport(bool Text, const std::string &JSONFile) {
+  const TimeReport *Report = getTimeReport();
+  if (!Report)
+    return;
+  if (Text)
+    Report->PrintText(getErrs());
+  if (JSONFile.empty())
+    return;
+  if (JSONFile == "-") {
+    Report->PrintJSON(std::cout);
+    return;
+  }
+  std::ofstream OS(JSONFile);
+  if (OS.fail()) {
+    getEM().setErrorType("FileWriteError");
+    getEM().Error(JSONFile);
+    return;
+  }
+  Report->PrintJSON(OS);
+}
+
 int Driver::run(int argc, char **argv) {
   namespace tclap = TCLAP;
   tclap::CmdLine Parser("A simple yet modular C-like compiler", ' ', "3.0");
   std::vector<tclap::Arg *> Switches;
-  tclap::UnlabeledValueArg<std::string> InputArg(
-      "input", "input file (default to stdin)", false, "", "input-file", Parser);
+  tclap::UnlabeledMultiArg<std::string> InputArg(
+      "input",
+      "input files (default to stdin). Many inputs or a response file "
+      "@file listing one input per line are compiled in batch mode",
+      false, "input-file", Parser);
   tclap::ValueArg<std::string> OutputArg("o", "output",
                                          "output file (default to stdout)",
                                          false, "", "output-file", Parser);
+  tclap::SwitchArg NoFusedAnalysisArg(
+      "", "no-fused-analysis", "run each semantic analysis as a separate pass",
+      Parser, false);
+  tclap::SwitchArg NoPeepholeArg(
+      "", "no-peephole", "do not remove redundant byte code", Parser, false);
+  tclap::SwitchArg PeepholeReportArg(
+      "", "peephole-report",
+      "print the byte code count of each function before and after the "
+      "peephole pass to stderr",
+      Parser, false);
+  tclap::SwitchArg NoFuseArg(
+      "", "no-fuse",
+      "do not fuse the byte code into superinstructions for --stack-asm and "
+      "--run",
+      Parser, false);
+  tclap::ValueArg<unsigned> JobsArg(
+      "j", "jobs",
+      "analyze and compile the functions on N threads (0 for all cores)",
+      false, 1, "N", Parser);
+  tclap::SwitchArg TimeReportArg(
+      "", "time-report",
+      "print the time, memory and item counts of each phase to stderr",
+      Parser, false);
+  tclap::ValueArg<std::string> TimeReportJSONArg(
+      "", "time-report-json",
+      "write the time report as JSON to a file (- for stdout)", false, "",
+      "file", Parser);
+  tclap::ValueArg<std::string> CacheDirArg(
+      "", "cache-dir",
+      "reuse the results of earlier runs on the same input from a cache in dir",
+      false, "", "dir", Parser);
+  tclap::ValueArg<unsigned> CacheSizeArg(
+      "", "cache-size", "limit of the size of the cache in MB (default 1024)",
+      false, 1024, "MB", Parser);
+  tclap::SwitchArg CacheStatsArg(
+      "", "cache-stats", "print the hits and misses of the cache to stderr",
+      Parser, false);
+  tclap::ValueArg<std::string> OutputDirArg(
+      "", "output-dir",
+      "directory of the output files in batch mode (default to that of "
+      "each input)",
+      false, "", "dir", Parser);
 
-#define HANDLE_COMMAND(Name, Arg, Description)                                 \
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix)                         \
   tclap::SwitchArg Name##Switch("", Arg, Description, false);                  \
   Switches.push_back(&Name##Switch);
 #include "simplecc/Driver/Driver.def"
@@ -160,14 +597,67 @@ int Driver::run(int argc, char **argv) {
     PrintErrs(Exc.error(), "at argument", Exc.argId());
     return 1;
   }
-  setInputFile(InputArg.isSet() ? InputArg.getValue() : "-");
-  setOutputFile(OutputArg.isSet() ? OutputArg.getValue() : "-");
 
-#define HANDLE_COMMAND(Name, Arg, Description)                                 \
-  if (Name##Switch.isSet()) {                                                  \
-    run##Name();                                                               \
-    return status();                                                           \
-  }
+  CommandKind Cmd;
+#define HANDLE_COMMAND(Name, Arg, Description, Suffix)                         \
+  if (Name##Switch.isSet())                                                    \
+    Cmd = CommandKind::Name;                                                   \
+  else
 #include "simplecc/Driver/Driver.def"
-  assert(false && "Unhandled command line switch!");
+    assert(false && "Unhandled command line switch!");
+
+  std::unique_ptr<CompilationCache> TheCache;
+  if (CacheDirArg.isSet()) {
+    TheCache.reset(new CompilationCache(
+        CacheDirArg.getValue(), uint64_t(CacheSizeArg.getValue()) << 20));
+    setCache(TheCache.get());
+  }
+  auto PrintCacheStats = [&TheCache, &CacheStatsArg]() {
+    if (TheCache && CacheStatsArg.getValue())
+      TheCache->PrintStats(getErrs());
+  };
+
+  setPeephole(!NoPeepholeArg.getValue());
+  setFuse(!NoFuseArg.getValue());
+  setPeepholeReport(PeepholeReportArg.getValue());
+  if (Cmd == CommandKind::Serve) {
+    setFusedAnalysis(!NoFusedAnalysisArg.getValue());
+    setNumThreads(JobsArg.getValue());
+    runServe();
+    PrintCacheStats();
+    return 0;
+  }
+
+  std::vector<std::string> Inputs;
+  bool HasResponseFile;
+  if (ExpandInputs(InputArg.getValue(), Inputs, HasResponseFile, getEM()))
+    return status();
+  if (Inputs.size() > 1 || HasResponseFile) {
+    if (OutputArg.isSet()) {
+      PrintErrs("-o cannot be used with many inputs, use --output-dir");
+      return 1;
+    }
+    if (TimeReportJSONArg.isSet()) {
+      PrintErrs("--time-report-json cannot be used with many inputs, use "
+                "--time-report");
+      return 1;
+    }
+    int Status = runBatch(Cmd, Inputs, OutputDirArg.getValue(),
+                          JobsArg.getValue(), !NoFusedAnalysisArg.getValue(),
+                          TimeReportArg.getValue());
+    PrintCacheStats();
+    return Status;
+  }
+
+  setInputFile(Inputs.empty() ? "-" : Inputs.front());
+  setOutputFile(OutputArg.isSet() ? OutputArg.getValue() : "-");
+  setFusedAnalysis(!NoFusedAnalysisArg.getValue());
+  setNumThreads(JobsArg.getValue());
+  if (TimeReportArg.getValue() || TimeReportJSONArg.isSet())
+    enableTimeReport();
+
+  int Status = runCommand(Cmd);
+  PrintTimeReport(TimeReportArg.getValue(), TimeReportJSONArg.getValue());
+  PrintCacheStats();
+  return Status ? Status : status();
 }
\ No newline at end of file
@@ -1,15 +1,46 @@
 #include "simplecc/Driver/DriverBase.h"
+#include "simplecc/CodeGen/ByteCodeFile.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
 #include "simplecc/Lex/Tokenize.h"
 #include "simplecc/CodeGen/CodeGen.h"
+#include "simplecc/IR/IR.h"
 #include "simplecc/Target/Target.h"
 #include "simplecc/Transform/Transform.h"
+#include <algorithm>
+#include <streambuf>
 
 using namespace simplecc;
 
-std::ostream *DriverBase::getStdOstream() {
+namespace {
+/// A streambuf that passes everything to another and counts the lines.
+class LineCountingBuffer : public std::streambuf {
+  std::streambuf *Dest;
+  size_t NumLines = 0;
+
+protected:
+  int overflow(int C) override {
+    if (C == '\n')
+      ++NumLines;
+    return C == traits_type::eof() ? traits_type::not_eof(C) : Dest->sputc(C);
+  }
+  std::streamsize xsputn(const char *S, std::streamsize N) override {
+    NumLines += std::count(S, S + N, '\n');
+    return Dest->sputn(S, N);
+  }
+  int sync() override { return Dest->pubsync(); }
+
+public:
+  explicit LineCountingBuffer(std::streambuf *Dest) : Dest(Dest) {}
+  size_t getNumLines() const { return NumLines; }
+};
+} // namespace
+
+std::ostream *DriverBase::getStdOstream(bool Binary) {
+  OpenedOutput = true;
   if (OutputFile == "-")
-    return &std::cout;
-  StdOFStream.open(OutputFile);
+    return StdOutput;
+  StdOFStream.open(OutputFile, Binary ? std::ios::out | std::ios::binary
+                                      : std::ios::out);
   if (StdOFStream.fail()) {
     EM.setErrorType("FileWriteError");
     EM.Error(OutputFile);
@@ -18,55 +49,159 @@ std::ostream *DriverBase::getStdOstream() {
   return &StdOFStream;
 }
 
-std::istream *DriverBase::getStdIstream() {
+std::unique_ptr<Lexer> DriverBase::getLexer() {
   if (InputFile == "-")
-    return &std::cin;
-  StdIFStream.open(InputFile);
-  if (StdIFStream.fail()) {
+    return std::unique_ptr<Lexer>(new Lexer(TheSource, std::cin));
+  if (TheSource.ReadFile(InputFile)) {
     EM.setErrorType("FileReadError");
     EM.Error(Quote(InputFile));
     return nullptr;
   }
-  return &StdIFStream;
+  return std::unique_ptr<Lexer>(new Lexer(TheSource));
 }
 
-void DriverBase::doTokenize(std::istream &IS) {
-  Tokenize(IS, TheTokens);
+void DriverBase::doTokenize(Lexer &L) {
+  TimeRegion R(getTimeReport(), "Tokenize");
+  Tokenize(L, TheTokens);
+  R.addCount("tokens", TheTokens.size());
 }
 
-bool DriverBase::doParse() {
-  TheProgram = BuildAST(getInputFile(), TheTokens);
-  return !TheProgram;
+bool DriverBase::doParse(Lexer &L) {
+  TimeRegion R(getTimeReport(), "Parse");
+  size_t NumCSTNodes = 0;
+  TheProgram = BuildAST(getInputFile(), L, &NumCSTNodes);
+  R.addCount("tokens", L.getNumTokens());
+  if (!TheProgram)
+    return true;
+  R.addCount("cst-nodes", NumCSTNodes);
+  R.addCount("ast-nodes", TheProgram->getContext().getNumNodes());
+  return false;
 }
 
 bool DriverBase::doAnalyses() {
+  TimeRegion R(getTimeReport(), "Analyses");
   return AM.runAllAnalyses(TheProgram.get());
 }
 
 void DriverBase::doCodeGen() {
-  CompileToByteCode(TheProgram.get(), AM.getSymbolTable(), TheModule);
+  TimeRegion R(getTimeReport(), "CodeGen");
+  if (ThePool) {
+    CompileToByteCode(TheProgram.get(), AM.getSymbolTable(), TheModule,
+                      *ThePool);
+  } else {
+    CompileToByteCode(TheProgram.get(), AM.getSymbolTable(), TheModule);
+  }
+  if (!Report)
+    return;
+  size_t NumByteCodes = 0;
+  for (const ByteCodeFunction *Fn : TheModule)
+    NumByteCodes += Fn->size();
+  R.addCount("functions", TheModule.size());
+  R.addCount("bytecodes", NumByteCodes);
+}
+
+bool DriverBase::doLoadByteCode() {
+  TimeRegion R(getTimeReport(), "LoadByteCode");
+  ByteCodeFile File;
+  if (File.Open(InputFile) || File.Load(TheModule))
+    return true;
+  R.addCount("functions", File.getNumFunctions());
+  R.addCount("bytecodes", File.getHeader().NumCodes);
+  return false;
+}
+
+void DriverBase::doPeephole() {
+  TimeRegion R(getTimeReport(), "Peephole");
+  unsigned NumRemoved =
+      OptimizeByteCode(TheModule, PeepholeReport ? &getErrs() : nullptr);
+  if (Report)
+    R.addCount("bytecodes removed", NumRemoved);
+}
+
+void DriverBase::doFuse() {
+  TimeRegion R(getTimeReport(), "Fuse");
+  unsigned NumFused = FuseByteCode(TheModule);
+  if (Report)
+    R.addCount("superinstructions", NumFused);
+}
+
+bool DriverBase::doLowerToIR() {
+  TimeRegion R(getTimeReport(), "LowerToIR");
+  if (LowerToIR(TheModule, TheIR))
+    return true;
+  if (!Report)
+    return false;
+  size_t NumBlocks = 0, NumInstructions = 0;
+  for (const auto &Fn : TheIR.getFunctionList()) {
+    NumBlocks += Fn->getNumBlocks();
+    NumInstructions += Fn->getNumInstructions();
+  }
+  R.addCount("blocks", NumBlocks);
+  R.addCount("instructions", NumInstructions);
+  return false;
+}
+
+void DriverBase::doAssemble(std::ostream &OS, bool FromByteCode) {
+  TimeRegion R(getTimeReport(), "Assemble");
+  auto Assemble = [this, FromByteCode](std::ostream &O) {
+    if (FromByteCode) {
+      if (ThePool)
+        AssembleMips(TheModule, O, *ThePool);
+      else
+        AssembleMips(TheModule, O);
+      return;
+    }
+    if (ThePool)
+      AssembleMips(TheIR, O, *ThePool);
+    else
+      AssembleMips(TheIR, O);
+  };
+  if (!Report) {
+    Assemble(OS);
+    return;
+  }
+  // Count the lines as they are written.
+  LineCountingBuffer Counter(OS.rdbuf());
+  std::ostream CountingOS(&Counter);
+  Assemble(CountingOS);
+  CountingOS.flush();
+  R.addCount("lines", Counter.getNumLines());
+}
+
+void DriverBase::setNumThreads(unsigned NumThreads) {
+  if (NumThreads == 0)
+    NumThreads = ThreadPool::getHardwareConcurrency();
+  if (NumThreads > 1)
+    ThePool.reset(new ThreadPool(NumThreads));
+  else
+    ThePool.reset();
+  AM.setThreadPool(ThePool.get());
 }
 
-void DriverBase::doAssemble(std::ostream &OS) {
-  AssembleMips(TheModule, OS);
+void DriverBase::enableTimeReport() {
+  Report.reset(new TimeReport());
+  AM.setTimeReport(Report.get());
 }
 
 void DriverBase::doTransform() {
-  TransformProgram(TheProgram.get(), AM.getSymbolTable());
+  TimeRegion R(getTimeReport(), "Transform");
+  TransformProgram(TheProgram.get(), AM.getSymbolTable(), getTimeReport());
+  R.addCount("ast-nodes", TheProgram->getContext().getNumNodes());
 }
 
 bool DriverBase::runTokenize() {
-  auto IS = getStdIstream();
-  if (!IS)
+  auto L = getLexer();
+  if (!L)
     return true;
-  doTokenize(*IS);
+  doTokenize(*L);
   return false;
 }
 
 bool DriverBase::runParse() {
-  if (runTokenize())
+  auto L = getLexer();
+  if (!L)
     return true;
-  if (doParse()) {
+  if (doParse(*L)) {
     EM.increaseErrorCount();
     return true;
   }
@@ -91,30 +226,81 @@ bool DriverBase::runTransform() {
 }
 
 bool DriverBase::runCodeGen() {
+  if (InputFile != "-" && ByteCodeFile::IsByteCodeFile(InputFile)) {
+    if (doLoadByteCode()) {
+      EM.increaseErrorCount();
+      return true;
+    }
+    LoadedByteCode = true;
+    return false;
+  }
   if (runTransform())
     return true;
   doCodeGen();
   return false;
 }
 
+bool DriverBase::runPeephole() {
+  if (runCodeGen())
+    return true;
+  if (Peephole && !LoadedByteCode)
+    doPeephole();
+  return false;
+}
+
+bool DriverBase::runFuse() {
+  if (runPeephole())
+    return true;
+  if (Fuse)
+    doFuse();
+  return false;
+}
+
+bool DriverBase::runLowerToIR() {
+  if (runPeephole())
+    return true;
+  if (doLowerToIR()) {
+    EM.increaseErrorCount();
+    return true;
+  }
+  return false;
+}
+
 bool DriverBase::runAssemble() {
   auto OS = getStdOstream();
   if (!OS)
     return true;
-  if (runCodeGen())
+  if (runLowerToIR())
     return true;
   doAssemble(*OS);
   return false;
 }
 
+bool DriverBase::runAssembleByteCode() {
+  auto OS = getStdOstream();
+  if (!OS)
+    return true;
+  if (runFuse())
+    return true;
+  doAssemble(*OS, /* FromByteCode */ true);
+  return false;
+}
+
 void DriverBase::clear() {
   InputFile.clear();
   OutputFile.clear();
-  StdIFStream.clear();
+  if (StdOFStream.is_open())
+    StdOFStream.close();
   StdOFStream.clear();
+  OpenedOutput = false;
+  LoadedByteCode = false;
   TheTokens.clear();
+  TheSource.clear();
   AM.clear();
-  TheProgram.release();
+  TheProgram.reset();
   TheModule.clear();
+  TheIR.clear();
   EM.clear();
+  if (Report)
+    Report->clear();
 }
\ No newline at end of file
@@ -102,7 +102,7 @@ Value *LLVMIRCompiler::visitName(NameExpr *N) {
   }
   // This is a variable so **load** it.
   if (!llvm::isa<llvm::ConstantInt>(Val)) {
-    return Builder.CreateLoad(Val, N->getName());
+    return Builder.CreateLoad(Val, N->getName().str());
   }
   return Val;
 }
@@ -366,7 +366,7 @@ void LLVMIRCompiler::visitFuncDef(FuncDef *FD) {
   /// Create function, fixing return type of main() to int.
   /// We choose to alter the AST since otherwise the AST will
   /// disagree with IR.
-  if (FD->getName() == "main") {
+  if (FD->getName().str() == "main") {
     FD->setReturnType(BasicTypeKind::Int);
   }
   /// A note about linkage:
@@ -376,7 +376,7 @@ void LLVMIRCompiler::visitFuncDef(FuncDef *FD) {
   Function *TheFunction = Function::Create(
       /* FunctionType */ VM.getTypeFromFuncDef(FD),
       /* Linkage */ Function::ExternalLinkage,
-      /* NameExpr */ FD->getName(),
+      /* NameExpr */ FD->getName().str(),
       /* Module */ &TheModule);
   GlobalValues.emplace(FD->getName(), TheFunction);
 
@@ -387,10 +387,10 @@ void LLVMIRCompiler::visitFuncDef(FuncDef *FD) {
   /// Setup arguments.
   for (llvm::Argument &Val : TheFunction->args()) {
     auto *V = FD->getArgAt(Val.getArgNo());
-    Val.setName(V->getName());
+    Val.setName(V->getName().str());
     /// Argument is never array.
-    auto Ptr =
-        Builder.CreateAlloca(VM.getType(V->getType()), nullptr, V->getName());
+    auto Ptr = Builder.CreateAlloca(VM.getType(V->getType()), nullptr,
+                                    V->getName().str());
     /// Store the initial value of an argument.
     Builder.CreateStore(&Val, Ptr);
     LocalValues.emplace(V->getName(), Ptr);
@@ -413,7 +413,7 @@ void LLVMIRCompiler::visitFuncDef(FuncDef *FD) {
       /// inbound [i32 x 2], [i32 x 2]* %1, i32 0, i32 <index> which is
       /// *verbose*, but consistent.
       auto Alloca = Builder.CreateAlloca(VM.getTypeFromVarDecl(VD),
-          /* Size */ nullptr, VD->getName());
+          /* Size */ nullptr, VD->getName().str());
       LocalValues.emplace(VD->getName(), Alloca);
     } else if (auto CD = subclass_cast<ConstDecl>(D)) {
       LocalValues.emplace(CD->getName(),
@@ -423,8 +423,7 @@ void LLVMIRCompiler::visitFuncDef(FuncDef *FD) {
 
   /// Populate LocalValues with global objects.
   LocalSymbolTable Local = TheTable.getLocalTable(FD);
-  for (auto &&Pair : Local) {
-    const SymbolEntry &E = Pair.second;
+  for (const SymbolEntry &E : Local) {
     if (E.IsLocal()) {
       assert(LocalValues.count(E.getName()) &&
           "Local DeclAST must have been handled");
@@ -475,7 +474,7 @@ void LLVMIRCompiler::visitConstDecl(ConstDecl *CD) {
       /* IsConstant */ true,
       /* Linkage */ GlobalVariable::ExternalLinkage,
       /* Initializer */ VM.getConstantFromExpr(CD->getValue()),
-      /* NameExpr */ CD->getName());
+      /* NameExpr */ CD->getName().str());
   GlobalValues.emplace(CD->getName(), GV);
 }
 
@@ -487,7 +486,7 @@ void LLVMIRCompiler::visitVarDecl(VarDecl *VD) {
       /* IsConstant */ false,
       /* Linkage */ GlobalVariable::ExternalLinkage,
       /* Initializer */ VM.getGlobalInitializer(VD),
-      /* NameExpr */ VD->getName());
+      /* NameExpr */ VD->getName().str());
   GlobalValues.emplace(VD->getName(), GV);
 }
 
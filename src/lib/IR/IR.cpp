@@ -0,0 +1,11 @@
+#include "simplecc/IR/IR.h"
+#include "simplecc/IR/IRLowering.h"
+#include "simplecc/IR/IRModule.h"
+
+namespace simplecc {
+bool LowerToIR(const ByteCodeModule &M, IRModule &IR) {
+  return IRLowering().Lower(M, IR);
+}
+
+void PrintIR(const IRModule &IR, std::ostream &O) { O << IR; }
+} // namespace simplecc
@@ -0,0 +1,72 @@
+#include "simplecc/IR/IRFunction.h"
+
+using namespace simplecc;
+
+size_t IRFunction::getNumInstructions() const {
+  size_t N = 0;
+  for (const IRBasicBlock &BB : Blocks)
+    N += BB.size();
+  return N;
+}
+
+bool IRFunction::removeUnreachableBlocks() {
+  std::vector<bool> Reached(Blocks.size(), false);
+  std::vector<unsigned> WorkList{0};
+  Reached[0] = true;
+  while (!WorkList.empty()) {
+    unsigned B = WorkList.back();
+    WorkList.pop_back();
+    const IRBasicBlock &BB = Blocks[B];
+    for (unsigned I = 0, E = BB.getNumSuccessors(); I < E; ++I) {
+      unsigned S = BB.getSuccessor(I);
+      if (!Reached[S]) {
+        Reached[S] = true;
+        WorkList.push_back(S);
+      }
+    }
+  }
+
+  // Number the reached blocks in their order.
+  std::vector<unsigned> NewIndex(Blocks.size());
+  unsigned N = 0;
+  for (unsigned B = 0, E = getNumBlocks(); B < E; ++B) {
+    if (Reached[B])
+      NewIndex[B] = N++;
+  }
+  if (N == Blocks.size())
+    return false;
+
+  BlockListTy Kept;
+  Kept.reserve(N);
+  for (unsigned B = 0, E = getNumBlocks(); B < E; ++B) {
+    if (!Reached[B])
+      continue;
+    Kept.push_back(std::move(Blocks[B]));
+    IRInstruction &Term = Kept.back().getTerminator();
+    for (unsigned I = 0, E = Term.getNumTargets(); I < E; ++I)
+      Term.setTarget(I, NewIndex[Term.getTarget(I)]);
+  }
+  Blocks.swap(Kept);
+  return true;
+}
+
+void IRFunction::Format(std::ostream &O) const {
+  O << "function " << Name << "(";
+  for (unsigned I = 0; I < NumArguments; ++I)
+    O << (I ? ", " : "") << "%" << I;
+  O << "):\n";
+
+  // The registers of the variables.
+  for (unsigned I = 0, E = getNumRegisters(); I < E; ++I) {
+    if (!RegisterNames[I].empty())
+      O << "  ; %" << I << " = " << RegisterNames[I] << "\n";
+  }
+  for (const LocalArray &A : Arrays)
+    O << "  ; " << A.Name << "[" << A.Size << "]\n";
+
+  for (unsigned B = 0, E = getNumBlocks(); B < E; ++B) {
+    O << "B" << B << ":\n";
+    for (const IRInstruction &I : Blocks[B])
+      O << "  " << I << "\n";
+  }
+}
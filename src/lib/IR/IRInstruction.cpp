@@ -0,0 +1,155 @@
+#include "simplecc/IR/IRInstruction.h"
+
+using namespace simplecc;
+
+constexpr unsigned IRInstruction::NoRegister;
+
+void IROperand::Format(std::ostream &O) const {
+  switch (K) {
+  case None:
+    O << "none";
+    break;
+  case Register:
+    O << "%" << Value;
+    break;
+  case Immediate:
+    O << Value;
+    break;
+  }
+}
+
+IRInstruction IRInstruction::Create(Opcode Op, unsigned Dest, IROperand A,
+                                    IROperand B, IROperand C) {
+  assert(Op != Call && !IsTerminator(Op) && "use the other Create()'s!");
+  IRInstruction I(Op, Dest);
+  I.Operands[0] = A;
+  I.Operands[1] = B;
+  I.Operands[2] = C;
+  I.NumOperands = C.IsNone() ? B.IsNone() ? A.IsNone() ? 0 : 1 : 2 : 3;
+  return I;
+}
+
+IRInstruction IRInstruction::Create(Opcode Op, unsigned Dest, Identifier Name,
+                                    IROperand A) {
+  IRInstruction I = Create(Op, Dest, A);
+  I.Name = Name;
+  return I;
+}
+
+IRInstruction IRInstruction::CreateCall(unsigned Dest, Identifier Name,
+                                        std::vector<IROperand> Args) {
+  IRInstruction I(Call, Dest);
+  I.Name = Name;
+  I.Arguments = std::move(Args);
+  return I;
+}
+
+IRInstruction IRInstruction::CreateJump(unsigned Target) {
+  IRInstruction I(Jump);
+  I.Targets[0] = Target;
+  return I;
+}
+
+IRInstruction IRInstruction::CreateBranch(Condition Cond, IROperand A,
+                                          IROperand B, unsigned True,
+                                          unsigned False) {
+  IRInstruction I(Branch);
+  I.Cond = Cond;
+  I.Operands[0] = A;
+  I.Operands[1] = B;
+  I.NumOperands = 2;
+  I.Targets[0] = True;
+  I.Targets[1] = False;
+  return I;
+}
+
+IRInstruction IRInstruction::CreateReturn(IROperand A) {
+  IRInstruction I(Return);
+  I.Operands[0] = A;
+  I.NumOperands = A.IsNone() ? 0 : 1;
+  return I;
+}
+
+const char *IRInstruction::getOpcodeName(Opcode Op) {
+  switch (Op) {
+#define HANDLE_IR_OPCODE(Name, Str)                                            \
+  case Name:                                                                   \
+    return Str;
+#include "simplecc/IR/IROpcode.def"
+  }
+  assert(false && "Unhandled Opcode");
+  return nullptr;
+}
+
+bool IRInstruction::HasSideEffect() const {
+  switch (Op) {
+  case Copy:
+  case Add:
+  case Sub:
+  case Mul:
+  case Neg:
+  case LoadGlobal:
+  case LocalAddress:
+  case GlobalAddress:
+  case LoadElement:
+    return false;
+  default:
+    // A Div may trap on zero.
+    return true;
+  }
+}
+
+const char *IRInstruction::getConditionName(Condition Cond) {
+  static const char *const Names[] = {"eq", "ne", "gt", "ge", "lt", "le"};
+  return Names[Cond];
+}
+
+IRInstruction::Condition IRInstruction::getInverse(Condition Cond) {
+  static const Condition Inverses[] = {NE, EQ, LE, LT, GE, GT};
+  return Inverses[Cond];
+}
+
+IRInstruction::Condition IRInstruction::getSwapped(Condition Cond) {
+  static const Condition Swapped[] = {EQ, NE, LT, LE, GT, GE};
+  return Swapped[Cond];
+}
+
+bool IRInstruction::Evaluate(Condition Cond, int A, int B) {
+  switch (Cond) {
+  case EQ:
+    return A == B;
+  case NE:
+    return A != B;
+  case GT:
+    return A > B;
+  case GE:
+    return A >= B;
+  case LT:
+    return A < B;
+  case LE:
+    return A <= B;
+  }
+  assert(false && "Unhandled Condition");
+  return false;
+}
+
+void IRInstruction::Format(std::ostream &O) const {
+  if (HasDest())
+    O << "%" << Dest << " = ";
+  O << getOpcodeName();
+  if (Op == Branch)
+    O << " " << getConditionName(Cond);
+  const char *Sep = " ";
+  if (!Name.empty()) {
+    O << Sep << Name;
+    Sep = ", ";
+  }
+  for (unsigned I = 0, E = getNumOperands(); I < E; ++I) {
+    O << Sep << getOperand(I);
+    Sep = ", ";
+  }
+  for (unsigned I = 0, E = getNumTargets(); I < E; ++I) {
+    O << Sep << "B" << getTarget(I);
+    Sep = ", ";
+  }
+}
@@ -0,0 +1,342 @@
+#include "simplecc/IR/IRLowering.h"
+#include "simplecc/Analysis/Types.h" // SymbolEntry
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/IR/IRModule.h"
+
+using namespace simplecc;
+
+IRLowering::IRLowering() { EM.setErrorType("LoweringError"); }
+
+bool IRLowering::Lower(const ByteCodeModule &M, IRModule &IR) {
+  EM.clear();
+  IR.clear();
+  Globals.clear();
+  for (const SymbolEntry &E : M.getGlobalVariables()) {
+    bool IsArray = E.IsArray();
+    Globals.emplace(E.getName(), IsArray);
+    IR.addGlobalVariable(E.getName(), IsArray ? E.AsArray().getSize() : 0);
+  }
+  const std::vector<std::string> &Strings = M.getStringLiterals();
+  for (unsigned I = 0, E = Strings.size(); I < E; ++I)
+    IR.setStringLiteral(I, Strings[I]);
+
+  for (const ByteCodeFunction *Fn : M) {
+    IRFunction *F = IR.createFunction(Fn->getName(),
+                                      Fn->getFormalArgumentCount());
+    if (LowerFunction(*Fn, *F))
+      return true;
+  }
+  return false;
+}
+
+void IRLowering::append(IRInstruction I) {
+  TheFunction->getBlock(CurrentBlock).append(std::move(I));
+}
+
+IROperand IRLowering::pop() {
+  IROperand Top = Stack.back();
+  Stack.pop_back();
+  return Top;
+}
+
+void IRLowering::materialize(unsigned Reg) {
+  IROperand Var = IROperand::CreateRegister(Reg);
+  for (IROperand &Op : Stack) {
+    if (Op != Var)
+      continue;
+    unsigned Temp = TheFunction->createRegister();
+    append(IRInstruction::Create(IRInstruction::Copy, Temp, Var));
+    Op = IROperand::CreateRegister(Temp);
+  }
+}
+
+bool IRLowering::LowerFunction(const ByteCodeFunction &Fn, IRFunction &F) {
+  TheFunction = &F;
+  Locals.clear();
+  Stack.clear();
+  for (const SymbolEntry &Arg : Fn.getFormalArguments())
+    Locals.emplace(Arg.getName(),
+                   std::make_pair(F.createRegister(Arg.getName()), false));
+  for (const SymbolEntry &Var : Fn.getLocalVariables()) {
+    if (Var.IsArray()) {
+      F.addLocalArray(Var.getName(), Var.AsArray().getSize());
+      Locals.emplace(Var.getName(), std::make_pair(0U, true));
+      continue;
+    }
+    Locals.emplace(Var.getName(),
+                   std::make_pair(F.createRegister(Var.getName()), false));
+  }
+  NumVariables = F.getNumRegisters();
+
+  unsigned Size = Fn.size();
+  for (const ByteCode &C : Fn) {
+    if (C.IsSuperinstruction() || (C.IsJump() && C.getJumpTarget() > Size)) {
+      EM.Error("invalid", C.getOpcodeName(), "in", Quote(Fn.getName().str()));
+      return true;
+    }
+  }
+  // Each block of the CFG becomes an IR block, and the end of the code,
+  // where the function returns, the last one.
+  TheCFG.Compute(Fn);
+  BlockAt.assign(Size + 1, 0);
+  for (const ByteCodeCFG::BasicBlock &BB : TheCFG)
+    BlockAt[BB.Begin] = F.createBlock();
+  BlockAt[Size] = F.createBlock();
+
+  auto EndBlock = [&](unsigned Offset) {
+    if (!Stack.empty()) {
+      EM.Error("operand stack not empty at offset", Offset, "in",
+               Quote(Fn.getName().str()));
+      return true;
+    }
+    if (!F.getBlock(CurrentBlock).HasTerminator())
+      append(IRInstruction::CreateJump(getBlockAt(Offset)));
+    return false;
+  };
+
+  CurrentBlock = 0;
+  for (const ByteCodeCFG::BasicBlock &BB : TheCFG) {
+    if (BB.Begin) {
+      if (EndBlock(BB.Begin))
+        return true;
+      CurrentBlock = getBlockAt(BB.Begin);
+    }
+    for (unsigned I = BB.Begin; I < BB.End; ++I) {
+      if (LowerByteCode(Fn.getByteCodeAt(I), I))
+        return true;
+    }
+  }
+  if (EndBlock(Size))
+    return true;
+  CurrentBlock = getBlockAt(Size);
+  append(IRInstruction::CreateReturn());
+
+  F.removeUnreachableBlocks();
+  return false;
+}
+
+bool IRLowering::LowerByteCode(const ByteCode &C, unsigned Offset) {
+  using IR = IRInstruction;
+  auto Invalid = [&]() {
+    EM.Error("invalid", C.getOpcodeName(), "in",
+             Quote(TheFunction->getName().str()));
+    return true;
+  };
+  // Check the operand stack has N operands.
+  auto Has = [this](unsigned N) { return Stack.size() >= N; };
+  auto Push = [this](unsigned Reg) {
+    Stack.push_back(IROperand::CreateRegister(Reg));
+  };
+  auto NewTemp = [this]() { return TheFunction->createRegister(); };
+
+  switch (C.getOpcode()) {
+  case ByteCode::LOAD_LOCAL: {
+    auto Iter = Locals.find(C.getStrOperand());
+    if (Iter == Locals.end())
+      return Invalid();
+    if (!Iter->second.second) {
+      Push(Iter->second.first);
+      return false;
+    }
+    unsigned Temp = NewTemp();
+    append(IR::Create(IR::LocalAddress, Temp, C.getStrOperand()));
+    Push(Temp);
+    return false;
+  }
+  case ByteCode::LOAD_GLOBAL: {
+    auto Iter = Globals.find(C.getStrOperand());
+    if (Iter == Globals.end())
+      return Invalid();
+    unsigned Temp = NewTemp();
+    append(IR::Create(Iter->second ? IR::GlobalAddress : IR::LoadGlobal, Temp,
+                      C.getStrOperand()));
+    Push(Temp);
+    return false;
+  }
+  case ByteCode::STORE_LOCAL: {
+    auto Iter = Locals.find(C.getStrOperand());
+    if (Iter == Locals.end() || Iter->second.second || !Has(1))
+      return Invalid();
+    unsigned Var = Iter->second.first;
+    IROperand Val = pop();
+    materialize(Var);
+    // Let the instruction computing the value define the local instead.
+    IRBasicBlock &BB = TheFunction->getBlock(CurrentBlock);
+    if (Val.IsRegister() && Val.getRegister() >= NumVariables && !BB.empty() &&
+        BB.getInstructions().back().getDest() == Val.getRegister()) {
+      BB.getInstructions().back().setDest(Var);
+      return false;
+    }
+    append(IR::Create(IR::Copy, Var, Val));
+    return false;
+  }
+  case ByteCode::STORE_GLOBAL: {
+    auto Iter = Globals.find(C.getStrOperand());
+    if (Iter == Globals.end() || Iter->second || !Has(1))
+      return Invalid();
+    append(IR::Create(IR::StoreGlobal, IR::NoRegister, C.getStrOperand(),
+                      pop()));
+    return false;
+  }
+
+  case ByteCode::BINARY_ADD:
+  case ByteCode::BINARY_SUB:
+  case ByteCode::BINARY_MULTIPLY:
+  case ByteCode::BINARY_DIVIDE:
+  case ByteCode::BINARY_SUBSCR: {
+    if (!Has(2))
+      return Invalid();
+    IROperand B = pop();
+    IROperand A = pop();
+    IR::Opcode Op;
+    switch (C.getOpcode()) {
+    case ByteCode::BINARY_ADD:
+      Op = IR::Add;
+      break;
+    case ByteCode::BINARY_SUB:
+      Op = IR::Sub;
+      break;
+    case ByteCode::BINARY_MULTIPLY:
+      Op = IR::Mul;
+      break;
+    case ByteCode::BINARY_DIVIDE:
+      Op = IR::Div;
+      break;
+    default:
+      Op = IR::LoadElement;
+      break;
+    }
+    unsigned Temp = NewTemp();
+    append(IR::Create(Op, Temp, A, B));
+    Push(Temp);
+    return false;
+  }
+  case ByteCode::STORE_SUBSCR: {
+    if (!Has(3))
+      return Invalid();
+    IROperand Index = pop();
+    IROperand Base = pop();
+    IROperand Val = pop();
+    append(IR::Create(IR::StoreElement, IR::NoRegister, Base, Index, Val));
+    return false;
+  }
+
+  case ByteCode::UNARY_POSITIVE:
+    return !Has(1) && Invalid();
+  case ByteCode::UNARY_NEGATIVE: {
+    if (!Has(1))
+      return Invalid();
+    unsigned Temp = NewTemp();
+    append(IR::Create(IR::Neg, Temp, pop()));
+    Push(Temp);
+    return false;
+  }
+
+  case ByteCode::READ_INTEGER:
+  case ByteCode::READ_CHARACTER: {
+    unsigned Temp = NewTemp();
+    append(IR::Create(C.getOpcode() == ByteCode::READ_INTEGER
+                          ? IR::ReadInteger
+                          : IR::ReadCharacter,
+                      Temp));
+    Push(Temp);
+    return false;
+  }
+
+  case ByteCode::PRINT_STRING:
+  case ByteCode::PRINT_CHARACTER:
+  case ByteCode::PRINT_INTEGER: {
+    if (!Has(1))
+      return Invalid();
+    IROperand Val = pop();
+    IR::Opcode Op = C.getOpcode() == ByteCode::PRINT_STRING
+                        ? IR::PrintString
+                        : C.getOpcode() == ByteCode::PRINT_CHARACTER
+                              ? IR::PrintCharacter
+                              : IR::PrintInteger;
+    // A string is always a literal.
+    if (Op == IR::PrintString && !Val.IsImmediate())
+      return Invalid();
+    append(IR::Create(Op, IR::NoRegister, Val));
+    return false;
+  }
+  case ByteCode::PRINT_NEWLINE:
+    append(IR::Create(IR::PrintNewline, IR::NoRegister));
+    return false;
+
+  case ByteCode::JUMP_FORWARD:
+    append(IR::CreateJump(getBlockAt(C.getJumpTarget())));
+    return false;
+  case ByteCode::JUMP_IF_TRUE:
+  case ByteCode::JUMP_IF_FALSE: {
+    if (!Has(1))
+      return Invalid();
+    IROperand Val = pop();
+    append(IR::CreateBranch(C.getOpcode() == ByteCode::JUMP_IF_TRUE ? IR::NE
+                                                                    : IR::EQ,
+                            Val, IROperand::CreateImmediate(0),
+                            getBlockAt(C.getJumpTarget()),
+                            getBlockAt(Offset + 1)));
+    return false;
+  }
+  case ByteCode::JUMP_IF_EQUAL:
+  case ByteCode::JUMP_IF_NOT_EQUAL:
+  case ByteCode::JUMP_IF_GREATER:
+  case ByteCode::JUMP_IF_GREATER_EQUAL:
+  case ByteCode::JUMP_IF_LESS:
+  case ByteCode::JUMP_IF_LESS_EQUAL: {
+    if (!Has(2))
+      return Invalid();
+    IROperand B = pop();
+    IROperand A = pop();
+    static const IR::Condition Conds[] = {IR::EQ, IR::NE, IR::GT,
+                                          IR::GE, IR::LT, IR::LE};
+    IR::Condition Cond = Conds[C.getOpcode() - ByteCode::JUMP_IF_EQUAL];
+    append(IR::CreateBranch(Cond, A, B, getBlockAt(C.getJumpTarget()),
+                            getBlockAt(Offset + 1)));
+    return false;
+  }
+
+  case ByteCode::CALL_FUNCTION: {
+    unsigned NumArgs = static_cast<unsigned>(C.getIntOperand());
+    if (!Has(NumArgs))
+      return Invalid();
+    std::vector<IROperand> Args(Stack.end() - NumArgs, Stack.end());
+    Stack.resize(Stack.size() - NumArgs);
+    unsigned Temp = NewTemp();
+    append(IR::CreateCall(Temp, C.getStrOperand(), std::move(Args)));
+    Push(Temp);
+    return false;
+  }
+  case ByteCode::RETURN_VALUE:
+    if (!Has(1))
+      return Invalid();
+    append(IR::CreateReturn(pop()));
+    return false;
+  case ByteCode::RETURN_NONE:
+    append(IR::CreateReturn());
+    return false;
+
+  case ByteCode::LOAD_CONST:
+  case ByteCode::LOAD_STRING:
+    Stack.push_back(IROperand::CreateImmediate(C.getIntOperand()));
+    return false;
+
+  case ByteCode::POP_TOP: {
+    if (!Has(1))
+      return Invalid();
+    IROperand Val = pop();
+    // The value of a call is not used.
+    IRBasicBlock &BB = TheFunction->getBlock(CurrentBlock);
+    if (Val.IsRegister() && !BB.empty() &&
+        BB.getInstructions().back().getOpcode() == IR::Call &&
+        BB.getInstructions().back().getDest() == Val.getRegister())
+      BB.getInstructions().back().setDest(IR::NoRegister);
+    return false;
+  }
+
+  default:
+    return Invalid();
+  }
+}
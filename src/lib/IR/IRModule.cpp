@@ -0,0 +1,33 @@
+#include "simplecc/IR/IRModule.h"
+
+using namespace simplecc;
+
+void IRModule::setStringLiteral(unsigned ID, std::string Str) {
+  if (ID >= StringLiterals.size())
+    StringLiterals.resize(ID + 1);
+  StringLiterals[ID] = std::move(Str);
+}
+
+IRFunction *IRModule::createFunction(Identifier Name, unsigned NumArguments) {
+  Functions.emplace_back(new IRFunction(Name, NumArguments));
+  return Functions.back().get();
+}
+
+void IRModule::clear() {
+  Globals.clear();
+  StringLiterals.clear();
+  Functions.clear();
+}
+
+void IRModule::Format(std::ostream &O) const {
+  for (const GlobalVariable &G : Globals) {
+    O << "global " << G.Name;
+    if (G.IsArray())
+      O << "[" << G.Size << "]";
+    O << "\n";
+  }
+  for (unsigned I = 0, E = StringLiterals.size(); I < E; ++I)
+    O << "string " << I << " " << StringLiterals[I] << "\n";
+  for (const auto &F : Functions)
+    O << "\n" << *F;
+}
@@ -0,0 +1,61 @@
+#include "simplecc/IR/Liveness.h"
+#include "simplecc/IR/IRFunction.h"
+
+using namespace simplecc;
+
+bool RegisterSet::unionWith(const RegisterSet &RHS) {
+  bool Changed = false;
+  for (unsigned W = 0, E = Words.size(); W < E; ++W) {
+    uint64_t New = Words[W] | RHS.Words[W];
+    Changed |= New != Words[W];
+    Words[W] = New;
+  }
+  return Changed;
+}
+
+bool RegisterSet::assignTransfer(const RegisterSet &Use,
+                                 const RegisterSet &Out,
+                                 const RegisterSet &Def) {
+  bool Changed = false;
+  for (unsigned W = 0, E = Words.size(); W < E; ++W) {
+    uint64_t New = Use.Words[W] | (Out.Words[W] & ~Def.Words[W]);
+    Changed |= New != Words[W];
+    Words[W] = New;
+  }
+  return Changed;
+}
+
+void Liveness::Compute(const IRFunction &F) {
+  unsigned NumBlocks = F.getNumBlocks();
+  unsigned NumRegisters = F.getNumRegisters();
+  LiveIn.assign(NumBlocks, RegisterSet(NumRegisters));
+  LiveOut.assign(NumBlocks, RegisterSet(NumRegisters));
+
+  // The registers used before defined in a block and those defined in it.
+  std::vector<RegisterSet> Use(NumBlocks, RegisterSet(NumRegisters));
+  std::vector<RegisterSet> Def(NumBlocks, RegisterSet(NumRegisters));
+  for (unsigned B = 0; B < NumBlocks; ++B) {
+    for (const IRInstruction &I : F.getBlock(B)) {
+      for (unsigned Op = 0, E = I.getNumOperands(); Op < E; ++Op) {
+        const IROperand &Val = I.getOperand(Op);
+        if (Val.IsRegister() && !Def[B].test(Val.getRegister()))
+          Use[B].set(Val.getRegister());
+      }
+      if (I.HasDest())
+        Def[B].set(I.getDest());
+    }
+  }
+
+  // The blocks are mostly in the order of the code, so going backward
+  // converges in a few rounds.
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    for (unsigned B = NumBlocks; B-- > 0;) {
+      const IRBasicBlock &BB = F.getBlock(B);
+      for (unsigned S = 0, E = BB.getNumSuccessors(); S < E; ++S)
+        LiveOut[B].unionWith(LiveIn[BB.getSuccessor(S)]);
+      Changed |= LiveIn[B].assignTransfer(Use[B], LiveOut[B], Def[B]);
+    }
+  }
+}
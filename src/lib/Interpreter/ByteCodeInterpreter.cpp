@@ -0,0 +1,502 @@
+#include "simplecc/Interpreter/ByteCodeInterpreter.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include <algorithm>
+#include <cassert>
+
+// Dispatch by computed goto where the compiler supports labels as values.
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMPLECC_USE_COMPUTED_GOTO 1
+#endif
+
+using namespace simplecc;
+
+namespace {
+/// The opcodes of the Instr's: those of ByteCode in the same order, and
+/// those that only come from lowering.
+enum InstrKind : uint32_t {
+#define HANDLE_OPCODE(opcode, camelName) camelName,
+#include "simplecc/CodeGen/Opcode.def"
+  /// Push the address of a local array.
+  LoadLocalAddress,
+  /// Push the address of a global array.
+  LoadGlobalAddress,
+};
+
+/// Append the decimal digits of V to S.
+void AppendInt(std::string &S, int32_t V) {
+  char Buf[12];
+  char *P = Buf + sizeof Buf;
+  uint32_t U = V < 0 ? 0u - static_cast<uint32_t>(V) : static_cast<uint32_t>(V);
+  do {
+    *--P = static_cast<char>('0' + U % 10);
+    U /= 10;
+  } while (U);
+  if (V < 0)
+    *--P = '-';
+  S.append(P, Buf + sizeof Buf);
+}
+
+/// Arithmetic wraps around as it does on MIPS.
+inline int32_t Wrap(uint32_t V) { return static_cast<int32_t>(V); }
+inline uint32_t Unwrap(int32_t V) { return static_cast<uint32_t>(V); }
+
+/// Flush the buffered output when it grows beyond this.
+const size_t OutputBufferSize = 1 << 16;
+} // namespace
+
+ByteCodeInterpreter::ByteCodeInterpreter() : MemorySize(16 << 20) {
+  EM.setErrorType("RuntimeError");
+}
+
+ByteCodeInterpreter::~ByteCodeInterpreter() = default;
+
+bool ByteCodeInterpreter::Run(const ByteCodeModule &M, std::istream &In,
+                              std::ostream &Out) {
+  EM.clear();
+  if (Lower(M))
+    return true;
+  return Execute(In, Out);
+}
+
+bool ByteCodeInterpreter::Lower(const ByteCodeModule &M) {
+  Functions.clear();
+  Globals.clear();
+  FunctionIndices.clear();
+  StringLiterals.clear();
+  // A string literal is kept with its quotes.
+  for (const std::string &Str : M.getStringLiterals()) {
+    StringLiterals.push_back(
+        Str.size() >= 2 && Str.front() == '"' && Str.back() == '"'
+            ? Str.substr(1, Str.size() - 2)
+            : Str);
+  }
+
+  GlobalSize = 0;
+  for (const SymbolEntry &E : M.getGlobalVariables()) {
+    bool IsArray = E.IsArray();
+    Globals.emplace(E.getName(), std::make_pair(GlobalSize, IsArray));
+    GlobalSize += IsArray ? E.AsArray().getSize() : 1;
+  }
+
+  // Number the functions first so that calls can be resolved.
+  Functions.resize(M.size());
+  for (unsigned I = 0, E = M.size(); I < E; ++I) {
+    const ByteCodeFunction &Fn = *M.getFunctionList()[I];
+    Functions[I].Name = Fn.getName();
+    Functions[I].NumArguments = Fn.getFormalArgumentCount();
+    FunctionIndices.emplace(Fn.getName(), I);
+  }
+  auto Main = FunctionIndices.find(Identifier::get("main"));
+  if (Main == FunctionIndices.end() ||
+      Functions[Main->second].NumArguments != 0) {
+    EM.Error("no main() to run");
+    return true;
+  }
+  MainIndex = Main->second;
+
+  for (unsigned I = 0, E = M.size(); I < E; ++I) {
+    if (LowerFunction(*M.getFunctionList()[I], Functions[I]))
+      return true;
+  }
+  return false;
+}
+
+bool ByteCodeInterpreter::LowerFunction(const ByteCodeFunction &Fn,
+                                        Function &F) {
+  // The arguments come first in the frame, then the locals.
+  std::unordered_map<Identifier, std::pair<unsigned, bool>> Locals;
+  unsigned Slot = 0;
+  for (const SymbolEntry &Arg : Fn.getFormalArguments())
+    Locals.emplace(Arg.getName(), std::make_pair(Slot++, false));
+  for (const SymbolEntry &Var : Fn.getLocalVariables()) {
+    bool IsArray = Var.IsArray();
+    Locals.emplace(Var.getName(), std::make_pair(Slot, IsArray));
+    Slot += IsArray ? Var.AsArray().getSize() : 1;
+  }
+  F.FrameSize = Slot;
+
+  auto Invalid = [&](const ByteCode &C) {
+    EM.Error("invalid", C.getOpcodeName(), "in", Quote(F.Name.str()));
+    return true;
+  };
+
+  F.Code.clear();
+  F.Code.reserve(Fn.size() + 1);
+  F.MaxStackDepth = 0;
+  for (const ByteCode &C : Fn) {
+    Instr I{C.getOpcode(), 0, 0};
+    switch (C.getOpcode()) {
+    case ByteCode::LOAD_LOCAL:
+    case ByteCode::STORE_LOCAL:
+    case ByteCode::LOAD_GLOBAL:
+    case ByteCode::STORE_GLOBAL: {
+      bool IsLocal = C.getOpcode() == ByteCode::LOAD_LOCAL ||
+                     C.getOpcode() == ByteCode::STORE_LOCAL;
+      const auto &Table = IsLocal ? Locals : Globals;
+      auto Iter = Table.find(C.getStrOperand());
+      if (Iter == Table.end())
+        return Invalid(C);
+      I.A = static_cast<int32_t>(Iter->second.first);
+      if (Iter->second.second) {
+        // An array can only be loaded, which takes its address.
+        if (C.getOpcode() == ByteCode::STORE_LOCAL ||
+            C.getOpcode() == ByteCode::STORE_GLOBAL)
+          return Invalid(C);
+        I.Op = IsLocal ? LoadLocalAddress : LoadGlobalAddress;
+      }
+      break;
+    }
+    case ByteCode::STORE_LOCAL_CONST:
+    case ByteCode::INCREMENT_LOCAL:
+    case ByteCode::ADD_LOCAL_CONST: {
+      auto Iter = Locals.find(C.getStrOperand());
+      if (Iter == Locals.end() || Iter->second.second)
+        return Invalid(C);
+      I.A = static_cast<int32_t>(Iter->second.first);
+      I.B = C.getConstOperand();
+      break;
+    }
+    case ByteCode::CALL_FUNCTION: {
+      auto Iter = FunctionIndices.find(C.getStrOperand());
+      if (Iter == FunctionIndices.end() ||
+          Functions[Iter->second].NumArguments !=
+              static_cast<unsigned>(C.getIntOperand()))
+        return Invalid(C);
+      I.A = static_cast<int32_t>(Iter->second);
+      I.B = C.getIntOperand();
+      break;
+    }
+    case ByteCode::LOAD_STRING:
+    case ByteCode::PRINT_STRING_LITERAL:
+      if (static_cast<unsigned>(C.getIntOperand()) >= StringLiterals.size())
+        return Invalid(C);
+      I.A = C.getIntOperand();
+      break;
+    default:
+      if (C.IsJump() && C.getJumpTarget() > Fn.size())
+        return Invalid(C);
+      if (C.HasIntOperand())
+        I.A = C.getIntOperand();
+      if (C.HasConstOperand())
+        I.B = C.getConstOperand();
+      break;
+    }
+
+    // Bound the depth of the operand stack by the number of pushes.
+    switch (C.getOpcode()) {
+    case ByteCode::LOAD_LOCAL:
+    case ByteCode::LOAD_GLOBAL:
+    case ByteCode::LOAD_CONST:
+    case ByteCode::LOAD_STRING:
+    case ByteCode::READ_INTEGER:
+    case ByteCode::READ_CHARACTER:
+    case ByteCode::CALL_FUNCTION:
+    case ByteCode::ADD_LOCAL_CONST:
+      ++F.MaxStackDepth;
+      break;
+    default:
+      break;
+    }
+    F.Code.push_back(I);
+  }
+  // A jump may target the end, where the function returns.
+  F.Code.push_back(Instr{ReturnNone, 0, 0});
+  return false;
+}
+
+bool ByteCodeInterpreter::Execute(std::istream &In, std::ostream &Out) {
+  std::unique_ptr<int32_t[]> Memory(new int32_t[MemorySize]);
+  int32_t *Mem = Memory.get();
+  int32_t *const MemEnd = Mem + MemorySize;
+  // The MIPS backend takes two words for each call.
+  const size_t MaxCallDepth = MemorySize / 2;
+
+  struct CallFrame {
+    const Instr *ReturnIP;
+    int32_t *FP;
+    const Function *Fn;
+  };
+  std::vector<CallFrame> CallStack;
+  std::string Output;
+  auto Flush = [&Output, &Out]() {
+    Out.write(Output.data(), Output.size());
+    Output.clear();
+  };
+
+  const Function *Fn = &Functions[MainIndex];
+  if (GlobalSize + Fn->FrameSize + Fn->MaxStackDepth > MemorySize) {
+    EM.Error("out of memory");
+    return true;
+  }
+  std::fill(Mem, Mem + GlobalSize, 0);
+  int32_t *FP = Mem + GlobalSize;
+  std::fill(FP, FP + Fn->FrameSize, 0);
+  int32_t *SP = FP + Fn->FrameSize;
+  const Instr *Code = Fn->Code.data();
+  const Instr *IP = Code;
+  const Instr *I;
+  const char *Error = nullptr;
+  int32_t Result;
+
+#if defined(SIMPLECC_USE_COMPUTED_GOTO)
+  static const void *const Labels[] = {
+#define HANDLE_OPCODE(opcode, camelName) &&Do##camelName,
+#include "simplecc/CodeGen/Opcode.def"
+      &&DoLoadLocalAddress, &&DoLoadGlobalAddress,
+  };
+#define CASE(Name) Do##Name:
+#define NEXT()                                                                 \
+  do {                                                                         \
+    I = IP++;                                                                  \
+    goto *Labels[I->Op];                                                       \
+  } while (0)
+  NEXT();
+#else
+#define CASE(Name) case Name:
+#define NEXT() continue
+  for (;;) {
+  Resume:
+    I = IP++;
+    switch (I->Op) {
+#endif
+
+  CASE(LoadLocal) { *SP++ = FP[I->A]; NEXT(); }
+  CASE(LoadLocalAddress) {
+    *SP++ = static_cast<int32_t>(FP - Mem) + I->A;
+    NEXT();
+  }
+  CASE(LoadGlobal) { *SP++ = Mem[I->A]; NEXT(); }
+  CASE(LoadGlobalAddress) { *SP++ = I->A; NEXT(); }
+  CASE(StoreLocal) { FP[I->A] = *--SP; NEXT(); }
+  CASE(StoreGlobal) { Mem[I->A] = *--SP; NEXT(); }
+  CASE(LoadConst) { *SP++ = I->A; NEXT(); }
+  CASE(LoadString) { *SP++ = I->A; NEXT(); }
+  CASE(PopTop) { --SP; NEXT(); }
+
+  CASE(BinaryAdd) {
+    --SP;
+    SP[-1] = Wrap(Unwrap(SP[-1]) + Unwrap(SP[0]));
+    NEXT();
+  }
+  CASE(BinarySub) {
+    --SP;
+    SP[-1] = Wrap(Unwrap(SP[-1]) - Unwrap(SP[0]));
+    NEXT();
+  }
+  CASE(BinaryMultiply) {
+    --SP;
+    SP[-1] = Wrap(Unwrap(SP[-1]) * Unwrap(SP[0]));
+    NEXT();
+  }
+  CASE(BinaryDivide) {
+    --SP;
+    if (SP[0] == 0) {
+      Error = "division by zero";
+      goto Fail;
+    }
+    // Dividing the least int by -1 overflows to itself.
+    SP[-1] = SP[0] == -1 ? Wrap(0u - Unwrap(SP[-1])) : SP[-1] / SP[0];
+    NEXT();
+  }
+  CASE(BinarySubscr) {
+    --SP;
+    uint32_t Addr = Unwrap(SP[-1]) + Unwrap(SP[0]);
+    if (Addr >= MemorySize) {
+      Error = "subscript out of memory";
+      goto Fail;
+    }
+    SP[-1] = Mem[Addr];
+    NEXT();
+  }
+  CASE(StoreSubscr) {
+    SP -= 3;
+    uint32_t Addr = Unwrap(SP[1]) + Unwrap(SP[2]);
+    if (Addr >= MemorySize) {
+      Error = "subscript out of memory";
+      goto Fail;
+    }
+    Mem[Addr] = SP[0];
+    NEXT();
+  }
+  CASE(UnaryPositive) { NEXT(); }
+  CASE(UnaryNegative) {
+    SP[-1] = Wrap(0u - Unwrap(SP[-1]));
+    NEXT();
+  }
+
+  CASE(ReadInteger) {
+    // Let a prompt out before waiting for the input.
+    Flush();
+    int V;
+    if (!(In >> V))
+      V = 0;
+    *SP++ = V;
+    NEXT();
+  }
+  CASE(ReadCharacter) {
+    Flush();
+    char Ch;
+    if (!(In >> Ch))
+      Ch = 0;
+    *SP++ = Ch;
+    NEXT();
+  }
+  CASE(PrintString) {
+    uint32_t ID = Unwrap(*--SP);
+    if (ID >= StringLiterals.size()) {
+      Error = "invalid string";
+      goto Fail;
+    }
+    Output += StringLiterals[ID];
+    if (Output.size() > OutputBufferSize)
+      Flush();
+    NEXT();
+  }
+  CASE(PrintCharacter) {
+    Output += static_cast<char>(*--SP);
+    if (Output.size() > OutputBufferSize)
+      Flush();
+    NEXT();
+  }
+  CASE(PrintInteger) {
+    AppendInt(Output, *--SP);
+    if (Output.size() > OutputBufferSize)
+      Flush();
+    NEXT();
+  }
+  CASE(PrintNewline) {
+    Output += '\n';
+    if (Output.size() > OutputBufferSize)
+      Flush();
+    NEXT();
+  }
+
+  CASE(JumpForward) {
+    IP = Code + I->A;
+    NEXT();
+  }
+  CASE(JumpIfTrue) {
+    if (*--SP)
+      IP = Code + I->A;
+    NEXT();
+  }
+  CASE(JumpIfFalse) {
+    if (!*--SP)
+      IP = Code + I->A;
+    NEXT();
+  }
+#define BINARY_JUMP(Name, Op)                                                  \
+  CASE(Name) {                                                                 \
+    SP -= 2;                                                                   \
+    if (SP[0] Op SP[1])                                                        \
+      IP = Code + I->A;                                                        \
+    NEXT();                                                                    \
+  }
+  BINARY_JUMP(JumpIfEqual, ==)
+  BINARY_JUMP(JumpIfNotEqual, !=)
+  BINARY_JUMP(JumpIfGreater, >)
+  BINARY_JUMP(JumpIfGreaterEqual, >=)
+  BINARY_JUMP(JumpIfLess, <)
+  BINARY_JUMP(JumpIfLessEqual, <=)
+#undef BINARY_JUMP
+
+  // Superinstructions, with the constant in B.
+  CASE(PrintStringLiteral) {
+    Output += StringLiterals[I->A];
+    if (Output.size() > OutputBufferSize)
+      Flush();
+    NEXT();
+  }
+  CASE(StoreLocalConst) {
+    FP[I->A] = I->B;
+    NEXT();
+  }
+  CASE(IncrementLocal) {
+    FP[I->A] = Wrap(Unwrap(FP[I->A]) + Unwrap(I->B));
+    NEXT();
+  }
+  CASE(AddLocalConst) {
+    *SP++ = Wrap(Unwrap(FP[I->A]) + Unwrap(I->B));
+    NEXT();
+  }
+#define JUMP_WITH_CONST(Name, Op)                                              \
+  CASE(Name) {                                                                 \
+    if (*--SP Op I->B)                                                         \
+      IP = Code + I->A;                                                        \
+    NEXT();                                                                    \
+  }
+  JUMP_WITH_CONST(JumpIfEqualConst, ==)
+  JUMP_WITH_CONST(JumpIfNotEqualConst, !=)
+  JUMP_WITH_CONST(JumpIfGreaterConst, >)
+  JUMP_WITH_CONST(JumpIfGreaterEqualConst, >=)
+  JUMP_WITH_CONST(JumpIfLessConst, <)
+  JUMP_WITH_CONST(JumpIfLessEqualConst, <=)
+#undef JUMP_WITH_CONST
+
+  CASE(CallFunction) {
+    const Function *Callee = &Functions[I->A];
+    // The arguments on the operand stack become the start of the frame.
+    int32_t *NewFP = SP - I->B;
+    int32_t *NewSP = NewFP + Callee->FrameSize;
+    if (CallStack.size() >= MaxCallDepth ||
+        Callee->FrameSize + Callee->MaxStackDepth >
+            static_cast<size_t>(MemEnd - NewFP)) {
+      Error = "stack overflow";
+      goto Fail;
+    }
+    std::fill(SP, NewSP, 0);
+    CallStack.push_back(CallFrame{IP, FP, Fn});
+    Fn = Callee;
+    FP = NewFP;
+    SP = NewSP;
+    IP = Code = Fn->Code.data();
+    NEXT();
+  }
+  CASE(ReturnValue) {
+    Result = *--SP;
+    goto Return;
+  }
+  CASE(ReturnNone) {
+    Result = 0;
+    goto Return;
+  }
+
+#if !defined(SIMPLECC_USE_COMPUTED_GOTO)
+    default:
+      assert(false && "Invalid Instr");
+    }
+  }
+#endif
+#undef CASE
+#undef NEXT
+
+Return:
+  if (CallStack.empty()) {
+    Flush();
+    return false;
+  }
+  {
+    const CallFrame &Frame = CallStack.back();
+    // Pop the frame along with the arguments and push the result.
+    SP = FP;
+    *SP++ = Result;
+    IP = Frame.ReturnIP;
+    FP = Frame.FP;
+    Fn = Frame.Fn;
+    Code = Fn->Code.data();
+    CallStack.pop_back();
+  }
+#if defined(SIMPLECC_USE_COMPUTED_GOTO)
+  I = IP++;
+  goto *Labels[I->Op];
+#else
+  // Resume the loop through a jump into it.
+  goto Resume;
+#endif
+
+Fail:
+  Flush();
+  EM.Error(Error, "in", Quote(Fn->Name.str()));
+  return true;
+}
@@ -0,0 +1,152 @@
+#include "simplecc/Lex/Lexer.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#ifdef _MSC_VER
+#include <cctype>
+#endif
+
+using namespace simplecc;
+
+/// Return if a char is valid to be in a string literal.
+static inline bool IsValidStrChar(char Chr) {
+  return Chr == 32 || Chr == 33 || (35 <= Chr && Chr <= 126);
+}
+
+/// Return if a char begins an identifier.
+static inline bool IsNameBegin(char Chr) {
+  return Chr == '_' || std::isalpha(Chr);
+}
+
+/// Return if a char can appear in the middle and end of an identifier.
+static inline bool IsNameMiddle(char Chr) {
+  return Chr == '_' || std::isalnum(Chr);
+}
+
+/// Return if a char is a valid one in a character literal.
+static inline bool IsValidChar(char Chr) {
+  static const std::string ValidChars("+-*/_");
+  return ValidChars.find(Chr) != std::string::npos || std::isalnum(Chr);
+}
+
+/// Return if a char is _special_.
+/// Brackets, parentheses, braces, semicolon, colon and comma are _special_.
+static inline bool IsSpecial(char Chr) {
+  static const std::string Special("[](){};:,");
+  return Special.find(Chr) != std::string::npos;
+}
+
+/// Return if a char is (part of) an operator.
+static inline bool IsOperator(char Chr) {
+  static const std::string Operators("+-*/<>!=");
+  return Operators.find(Chr) != std::string::npos;
+}
+
+bool Lexer::NextLine() {
+  if (Input) {
+    if (!Writable->AppendLine(*Input, TheLine, Max))
+      return false;
+  } else {
+    const char *BufferEnd = Source.getBufferEnd();
+    if (Cursor == BufferEnd)
+      return false;
+    auto LineEnd = static_cast<const char *>(
+        std::memchr(Cursor, '\n', BufferEnd - Cursor));
+    if (!LineEnd)
+      LineEnd = BufferEnd;
+    TheLine = Cursor;
+    Max = LineEnd - Cursor;
+    Cursor = LineEnd == BufferEnd ? BufferEnd : LineEnd + 1;
+  }
+  ++Lineno;
+  Pos = 0;
+  return true;
+}
+
+Identifier Lexer::InternName(const char *Name, unsigned Length) {
+  // Names are case-insensitive. Only copy one if it has to change.
+  if (!std::any_of(Name, Name + Length, ::isupper))
+    return Identifier::get(Name, Length);
+  Lowered.assign(Name, Length);
+  std::transform(Lowered.begin(), Lowered.end(), Lowered.begin(), ::tolower);
+  return Identifier::get(Lowered);
+}
+
+TokenInfo Lexer::Lex() {
+  // Reading one past the end of the line yields a NUL, just like
+  // indexing a std::string at its size().
+  auto At = [this](unsigned P) { return P < Max ? TheLine[P] : '\0'; };
+  ++NumTokens;
+
+  while (true) {
+    if (Pos >= Max) {
+      if (!NextLine())
+        return TokenInfo(Symbol::ENDMARKER, nullptr, nullptr, 0,
+                         Location(Lineno, 0));
+      continue;
+    }
+
+    Location Start(Lineno, Pos);
+    Symbol Type = Symbol::ERRORTOKEN;
+
+    if (std::isdigit(At(Pos))) {
+      while (std::isdigit(At(Pos))) {
+        ++Pos;
+      }
+      Type = Symbol::NUMBER;
+    } else if (At(Pos) == '\'') {
+      ++Pos;
+      if (IsValidChar(At(Pos))) {
+        ++Pos;
+        if (At(Pos) == '\'') {
+          ++Pos;
+          Type = Symbol::CHAR;
+        }
+      }
+    } else if (At(Pos) == '\"') {
+      ++Pos;
+      while (IsValidStrChar(At(Pos))) {
+        ++Pos;
+      }
+      if (At(Pos) == '\"') {
+        ++Pos;
+        Type = Symbol::STRING;
+      }
+    } else if (IsNameBegin(At(Pos))) {
+      ++Pos;
+      while (IsNameMiddle(At(Pos)))
+        ++Pos;
+      Type = Symbol::NAME;
+    } else if (IsSpecial(At(Pos))) {
+      ++Pos;
+      Type = Symbol::OP;
+    } else if (IsOperator(At(Pos))) {
+      char chr = At(Pos);
+      ++Pos;
+      if (chr == '>' || chr == '<' || chr == '=') {
+        Type = Symbol::OP;
+        if (At(Pos) == '=') {
+          ++Pos;
+        }
+      } else if (chr == '!') {
+        if (At(Pos) == '=') {
+          ++Pos;
+          Type = Symbol::OP;
+        }
+      } else {
+        Type = Symbol::OP;
+      }
+    } else if (std::isspace(At(Pos))) {
+      while (std::isspace(At(Pos)))
+        ++Pos;
+      continue;
+    } else {
+      ++Pos; // ERRORTOKEN
+    }
+    unsigned Col = Start.getColumn();
+    if (Type == Symbol::NAME)
+      return TokenInfo(Type, &Source, TheLine + Col, Pos - Col, Start,
+                       InternName(TheLine + Col, Pos - Col));
+    return TokenInfo(Type, &Source, TheLine + Col, Pos - Col, Start);
+  }
+}
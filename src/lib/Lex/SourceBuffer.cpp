@@ -0,0 +1,130 @@
+#include "simplecc/Lex/SourceBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIMPLECC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace simplecc;
+
+SourceBuffer::SourceBuffer(std::string Text) { setStorage(std::move(Text)); }
+
+void SourceBuffer::setStorage(std::string Text) {
+  Storage = std::move(Text);
+  BufferStart = Storage.data();
+  Size = Storage.size();
+}
+
+void SourceBuffer::clear() {
+#ifdef SIMPLECC_HAVE_MMAP
+  if (IsMapped)
+    ::munmap(const_cast<char *>(BufferStart), Size);
+#endif
+  IsMapped = false;
+  IsStreamed = false;
+  Chunks.clear();
+  setStorage(std::string());
+}
+
+void SourceBuffer::ReadFrom(std::istream &IS) {
+  // Pull the stream in big chunks rather than char by char.
+  std::string Text;
+  char Chunk[1 << 16];
+  while (IS.read(Chunk, sizeof Chunk) || IS.gcount())
+    Text.append(Chunk, IS.gcount());
+  clear();
+  setStorage(std::move(Text));
+}
+
+bool SourceBuffer::ReadFile(const std::string &Filename) {
+  clear();
+#ifdef SIMPLECC_HAVE_MMAP
+  int FD = ::open(Filename.c_str(), O_RDONLY);
+  if (FD < 0)
+    return true;
+  struct stat Stat;
+  if (::fstat(FD, &Stat)) {
+    ::close(FD);
+    return true;
+  }
+  // A pipe or a device has no size to map, so it is read as a stream.
+  if (S_ISREG(Stat.st_mode)) {
+    // An empty file cannot be mapped and needs no storage.
+    if (Stat.st_size == 0) {
+      ::close(FD);
+      return false;
+    }
+    void *Addr = ::mmap(nullptr, Stat.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+    if (Addr != MAP_FAILED) {
+      ::close(FD);
+      BufferStart = static_cast<const char *>(Addr);
+      Size = Stat.st_size;
+      IsMapped = true;
+      return false;
+    }
+  }
+  ::close(FD);
+  // Fall through to reading if mapping is not possible.
+#endif
+  std::ifstream IS(Filename, std::ios::binary);
+  if (!IS)
+    return true;
+  ReadFrom(IS);
+  return IS.bad();
+}
+
+bool SourceBuffer::AppendLine(std::istream &IS, const char *&Line,
+                              unsigned &Length) {
+  if (!IsStreamed) {
+    clear();
+    IsStreamed = true;
+  }
+  std::string TheLine;
+  if (!std::getline(IS, TheLine))
+    return false;
+
+  // Keep the newline so that getLine() can find where the line ends.
+  unsigned Needed = TheLine.size() + 1;
+  if (Chunks.empty() ||
+      Chunks.back().Capacity - Chunks.back().Used < Needed) {
+    unsigned Capacity = std::max(Needed, 1u << 16);
+    Chunks.push_back(Chunk{std::unique_ptr<char[]>(new char[Capacity]),
+                           Capacity, 0});
+  }
+  Chunk &Last = Chunks.back();
+  char *Dest = Last.Data.get() + Last.Used;
+  std::copy(TheLine.begin(), TheLine.end(), Dest);
+  Dest[TheLine.size()] = '\n';
+  Last.Used += Needed;
+  Size += Needed;
+
+  Line = Dest;
+  Length = TheLine.size();
+  return true;
+}
+
+std::string SourceBuffer::getLine(const char *Pos) const {
+  const char *Begin = BufferStart;
+  const char *End = BufferStart + Size;
+  if (IsStreamed) {
+    // Find the chunk holding Pos.
+    for (const Chunk &C : Chunks) {
+      if (C.Data.get() <= Pos && Pos <= C.Data.get() + C.Used) {
+        Begin = C.Data.get();
+        End = Begin + C.Used;
+        break;
+      }
+    }
+  }
+  assert(Begin <= Pos && Pos <= End && "Pos out of range");
+  const char *LineBegin = Pos;
+  while (LineBegin != Begin && LineBegin[-1] != '\n')
+    --LineBegin;
+  return std::string(LineBegin, std::find(Pos, End, '\n'));
+}
@@ -30,7 +30,20 @@ const char *TokenInfo::getTypeName() const {
   return getSymbolName(Type);
 }
 
-TokenInfo::TokenInfo(Symbol Ty, std::string S, Location Loc, std::string Line)
-    : Type(Ty), Str(std::move(S)), Loc(Loc), Line(std::move(Line)) {
+TokenInfo::TokenInfo(Symbol Ty, const SourceBuffer *Source, const char *Data,
+                     unsigned Length, Location Loc, Identifier Id)
+    : Type(Ty), Length(Length), Data(Data), Loc(Loc), Source(Source), Id(Id) {
   assert(IsTerminal(Ty));
+  assert((Source || !Length) && "Non-empty token needs a SourceBuffer");
+  assert((Ty != Symbol::NAME || !Id.empty()) && "NAME needs an Identifier");
+}
+
+std::string TokenInfo::getString() const {
+  if (Type == Symbol::NAME)
+    return Id.str();
+  return std::string(Data, Length);
+}
+
+std::string TokenInfo::getLine() const {
+  return Source ? Source->getLine(Data) : std::string();
 }
@@ -10,16 +10,21 @@ ProgramAST *ASTBuilder::visit_program(std::string Filename, Node *N) {
   std::vector<DeclAST *> Decls;
 
   for (auto C : N->getChildren()) {
-    if (C->getType() == Symbol::const_decl) {
-      visit_const_decl(C, Decls);
-    } else if (C->getType() == Symbol::declaration) {
-      visit_declaration(C, Decls);
-    } else {
-      assert(C->getType() == Symbol::ENDMARKER);
+    if (C->getType() == Symbol::ENDMARKER)
       break;
-    }
+    visit_program_item(C, Decls);
+  }
+  return new ProgramAST(std::move(Filename), std::move(Decls),
+                        std::move(TheContext));
+}
+
+void ASTBuilder::visit_program_item(Node *N, std::vector<DeclAST *> &Decls) {
+  if (N->getType() == Symbol::const_decl) {
+    visit_const_decl(N, Decls);
+  } else {
+    assert(N->getType() == Symbol::declaration);
+    visit_declaration(N, Decls);
   }
-  return new ProgramAST(std::move(Filename), std::move(Decls));
 }
 
 void ASTBuilder::visit_const_decl(Node *N, std::vector<DeclAST *> &Decls) {
@@ -41,9 +46,11 @@ DeclAST *ASTBuilder::visit_const_item(Node *N, BasicTypeKind Ty) {
     Val = makeCharExpr(constant);
   } else {
     assert(constant->getType() == Symbol::integer);
-    Val = new NumExpr(visit_integer(constant), constant->getLocation());
+    Val = new (*TheContext) NumExpr(visit_integer(constant),
+                                    constant->getLocation());
   }
-  return new ConstDecl(Ty, name->getValue(), Val, name->getLocation());
+  return new (*TheContext) ConstDecl(Ty, name->getIdentifier(), Val,
+                                     name->getLocation());
 }
 
 int ASTBuilder::visit_integer(Node *N) {
@@ -61,8 +68,10 @@ void ASTBuilder::visit_declaration(Node *N, std::vector<DeclAST *> &Decls) {
     std::vector<StmtAST *> FnStmts;
     auto Ty = visit_type_name(TypeName);
     visit_compound_stmt(N->getLastChild(), FnDecls, FnStmts);
-    Decls.push_back(new FuncDef(Ty, {}, std::move(FnDecls), std::move(FnStmts),
-                                "main", TypeName->getLocation()));
+    Decls.push_back(new (*TheContext) FuncDef(Ty, {}, std::move(FnDecls),
+                                              std::move(FnStmts),
+                                              name->getIdentifier(),
+                                              TypeName->getLocation()));
     return;
   }
 
@@ -81,18 +90,19 @@ std::vector<ExprAST *> ASTBuilder::visit_arglist(Node *N) {
   return std::move(Args);
 }
 
-ExprAST *ASTBuilder::visit_atom_trailer(Node *N, const std::string &Name,
+ExprAST *ASTBuilder::visit_atom_trailer(Node *N, Identifier Name,
                                         ExprContextKind Context) {
   auto first = N->getFirstChild();
   if (first->getType() == Symbol::arglist) {
     // no empty arglist
     std::vector<ExprAST *> Args = visit_arglist(first);
-    return new CallExpr(Name, Args, N->getLocation());
+    return new (*TheContext) CallExpr(Name, Args, N->getLocation());
   }
 
   assert(first->getValue() == "[");
   auto index = visit_expr(N->getChild(1));
-  return new SubscriptExpr(Name, index, Context, N->getLocation());
+  return new (*TheContext) SubscriptExpr(Name, index, Context,
+                                         N->getLocation());
 }
 
 ExprAST *ASTBuilder::visit_atom(Node *N, ExprContextKind Context) {
@@ -100,11 +110,12 @@ ExprAST *ASTBuilder::visit_atom(Node *N, ExprContextKind Context) {
   if (first->getType() == Symbol::NAME) {
     if (N->getNumChildren() == 1) {
       // single name
-      return new NameExpr(first->getValue(), Context, first->getLocation());
+      return new (*TheContext) NameExpr(first->getIdentifier(), Context,
+                                        first->getLocation());
     }
     // name with trailer: visit_trailer
     auto trailer = N->getChild(1);
-    return visit_atom_trailer(trailer, first->getValue(), Context);
+    return visit_atom_trailer(trailer, first->getIdentifier(), Context);
   }
 
   if (first->getType() == Symbol::NUMBER) {
@@ -117,7 +128,7 @@ ExprAST *ASTBuilder::visit_atom(Node *N, ExprContextKind Context) {
 
   assert(first->getValue() == "(");
   auto value = visit_expr(N->getChild(1));
-  return new ParenExpr(value, first->getLocation());
+  return new (*TheContext) ParenExpr(value, first->getLocation());
 }
 
 StmtAST *ASTBuilder::visit_write_stmt(Node *N) {
@@ -128,10 +139,10 @@ StmtAST *ASTBuilder::visit_write_stmt(Node *N) {
     if (C->getType() == Symbol::expr)
       E = visit_expr(C);
     else if (C->getType() == Symbol::STRING)
-      S = new StrExpr(C->getValue(), C->getLocation());
+      S = new (*TheContext) StrExpr(C->getValue(), C->getLocation());
     // ignore other things
   }
-  return new WriteStmt(S, E, N->getLocation());
+  return new (*TheContext) WriteStmt(S, E, N->getLocation());
 }
 
 void ASTBuilder::visit_decl_trailer(Node *N, Node *TypeName, Node *Name,
@@ -142,21 +153,23 @@ void ASTBuilder::visit_decl_trailer(Node *N, Node *TypeName, Node *Name,
 
   if (first->getValue() == ";") {
     Decls.push_back(
-        new VarDecl(Ty, Name->getValue(), false, 0, TypeName->getLocation()));
+        new (*TheContext) VarDecl(Ty, Name->getIdentifier(), false, 0,
+                                  TypeName->getLocation()));
     return;
   }
 
   if (first->getType() == Symbol::paralist ||
       first->getType() == Symbol::compound_stmt) {
     Decls.push_back(
-        visit_funcdef(Ty, Name->getValue(), N, TypeName->getLocation()));
+        visit_funcdef(Ty, Name->getIdentifier(), N, TypeName->getLocation()));
     return;
   }
 
   bool IsArray = first->getType() == Symbol::subscript2;
   int ArraySize = IsArray ? visit_subscript2(first) : 0;
   Decls.push_back(
-      new VarDecl(Ty, Name->getValue(), IsArray, ArraySize, N->getLocation()));
+      new (*TheContext) VarDecl(Ty, Name->getIdentifier(), IsArray, ArraySize,
+                                N->getLocation()));
 
   for (auto C : N->getChildren()) {
     if (C->getType() != Symbol::var_item)
@@ -167,10 +180,10 @@ void ASTBuilder::visit_decl_trailer(Node *N, Node *TypeName, Node *Name,
 
 StmtAST *ASTBuilder::visit_return_stmt(Node *N) {
   if (N->getNumChildren() == 1)
-    return new ReturnStmt(nullptr, N->getLocation());
+    return new (*TheContext) ReturnStmt(nullptr, N->getLocation());
 
   auto expr = visit_expr(N->getChild(2));
-  return new ReturnStmt(expr, N->getLocation());
+  return new (*TheContext) ReturnStmt(expr, N->getLocation());
 }
 
 void ASTBuilder::visit_stmt(Node *N, std::vector<StmtAST *> &Stmts) {
@@ -181,8 +194,10 @@ void ASTBuilder::visit_stmt(Node *N, std::vector<StmtAST *> &Stmts) {
 
   if (first->getType() == Symbol::NAME) {
     if (N->getNumChildren() == 2) {
-      auto call = new CallExpr(first->getValue(), {}, first->getLocation());
-      return Stmts.push_back(new ExprStmt(call, N->getLocation()));
+      auto call = new (*TheContext) CallExpr(first->getIdentifier(), {},
+                                             first->getLocation());
+      return Stmts.push_back(
+          new (*TheContext) ExprStmt(call, N->getLocation()));
     }
     return Stmts.push_back(visit_stmt_trailer(N->getChild(1), first));
   }
@@ -225,7 +240,8 @@ StmtAST *ASTBuilder::visit_if_stmt(Node *N) {
   visit_stmt(stmt, body);
   if (N->getNumChildren() > 5)
     visit_stmt(N->getLastChild(), orelse);
-  return new IfStmt(test, std::move(body), std::move(orelse), N->getLocation());
+  return new (*TheContext) IfStmt(test, std::move(body), std::move(orelse),
+                                  N->getLocation());
 }
 
 ExprAST *ASTBuilder::visit_binop(Node *N, ExprContextKind Context) {
@@ -236,13 +252,14 @@ ExprAST *ASTBuilder::visit_binop(Node *N, ExprContextKind Context) {
     auto NextOp = N->getChild(i * 2 + 1);
     auto op = OperatorKindFromString(NextOp->getValue());
     auto tmp = visit_expr(N->getChild(i * 2 + 2), Context);
-    auto tmp_result = new BinOpExpr(result, op, tmp, NextOp->getLocation());
+    auto tmp_result = new (*TheContext) BinOpExpr(result, op, tmp,
+                                                  NextOp->getLocation());
     result = tmp_result;
   }
   return result;
 }
 
-DeclAST *ASTBuilder::visit_funcdef(BasicTypeKind RetTy, std::string Name,
+DeclAST *ASTBuilder::visit_funcdef(BasicTypeKind RetTy, Identifier Name,
                                    Node *decl_trailer, Location L) {
   std::vector<ArgDecl *> ParamList;
   std::vector<DeclAST *> FnDecls;
@@ -253,23 +270,25 @@ DeclAST *ASTBuilder::visit_funcdef(BasicTypeKind RetTy, std::string Name,
   }
 
   visit_compound_stmt(decl_trailer->getLastChild(), FnDecls, FnStmts);
-  return new FuncDef(RetTy, std::move(ParamList),
-                     std::move(FnDecls),
-                     std::move(FnStmts), std::move(Name), L);
+  return new (*TheContext) FuncDef(RetTy, std::move(ParamList),
+                                   std::move(FnDecls),
+                                   std::move(FnStmts), Name, L);
 }
 
 ExprAST *ASTBuilder::visit_condition(Node *N) {
   bool has_cmpop = N->getNumChildren() == 3;
-  return new BoolOpExpr(visit_expr(N), has_cmpop, N->getLocation());
+  return new (*TheContext) BoolOpExpr(visit_expr(N), has_cmpop,
+                                      N->getLocation());
 }
 
 StmtAST *ASTBuilder::visit_for_stmt(Node *N) {
   // initial: stmt
   auto Nn = N->getChild(2);
   auto expr = N->getChild(4);
-  auto Initial = new AssignStmt(
-      /* target */ new NameExpr(Nn->getValue(), ExprContextKind::Store,
-                                Nn->getLocation()),
+  auto Initial = new (*TheContext) AssignStmt(
+      /* target */ new (*TheContext) NameExpr(Nn->getIdentifier(),
+                                              ExprContextKind::Store,
+                                              Nn->getLocation()),
       /* value */ visit_expr(expr), /* loc */ Nn->getLocation());
 
   // condition: expr
@@ -281,23 +300,26 @@ StmtAST *ASTBuilder::visit_for_stmt(Node *N) {
   auto op = N->getChild(11);
   auto num = N->getChild(12);
   assert(num->getType() == Symbol::NUMBER);
-  auto L = new NameExpr(name2->getValue(), ExprContextKind::Load,
-                        name2->getLocation());
+  auto L = new (*TheContext) NameExpr(name2->getIdentifier(),
+                                      ExprContextKind::Load,
+                                      name2->getLocation());
   auto R = makeNumExpr(num);
-  auto BO = new BinOpExpr(
+  auto BO = new (*TheContext) BinOpExpr(
       /* left */ L,
       /* op */ OperatorKindFromString(op->getValue()),
       /* right */ R, name2->getLocation());
-  auto Step = new AssignStmt(
-      /* target */ new NameExpr(target->getValue(), ExprContextKind::Store,
-                                target->getLocation()),
+  auto Step = new (*TheContext) AssignStmt(
+      /* target */ new (*TheContext) NameExpr(target->getIdentifier(),
+                                              ExprContextKind::Store,
+                                              target->getLocation()),
       /* value */ BO,
       /* loc */ target->getLocation());
 
   // body: stmt*
   std::vector<StmtAST *> Body;
   visit_stmt(N->getLastChild(), Body);
-  return new ForStmt(Initial, Cond, Step, std::move(Body), N->getLocation());
+  return new (*TheContext) ForStmt(Initial, Cond, Step, std::move(Body),
+                                   N->getLocation());
 }
 
 void ASTBuilder::visit_paralist(Node *N, std::vector<ArgDecl *> &ParamList) {
@@ -307,9 +329,9 @@ void ASTBuilder::visit_paralist(Node *N, std::vector<ArgDecl *> &ParamList) {
     auto TypeName = N->getChild(1 + i * 3);
     auto Name = N->getChild(2 + i * 3);
 
-    ParamList.push_back(new ArgDecl(
+    ParamList.push_back(new (*TheContext) ArgDecl(
         /* type */ visit_type_name(TypeName),
-        /* name */ Name->getValue(),
+        /* name */ Name->getIdentifier(),
         /* loc */ TypeName->getLocation()));
   }
 }
@@ -322,30 +344,32 @@ ExprAST *ASTBuilder::visit_factor(Node *N, ExprContextKind Context) {
   auto first = N->getFirstChild();
   auto op = UnaryopKindFromString(first->getValue());
   auto operand = visit_factor(N->getChild(1), Context);
-  return new UnaryOpExpr(op, operand, first->getLocation());
+  return new (*TheContext) UnaryOpExpr(op, operand, first->getLocation());
 }
 
 StmtAST *ASTBuilder::visit_stmt_trailer(Node *N, Node *Name) {
   auto first = N->getFirstChild();
   if (first->getType() == Symbol::arglist) {
     std::vector<ExprAST *> Args = visit_arglist(first);
-    auto C =
-        new CallExpr(Name->getValue(), std::move(Args), Name->getLocation());
-    return new ExprStmt(C, Name->getLocation());
+    auto C = new (*TheContext) CallExpr(Name->getIdentifier(), std::move(Args),
+                                        Name->getLocation());
+    return new (*TheContext) ExprStmt(C, Name->getLocation());
 
   } else if (first->getValue() == "[") {
     auto Idx = visit_expr(N->getChild(1));
     auto Val = visit_expr(N->getLastChild());
-    auto SB = new SubscriptExpr(Name->getValue(), Idx, ExprContextKind::Store,
-                                N->getLocation());
-    return new AssignStmt(SB, Val, Name->getLocation());
+    auto SB = new (*TheContext) SubscriptExpr(Name->getIdentifier(), Idx,
+                                              ExprContextKind::Store,
+                                              N->getLocation());
+    return new (*TheContext) AssignStmt(SB, Val, Name->getLocation());
 
   } else {
     assert(first->getValue() == "=");
     auto Val = visit_expr(N->getLastChild());
-    auto Target = new NameExpr(Name->getValue(), ExprContextKind::Store,
-                               Name->getLocation());
-    return new AssignStmt(Target, Val, Name->getLocation());
+    auto Target = new (*TheContext) NameExpr(Name->getIdentifier(),
+                                             ExprContextKind::Store,
+                                             Name->getLocation());
+    return new (*TheContext) AssignStmt(Target, Val, Name->getLocation());
   }
 }
 
@@ -367,13 +391,14 @@ void ASTBuilder::visit_compound_stmt(Node *N, std::vector<DeclAST *> &FnDecls,
 
 StmtAST *ASTBuilder::visit_read_stmt(Node *N) {
   std::vector<NameExpr *> Names;
-  std::for_each(std::next(N->begin()), N->end(), [&Names](Node *Child) {
+  std::for_each(std::next(N->begin()), N->end(), [this, &Names](Node *Child) {
     if (Child->getType() == Symbol::NAME) {
-      Names.push_back(new NameExpr(Child->getValue(), ExprContextKind::Store,
-                                   Child->getLocation()));
+      Names.push_back(new (*TheContext) NameExpr(Child->getIdentifier(),
+                                                 ExprContextKind::Store,
+                                                 Child->getLocation()));
     }
   });
-  return new ReadStmt(std::move(Names), N->getLocation());
+  return new (*TheContext) ReadStmt(std::move(Names), N->getLocation());
 }
 
 ExprAST *ASTBuilder::visit_expr(Node *N, ExprContextKind Context) {
@@ -401,17 +426,17 @@ DeclAST *ASTBuilder::visit_var_item(Node *N, BasicTypeKind Ty) {
   auto name = N->getFirstChild();
   bool IsArray = N->getNumChildren() > 1;
   int Size = IsArray ? visit_subscript2(N->getChild(1)) : 0;
-  return new VarDecl(Ty,
-      /* name */ name->getValue(),
-      /* IsArray */ IsArray,
-      /* size */ Size, name->getLocation());
+  return new (*TheContext) VarDecl(Ty,
+                                   /* name */ name->getIdentifier(),
+                                   /* IsArray */ IsArray,
+                                   /* size */ Size, name->getLocation());
 }
 
 StmtAST *ASTBuilder::visit_while_stmt(Node *N) {
   auto Cond = visit_condition(N->getChild(2));
   std::vector<StmtAST *> Body;
   visit_stmt(N->getLastChild(), Body);
-  return new WhileStmt(Cond, std::move(Body), N->getLocation());
+  return new (*TheContext) WhileStmt(Cond, std::move(Body), N->getLocation());
 }
 
 BasicTypeKind ASTBuilder::visit_type_name(Node *N) {
@@ -425,28 +450,51 @@ int ASTBuilder::visit_subscript2(Node *N) {
 
 CharExpr *ASTBuilder::makeCharExpr(Node *N) {
   assert(N->getType() == Symbol::CHAR);
-  return new CharExpr(static_cast<int>(N->getValue()[1]), N->getLocation());
+  return new (*TheContext) CharExpr(static_cast<int>(N->getValue()[1]),
+                                    N->getLocation());
 }
 
 NumExpr *ASTBuilder::makeNumExpr(Node *N) {
   assert(N->getType() == Symbol::NUMBER);
   auto loc = N->getLocation();
-  return new NumExpr(evaluate_integer(N->getValue(), loc), loc);
+  return new (*TheContext) NumExpr(evaluate_integer(N->getValue(), loc), loc);
 }
 
 int ASTBuilder::evaluate_integer(const std::string &Str, Location L) {
   try {
     return std::stoi(Str);
   } catch (std::out_of_range &E) {
-    EM.Error(L, "integer out of range:", Str);
+    PendingErrors.emplace_back(L, Str);
     return 0;
   }
 }
 
+void ASTBuilder::FlushErrors() {
+  for (const auto &Pair : PendingErrors) {
+    EM.Error(Pair.first, "integer out of range:", Pair.second);
+  }
+  PendingErrors.clear();
+}
+
 std::unique_ptr<ProgramAST, DeleteAST>
 ASTBuilder::Build(const std::string &Filename, const Node *N) {
   std::unique_ptr<ProgramAST, DeleteAST> Ptr(visit_program(Filename, const_cast<Node *>(N)));
+  FlushErrors();
   if (EM.IsOk())
     return std::move(Ptr);
   return nullptr;
 }
+
+void ASTBuilder::BuildDecl(const Node *N, std::vector<DeclAST *> &Decls) {
+  visit_program_item(const_cast<Node *>(N), Decls);
+}
+
+std::unique_ptr<ProgramAST, DeleteAST>
+ASTBuilder::Build(const std::string &Filename, std::vector<DeclAST *> Decls) {
+  FlushErrors();
+  if (EM.IsOk())
+    return std::unique_ptr<ProgramAST, DeleteAST>(
+        new ProgramAST(Filename, std::move(Decls), std::move(TheContext)));
+  DeleteAST::apply(Decls);
+  return nullptr;
+}
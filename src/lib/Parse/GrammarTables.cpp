@@ -0,0 +1,110 @@
+#include "simplecc/Parse/GrammarTables.h"
+#include "simplecc/Lex/TokenInfo.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+using namespace simplecc;
+
+const GrammarTables &GrammarTables::get(const Grammar *G) {
+  static std::mutex Lock;
+  static std::unordered_map<const Grammar *, std::unique_ptr<GrammarTables>>
+      Cache;
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto &Tables = Cache[G];
+  if (!Tables)
+    Tables.reset(new GrammarTables(G));
+  return *Tables;
+}
+
+GrammarTables::GrammarTables(const Grammar *G)
+    : TheGrammar(G), KeywordLabels(), OperatorLabels(),
+      TokenLabels(NT_OFFSET, -1), FirstSets(), Actions(), DFABase() {
+  // The first label item is for the empty label.
+  // The first item wins if a label is duplicated, as in a linear search.
+  for (int I = G->n_labels - 1; I > 0; --I) {
+    const Label &L = G->labels[I];
+    if (L.string && L.type == static_cast<int>(Symbol::NAME)) {
+      KeywordLabels[Identifier::get(L.string)] = I;
+    } else if (L.string) {
+      uint32_t Key = getOperatorKey(L.string, std::strlen(L.string));
+      assert(Key && "Operator too long");
+      OperatorLabels[Key] = I;
+    } else if (TokenInfo::IsTerminal(static_cast<Symbol>(L.type))) {
+      TokenLabels[L.type] = I;
+    }
+  }
+
+  int NumStates = 0;
+  for (int I = 0; I < G->n_dfas; ++I) {
+    const DFA *D = G->dfas[I];
+    std::vector<bool> First(G->n_labels);
+    for (int J = 0; J < D->n_first; ++J)
+      First[D->first[J]] = true;
+    FirstSets.push_back(std::move(First));
+    DFABase.push_back(NumStates);
+    NumStates += D->n_states;
+  }
+
+  Actions.resize(NumStates * G->n_labels);
+  for (int I = 0; I < G->n_dfas; ++I)
+    ComputeActions(I);
+}
+
+void GrammarTables::ComputeActions(int DFAIndex) {
+  const DFA *D = TheGrammar->dfas[DFAIndex];
+  int NumLabels = TheGrammar->n_labels;
+
+  for (int S = 0; S < D->n_states; ++S) {
+    const DFAState &State = D->states[S];
+    ParseAction *Row = &Actions[(DFABase[DFAIndex] + S) * NumLabels];
+    ParseAction Fallback{State.is_final ? ParseAction::Pop : ParseAction::Error,
+                         0, 0};
+    std::fill(Row, Row + NumLabels, Fallback);
+
+    // Arcs are tried in order, so an earlier arc takes precedence over a
+    // later one accepting the same label. Filling in from the last arc
+    // gets that for free.
+    for (int I = State.n_arcs - 1; I >= 0; --I) {
+      const Arc &A = State.arcs[I];
+      int Ty = TheGrammar->labels[A.label].type;
+      if (TokenInfo::IsTerminal(static_cast<Symbol>(Ty))) {
+        Row[A.label] = ParseAction{ParseAction::Shift, A.state, 0};
+        continue;
+      }
+      const auto &First = FirstSets[Ty - NT_OFFSET];
+      for (int L = 0; L < NumLabels; ++L) {
+        if (First[L])
+          Row[L] = ParseAction{ParseAction::Push, A.state, Ty};
+      }
+    }
+  }
+}
+
+uint32_t GrammarTables::getOperatorKey(const char *Data, size_t Length) {
+  if (!Data || Length == 0 || Length > sizeof(uint32_t))
+    return 0;
+  uint32_t Key = 0;
+  for (size_t I = 0; I < Length; ++I)
+    Key = (Key << 8) | static_cast<unsigned char>(Data[I]);
+  return Key;
+}
+
+int GrammarTables::Classify(const TokenInfo &T) const {
+  // look for a keyword or operator first.
+  if (T.getType() == Symbol::NAME) {
+    auto Iter = KeywordLabels.find(T.getIdentifier());
+    if (Iter != KeywordLabels.end())
+      return Iter->second;
+  } else if (T.getType() == Symbol::OP) {
+    // The chars are looked up in place, without making a string.
+    uint32_t Key = getOperatorKey(T.getData(), T.getLength());
+    auto Iter = OperatorLabels.find(Key);
+    if (Key && Iter != OperatorLabels.end())
+      return Iter->second;
+  }
+  // look for an ordinary token.
+  return TokenLabels[static_cast<int>(T.getType())];
+}
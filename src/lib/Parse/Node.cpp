@@ -2,15 +2,9 @@
 #include "simplecc/Lex/TokenInfo.h"
 #include "simplecc/Support/ErrorManager.h"
 #include <simplecc/Parse/ParseTreePrinter.h>
-#include <algorithm> // for_each
-#include <memory>    // default_delete
 
 using namespace simplecc;
 
-Node::~Node() {
-  std::for_each(Children.begin(), Children.end(), std::default_delete<Node>());
-}
-
 void Node::Format(std::ostream &O) const { ParseTreePrinter(O).Print(*this); }
 
 void Node::dump() const {
@@ -18,6 +12,3 @@ void Node::dump() const {
 }
 
 const char *Node::getTypeName() const { return TokenInfo::getSymbolName(Type); }
-
-Node::Node(Symbol Ty, std::string Val, Location L)
-    : Type(Ty), Value(std::move(Val)), Children(), Loc(L) {}
\ No newline at end of file
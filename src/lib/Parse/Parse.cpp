@@ -2,18 +2,51 @@
 #include "simplecc/Parse/ASTBuilder.h"
 #include "simplecc/Parse/Parser.h"
 
+using namespace simplecc;
+
+/// Build the AST while parsing Input, which is either a vector of tokens
+/// or a Lexer.
+template <typename InputT>
+static std::unique_ptr<ProgramAST, DeleteAST>
+BuildASTWhileParsing(const std::string &Filename, InputT &Input,
+                     size_t *NumCSTNodes = nullptr) {
+  // Build the AST of each declaration as soon as it is parsed, so that
+  // the CST of the whole program is never materialized.
+  Parser P(&CompilerGrammar);
+  ASTBuilder Builder;
+  std::vector<DeclAST *> Decls;
+  P.setTopLevelHandler(
+      [&Builder, &Decls](const Node *N) { Builder.BuildDecl(N, Decls); });
+
+  auto Tree = P.ParseTokens(Input);
+  if (!Tree) {
+    DeleteAST::apply(Decls);
+    return nullptr;
+  }
+  if (NumCSTNodes)
+    *NumCSTNodes = Tree->getNumNodes();
+  return Builder.Build(Filename, std::move(Decls));
+}
+
 namespace simplecc {
-std::unique_ptr<Node> BuildCST(const std::vector<TokenInfo> &TheTokens) {
+std::unique_ptr<ParseTree> BuildCST(const std::vector<TokenInfo> &TheTokens) {
   Parser P(&CompilerGrammar);
   return P.ParseTokens(TheTokens);
 }
 
+std::unique_ptr<ParseTree> BuildCST(Lexer &TheLexer) {
+  Parser P(&CompilerGrammar);
+  return P.ParseTokens(TheLexer);
+}
+
 std::unique_ptr<ProgramAST, DeleteAST>
 BuildAST(const std::string &Filename, const std::vector<TokenInfo> &TheTokens) {
-  auto CST = BuildCST(TheTokens);
-  if (!CST)
-    return nullptr;
-  return ASTBuilder().Build(Filename, CST.get());
+  return BuildASTWhileParsing(Filename, TheTokens);
+}
+
+std::unique_ptr<ProgramAST, DeleteAST>
+BuildAST(const std::string &Filename, Lexer &TheLexer, size_t *NumCSTNodes) {
+  return BuildASTWhileParsing(Filename, TheLexer, NumCSTNodes);
 }
 
-} // namespace simplecc
\ No newline at end of file
+} // namespace simplecc
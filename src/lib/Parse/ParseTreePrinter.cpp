@@ -40,7 +40,7 @@ void ParseTreePrinter::printNonTerminalNode(const Node &N) {
 }
 
 /// Print a list of Nodes, each on its own line with indent.
-void ParseTreePrinter::printNodeList(const Node::ChildrenListType &NodeList) {
+void ParseTreePrinter::printNodeList(Node::ChildrenListType NodeList) {
   for (auto I = NodeList.begin(), E = NodeList.end(); I != E; ++I) {
     printIndent();
     printNode(*(*I));
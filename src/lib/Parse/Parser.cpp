@@ -1,80 +1,81 @@
 #include "simplecc/Parse/Parser.h"
 #include "simplecc/Parse/Node.h"
-#include <algorithm> // find_if()
-#include <iterator> // next()
+#include <algorithm> // copy()
 
 using namespace simplecc;
 
-Parser::Parser(const Grammar *G) : TheStack(), TheGrammar(G), EM("SyntaxError") {
+Parser::Parser(const Grammar *G)
+    : TheStack(), TheGrammar(G), TheTables(GrammarTables::get(G)),
+      TheTree(new ParseTree()), PendingChildren(), Handler(),
+      EM("SyntaxError") {
   auto Start = G->start;
-  Node *Root = new Node(static_cast<Symbol>(Start), "", Location(0, 0));
-  TheStack.push(StackEntry(G->dfas[Start - NT_OFFSET], 0, Root));
+  Node *Root = TheTree->CreateNode(static_cast<Symbol>(Start), nullptr, 0,
+                                   Location(0, 0));
+  TheStack.push(StackEntry(G->dfas[Start - NT_OFFSET], Start - NT_OFFSET, 0,
+                           Root, 0));
 }
 
 bool Parser::IsAcceptOnlyState(const DFAState *State) {
   return State->is_final && State->n_arcs == 1;
 }
 
-bool Parser::IsInFirstSet(const DFA *D, int Label) {
-  auto end = D->first + D->n_first;
-  return std::find(D->first, end, Label) != end;
-}
-
-int Parser::Classify(Symbol Type, const std::string &Value) {
-  // the first label item is for the empty label.
-  const auto LabelBegin = TheGrammar->labels;
-  const auto LabelEnd = TheGrammar->labels + TheGrammar->n_labels;
-
-  // Convert an iterator to an offset(index).
-  auto ToIndex = [LabelBegin](decltype(LabelBegin) Iter) {
-    return int(Iter - LabelBegin);
-  };
-
-  // look for a keyword or operator first.
-  if (Type == Symbol::NAME || Type == Symbol::OP) {
-    auto Iter = std::find_if(std::next(LabelBegin), LabelEnd,
-                             [&Value](const Label &L) { return L.string && L.string == Value; });
-    if (Iter != LabelEnd) {
-      // the index of the label item is the label value for this token.
-      return ToIndex(Iter);
-    }
-  }
-
-  // look for an ordinary token.
-  auto Iter = std::find_if(std::next(LabelBegin), LabelEnd,
-                           [Type](const Label &L) { return static_cast<int>(Type) == L.type && !L.string; });
-  if (Iter != LabelEnd) {
-    return ToIndex(Iter);
-  }
-
-  // failure.
-  return -1;
-}
-
 void Parser::Shift(const TokenInfo &T, int NewState) {
-  StackEntry &Top = TheStack.top();
-  Top.getNode()->AddChild(
-      new Node(T.getType(), T.getString(), T.getLocation()));
-  Top.setState(NewState);
+  Node *N;
+  if (T.getType() == Symbol::NAME) {
+    // The value of a NAME is its lower-cased Identifier.
+    Identifier Id = T.getIdentifier();
+    N = TheTree->CreateNode(T.getType(), Id.c_str(), Id.size(),
+                            T.getLocation(), Id);
+  } else {
+    N = TheTree->CreateNode(T.getType(), T.getData(), T.getLength(),
+                            T.getLocation());
+  }
+  PendingChildren.push_back(N);
+  TheStack.top().setState(NewState);
 }
 
-void Parser::Push(Symbol Ty, const DFA *NewDFA, int NewState, Location Loc) {
+void Parser::Push(Symbol Ty, int NewState, Location Loc) {
   StackEntry &Top = TheStack.top();
   Top.setState(NewState);
-  Node *NewNode = new Node(Ty, "", Loc);
-  TheStack.push(StackEntry(NewDFA, /* State */ 0, NewNode));
+  Node *NewNode = TheTree->CreateNode(Ty, nullptr, 0, Loc);
+  int Index = static_cast<int>(Ty) - NT_OFFSET;
+  TheStack.push(StackEntry(TheGrammar->dfas[Index], Index, /* State */ 0,
+                           NewNode, PendingChildren.size()));
 }
 
 void Parser::Pop() {
   StackEntry Top = TheStack.top();
   TheStack.pop();
   Node *NewNode = Top.getNode();
+
+  auto Begin = PendingChildren.begin() + Top.getChildrenBegin();
+  unsigned NumChildren = PendingChildren.end() - Begin;
+  Node **Children = TheTree->getAllocator().Allocate<Node *>(NumChildren);
+  std::copy(Begin, PendingChildren.end(), Children);
+  NewNode->setChildren(Children, NumChildren);
+  PendingChildren.erase(Begin, PendingChildren.end());
+
   if (TheStack.empty()) {
     // we are done.
-    RootNode = NewNode;
+    TheTree->setRoot(NewNode);
+    return;
+  }
+  if (Handler && TheStack.size() == 1) {
+    Handler(NewNode);
+    RecycleTree();
     return;
   }
-  TheStack.top().getNode()->AddChild(NewNode);
+  PendingChildren.push_back(NewNode);
+}
+
+void Parser::RecycleTree() {
+  // Terminals attached to the root still live in the arena.
+  if (!PendingChildren.empty())
+    return;
+  TheTree->getAllocator().Rewind();
+  Node *Root = TheTree->CreateNode(static_cast<Symbol>(TheGrammar->start),
+                                   nullptr, 0, Location(0, 0));
+  TheStack.top().setNode(Root);
 }
 
 int Parser::AddToken(const TokenInfo &T) {
@@ -85,7 +86,7 @@ int Parser::AddToken(const TokenInfo &T) {
   }
 
   // classify the token into label value.
-  auto Label = Classify(T.getType(), T.getString());
+  auto Label = TheTables.Classify(T);
   if (Label < 0) {
     EM.Error(T.getLocation(), "unexpected token", T.getString());
     return -1;
@@ -94,55 +95,45 @@ int Parser::AddToken(const TokenInfo &T) {
   // loop until we are done.
   while (true) {
     StackEntry &Top = TheStack.top();
-    const DFA *D = Top.getDFA();
-    DFAState *States = D->states;
-    DFAState *TheState = &States[Top.getState()];
-    bool Flag = true;
-
-    for (int I = 0; I < TheState->n_arcs; ++I) {
-      Arc &arc = TheState->arcs[I];
-      auto Ty = static_cast<Symbol>(TheGrammar->labels[arc.label].type);
-      int NewState = arc.state;
-
-      if (Label == arc.label) {
-        Shift(T, NewState);
-
-        while (IsAcceptOnlyState(&States[NewState])) {
-          Pop();
-          if (TheStack.empty()) {
-            return true;
-          }
-          NewState = TheStack.top().getState();
-          States = TheStack.top().getDFA()->states;
-        }
-        return false;
-
-      } else if (TokenInfo::IsNonTerminal(Ty)) {
-        DFA *NewDFA = TheGrammar->dfas[static_cast<int>(Ty) - NT_OFFSET];
-        if (IsInFirstSet(NewDFA, Label)) {
-          Push(Ty, NewDFA, NewState, T.getLocation());
-          Flag = false;
-          break;
-        }
-      }
-    }
+    const ParseAction &Action =
+        TheTables.getAction(Top.getDFAIndex(), Top.getState(), Label);
 
-    if (Flag) {
-      if (TheState->is_final) {
+    switch (Action.Kind) {
+    case ParseAction::Shift: {
+      int NewState = Action.NewState;
+      const DFAState *States = Top.getDFA()->states;
+      Shift(T, NewState);
+
+      while (IsAcceptOnlyState(&States[NewState])) {
         Pop();
         if (TheStack.empty()) {
-          EM.Error(T.getLocation(), "too much input");
-          return -1;
+          return true;
         }
-      } else {
-        EM.Error(T.getLocation(), "unexpected", T.getLine());
+        NewState = TheStack.top().getState();
+        States = TheStack.top().getDFA()->states;
+      }
+      return false;
+    }
+    case ParseAction::Push:
+      Push(static_cast<Symbol>(Action.NonTerminal), Action.NewState,
+           T.getLocation());
+      break;
+    case ParseAction::Pop:
+      Pop();
+      if (TheStack.empty()) {
+        EM.Error(T.getLocation(), "too much input");
         return -1;
       }
+      break;
+    case ParseAction::Error:
+      EM.Error(T.getLocation(), "unexpected", T.getLine());
+      return -1;
     }
   }
 }
 
-std::unique_ptr<Node> Parser::ParseTokens(const std::vector<TokenInfo> &Tokens) {
+std::unique_ptr<ParseTree>
+Parser::ParseTokens(const std::vector<TokenInfo> &Tokens) {
   for (const auto &T : Tokens) {
     auto RC = AddToken(T);
     // error happened.
@@ -151,9 +142,7 @@ std::unique_ptr<Node> Parser::ParseTokens(const std::vector<TokenInfo> &Tokens)
     }
     // all tokens parsed successfully.
     if (RC == 1) {
-      assert(RootNode && "RootNode cannot be null!");
-      // ownership handled to caller.
-      return std::unique_ptr<Node>(RootNode);
+      return TakeTree();
     }
     // continue...
   }
@@ -163,6 +152,30 @@ std::unique_ptr<Node> Parser::ParseTokens(const std::vector<TokenInfo> &Tokens)
   return nullptr;
 }
 
+std::unique_ptr<ParseTree> Parser::ParseTokens(Lexer &L) {
+  while (true) {
+    TokenInfo T = L.Lex();
+    auto RC = AddToken(T);
+    if (RC < 0) {
+      return nullptr;
+    }
+    if (RC == 1) {
+      return TakeTree();
+    }
+    // the Lexer keeps returning ENDMARKER, don't wait for more.
+    if (T.getType() == Symbol::ENDMARKER) {
+      EM.Error(T.getLocation(), "incomplete input");
+      return nullptr;
+    }
+  }
+}
+
+std::unique_ptr<ParseTree> Parser::TakeTree() {
+  assert(TheTree->getRoot() && "RootNode cannot be null!");
+  // ownership handled to caller.
+  return std::move(TheTree);
+}
+
 void Parser::StackEntry::Format(std::ostream &O) const {
   Print(O, "state:", TheState);
   Print(O, "dfa:", TheDFA->name);
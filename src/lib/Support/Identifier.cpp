@@ -0,0 +1,152 @@
+#include "simplecc/Support/Identifier.h"
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace simplecc;
+
+const detail::IdentifierEntry detail::EmptyIdentifierEntry{0, 0, ""};
+
+namespace {
+/// This class interns the spelling of Identifiers.
+/// It is an open addressing hash table probed linearly, so that a lookup
+/// hashes the chars in place instead of building a ``std::string``.
+class IdentifierTable {
+public:
+  static IdentifierTable &get() {
+    static IdentifierTable TheTable;
+    return TheTable;
+  }
+
+  const detail::IdentifierEntry *Intern(const char *Data, size_t Length);
+
+  /// Return the entry of an ID. Any thread that has an Identifier of the
+  /// ID has seen the slot written, so this needs no lock.
+  const detail::IdentifierEntry *getByID(unsigned ID) const {
+    if (ID == 0)
+      return &detail::EmptyIdentifierEntry;
+    unsigned Index = ID - 1;
+    unsigned Segment = 0;
+    while (Index >= (SegmentSize << Segment)) {
+      Index -= SegmentSize << Segment;
+      ++Segment;
+    }
+    return Segments[Segment][Index];
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Entries.size();
+  }
+
+private:
+  IdentifierTable() : Buckets(InitialBuckets, nullptr) {}
+  ~IdentifierTable() {
+    for (const detail::IdentifierEntry **Segment : Segments)
+      delete[] Segment;
+  }
+
+  static unsigned Hash(const char *Data, size_t Length) {
+    // FNV-1a.
+    unsigned H = 2166136261u;
+    for (size_t I = 0; I < Length; ++I) {
+      H ^= static_cast<unsigned char>(Data[I]);
+      H *= 16777619u;
+    }
+    return H;
+  }
+
+  /// Double the number of buckets and rehash all the entries.
+  void Grow();
+
+  /// Put a new entry in the segment of its ID.
+  void AddToSegments(const detail::IdentifierEntry *E);
+
+  static constexpr size_t InitialBuckets = 1024;
+  /// Segment I of the entries by ID holds SegmentSize << I of them.
+  static constexpr unsigned SegmentSize = 1024;
+  static constexpr unsigned NumSegments = 22;
+
+  mutable std::mutex Mutex;
+  /// The number of buckets is a power of two.
+  std::vector<detail::IdentifierEntry *> Buckets;
+  /// Entries are allocated one by one so they never move.
+  std::vector<std::unique_ptr<detail::IdentifierEntry>> Entries;
+  /// The entries by ID - 1 in segments that never move, so that they can be
+  /// read while more are added.
+  const detail::IdentifierEntry **Segments[NumSegments] = {};
+};
+} // namespace
+
+constexpr size_t IdentifierTable::InitialBuckets;
+constexpr unsigned IdentifierTable::SegmentSize;
+
+const detail::IdentifierEntry *IdentifierTable::Intern(const char *Data,
+                                                       size_t Length) {
+  if (Length == 0)
+    return &detail::EmptyIdentifierEntry;
+
+  unsigned H = Hash(Data, Length);
+  std::lock_guard<std::mutex> Lock(Mutex);
+  size_t Mask = Buckets.size() - 1;
+  for (size_t I = H & Mask;; I = (I + 1) & Mask) {
+    detail::IdentifierEntry *E = Buckets[I];
+    if (!E) {
+      // ID 0 is taken by the empty Identifier.
+      unsigned ID = static_cast<unsigned>(Entries.size()) + 1;
+      Entries.emplace_back(new detail::IdentifierEntry{
+          ID, H, std::string(Data, Length)});
+      E = Entries.back().get();
+      Buckets[I] = E;
+      AddToSegments(E);
+      // Keep the load factor under 1/2.
+      if (Entries.size() * 2 > Buckets.size())
+        Grow();
+      return E;
+    }
+    if (E->Hash == H && E->Name.size() == Length &&
+        std::memcmp(E->Name.data(), Data, Length) == 0)
+      return E;
+  }
+}
+
+void IdentifierTable::AddToSegments(const detail::IdentifierEntry *E) {
+  unsigned Index = E->ID - 1;
+  unsigned Segment = 0;
+  while (Index >= (SegmentSize << Segment)) {
+    Index -= SegmentSize << Segment;
+    ++Segment;
+  }
+  assert(Segment < NumSegments && "Too many Identifiers");
+  if (!Segments[Segment])
+    Segments[Segment] =
+        new const detail::IdentifierEntry *[SegmentSize << Segment];
+  Segments[Segment][Index] = E;
+}
+
+void IdentifierTable::Grow() {
+  std::vector<detail::IdentifierEntry *> NewBuckets(Buckets.size() * 2,
+                                                    nullptr);
+  size_t Mask = NewBuckets.size() - 1;
+  for (const auto &E : Entries) {
+    size_t I = E->Hash & Mask;
+    while (NewBuckets[I])
+      I = (I + 1) & Mask;
+    NewBuckets[I] = E.get();
+  }
+  Buckets.swap(NewBuckets);
+}
+
+Identifier Identifier::get(const char *Data, size_t Length) {
+  return Identifier(IdentifierTable::get().Intern(Data, Length));
+}
+
+Identifier Identifier::getByID(unsigned ID) {
+  return Identifier(IdentifierTable::get().getByID(ID));
+}
+
+size_t Identifier::getNumIdentifiers() {
+  return IdentifierTable::get().size();
+}
@@ -0,0 +1,108 @@
+#include "simplecc/Support/ThreadPool.h"
+#include "simplecc/Support/TimeReport.h"
+#include <cassert>
+
+using namespace simplecc;
+
+namespace {
+/// The pool and the index of the queue of the current worker thread.
+thread_local ThreadPool *CurrentPool = nullptr;
+thread_local unsigned CurrentIndex = 0;
+} // namespace
+
+unsigned ThreadPool::getHardwareConcurrency() {
+  unsigned N = std::thread::hardware_concurrency();
+  return N ? N : 1;
+}
+
+ThreadPool::ThreadPool(unsigned NumThreads) {
+  if (NumThreads == 0)
+    NumThreads = getHardwareConcurrency();
+  for (unsigned I = 0; I < NumThreads; ++I)
+    Queues.emplace_back(new WorkQueue);
+  for (unsigned I = 0; I < NumThreads; ++I)
+    Workers.emplace_back([this, I]() { Run(I); });
+}
+
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stopping = true;
+  }
+  WorkAvailable.notify_all();
+  for (std::thread &T : Workers)
+    T.join();
+}
+
+void ThreadPool::async(TaskTy Task) {
+  unsigned Index;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    // Count it first so that a worker taking it never sees it uncounted.
+    ++Queued;
+    ++Pending;
+    if (CurrentPool == this) {
+      Index = CurrentIndex;
+    } else {
+      Index = NextQueue;
+      NextQueue = (NextQueue + 1) % Queues.size();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> Lock(Queues[Index]->Mutex);
+    Queues[Index]->Tasks.push_back(std::move(Task));
+  }
+  WorkAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+  assert(CurrentPool != this && "wait() called from a task");
+  std::unique_lock<std::mutex> Lock(Mutex);
+  AllDone.wait(Lock, [this]() { return Pending == 0; });
+}
+
+bool ThreadPool::PopTask(unsigned Index, TaskTy &Task) {
+  unsigned N = static_cast<unsigned>(Queues.size());
+  for (unsigned I = 0; I < N; ++I) {
+    WorkQueue &Q = *Queues[(Index + I) % N];
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      continue;
+    // Take the newest of our own tasks and the oldest of the others.
+    if (I == 0) {
+      Task = std::move(Q.Tasks.back());
+      Q.Tasks.pop_back();
+    } else {
+      Task = std::move(Q.Tasks.front());
+      Q.Tasks.pop_front();
+    }
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::Run(unsigned Index) {
+  CurrentPool = this;
+  CurrentIndex = Index;
+  for (;;) {
+    TaskTy Task;
+    if (PopTask(Index, Task)) {
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        --Queued;
+      }
+      Task();
+      // Before the task is done, so that wait() sees its allocations.
+      flushThreadAllocations();
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (--Pending == 0)
+        AllDone.notify_all();
+      continue;
+    }
+    std::unique_lock<std::mutex> Lock(Mutex);
+    WorkAvailable.wait(Lock, [this]() { return Stopping || Queued != 0; });
+    if (Stopping && Queued == 0)
+      return;
+  }
+}
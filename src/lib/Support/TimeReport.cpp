@@ -0,0 +1,156 @@
+#include "simplecc/Support/TimeReport.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace simplecc;
+
+namespace {
+/// The allocations the threads have flushed.
+std::atomic<size_t> NumFlushedAllocations(0);
+
+/// Return the peak resident set size in kilobytes.
+long getPeakRSS() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage Usage;
+  if (getrusage(RUSAGE_SELF, &Usage))
+    return 0;
+#if defined(__APPLE__)
+  // Bytes on macOS.
+  return Usage.ru_maxrss / 1024;
+#else
+  return Usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+/// Write S as a JSON string.
+void PrintJSONString(std::ostream &O, const std::string &S) {
+  O << '"';
+  for (char C : S) {
+    if (C == '"' || C == '\\')
+      O << '\\';
+    O << C;
+  }
+  O << '"';
+}
+} // namespace
+
+thread_local size_t simplecc::NumThreadAllocations = 0;
+
+void simplecc::flushThreadAllocations() {
+  if (!NumThreadAllocations)
+    return;
+  NumFlushedAllocations.fetch_add(NumThreadAllocations,
+                                  std::memory_order_relaxed);
+  NumThreadAllocations = 0;
+}
+
+size_t simplecc::getNumAllocations() {
+  return NumFlushedAllocations.load(std::memory_order_relaxed) +
+         NumThreadAllocations;
+}
+
+TimeRecord TimeRecord::getCurrentTime() {
+  using namespace std::chrono;
+  TimeRecord R;
+  R.WallTime =
+      duration<double>(steady_clock::now().time_since_epoch()).count();
+  R.CPUTime = static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+  R.PeakRSS = getPeakRSS();
+  R.NumAllocations = getNumAllocations();
+  return R;
+}
+
+TimeRecord TimeRecord::since(const TimeRecord &Start) const {
+  TimeRecord R;
+  R.WallTime = WallTime - Start.WallTime;
+  R.CPUTime = CPUTime - Start.CPUTime;
+  R.PeakRSS = PeakRSS - Start.PeakRSS;
+  R.NumAllocations = NumAllocations - Start.NumAllocations;
+  return R;
+}
+
+unsigned TimeReport::startRegion(std::string Name) {
+  unsigned Index = static_cast<unsigned>(Regions.size());
+  Regions.push_back(Region{std::move(Name),
+                           static_cast<unsigned>(Running.size()),
+                           TimeRecord(),
+                           {}});
+  // Take the time last so that the bookkeeping is not counted.
+  Running.emplace_back(Index, TimeRecord::getCurrentTime());
+  return Index;
+}
+
+void TimeReport::stopRegion(unsigned Index) {
+  TimeRecord Now = TimeRecord::getCurrentTime();
+  assert(!Running.empty() && Running.back().first == Index &&
+         "Regions must be stopped in reverse order");
+  Regions[Index].Time = Now.since(Running.back().second);
+  Running.pop_back();
+}
+
+void TimeReport::addCount(unsigned Index, std::string Name, size_t Value) {
+  assert(Index < Regions.size() && "Index out of range");
+  Regions[Index].Counts.emplace_back(std::move(Name), Value);
+}
+
+void TimeReport::PrintText(std::ostream &O) const {
+  O << "===" << std::string(73, '-') << "===\n"
+    << std::string(29, ' ') << "simplecc time report\n"
+    << "===" << std::string(73, '-') << "===\n";
+  O << std::right << std::setw(10) << "Wall(s)" << std::setw(10) << "CPU(s)"
+    << std::setw(12) << "PeakRSS+KB" << std::setw(12) << "Allocs"
+    << "  Name\n";
+  for (const Region &R : Regions) {
+    O << std::fixed << std::setprecision(4) << std::setw(10)
+      << R.Time.WallTime << std::setw(10) << R.Time.CPUTime << std::setw(12)
+      << R.Time.PeakRSS << std::setw(12) << R.Time.NumAllocations << "  "
+      << std::string(2 * R.Depth, ' ') << R.Name;
+    const char *Sep = " (";
+    for (const auto &Count : R.Counts) {
+      O << Sep << Count.first << ": " << Count.second;
+      Sep = ", ";
+    }
+    if (!R.Counts.empty())
+      O << ")";
+    O << "\n";
+  }
+}
+
+void TimeReport::PrintJSON(std::ostream &O) const {
+  O << "{\"regions\": [";
+  const char *Sep = "\n";
+  for (const Region &R : Regions) {
+    O << Sep << "  {\"name\": ";
+    PrintJSONString(O, R.Name);
+    O << ", \"depth\": " << R.Depth << std::fixed << std::setprecision(6)
+      << ", \"wall_time\": " << R.Time.WallTime
+      << ", \"cpu_time\": " << R.Time.CPUTime
+      << ", \"peak_rss_delta_kb\": " << R.Time.PeakRSS
+      << ", \"allocations\": " << R.Time.NumAllocations << ", \"counts\": {";
+    const char *CountSep = "";
+    for (const auto &Count : R.Counts) {
+      O << CountSep;
+      PrintJSONString(O, Count.first);
+      O << ": " << Count.second;
+      CountSep = ", ";
+    }
+    O << "}}";
+    Sep = ",\n";
+  }
+  O << "\n]}\n";
+}
+
+void TimeReport::clear() {
+  Regions.clear();
+  Running.clear();
+}
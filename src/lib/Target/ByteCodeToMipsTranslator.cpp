@@ -1,5 +1,6 @@
 #include "simplecc/Target/ByteCodeToMipsTranslator.h"
 #include "simplecc/Target/LocalContext.h"
+#include <cstdint>
 
 using namespace simplecc;
 
@@ -210,8 +211,7 @@ void ByteCodeToMipsTranslator::visitBinaryJumpIf(const char *Op,
 
 /// ByteCodeToMipsTranslator::Wrap OpcodeDispatcher::dispatch() to provide label
 /// generation.
-void ByteCodeToMipsTranslator::Write(const ByteCode &C) {
-  unsigned Off = C.getByteCodeOffset();
+void ByteCodeToMipsTranslator::Write(const ByteCode &C, unsigned Off) {
   /// If this is a JumpTarget, emit a label.
   if (TheContext.IsJumpTarget(Off)) {
     WriteLine(JumpTargetLabel(TheContext.getFuncName(), Off, /* NeedColon */ true));
@@ -245,3 +245,68 @@ void ByteCodeToMipsTranslator::visitJumpIfLess(const ByteCode &C) {
 void ByteCodeToMipsTranslator::visitJumpIfLessEqual(const ByteCode &C) {
   visitBinaryJumpIf("ble", C);
 }
+
+// Add a constant to $t0, taking $t1 if it needs more than 16 bits.
+void ByteCodeToMipsTranslator::AddConst(int Val) {
+  if (Val >= INT16_MIN && Val <= INT16_MAX) {
+    WriteLine("addiu $t0, $t0,", Val);
+    return;
+  }
+  WriteLine("li $t1,", Val);
+  WriteLine("addu $t0, $t0, $t1");
+}
+
+void ByteCodeToMipsTranslator::visitPrintStringLiteral(const ByteCode &C) {
+  AsciizLabel AL(C.getIntOperand(), /* NeedColon */ false);
+  WriteLine("la $a0,", AL);
+  WriteLine("li $v0,", MipsSyscallCode::PRINT_STRING);
+  WriteLine("syscall");
+}
+
+void ByteCodeToMipsTranslator::visitStoreLocalConst(const ByteCode &C) {
+  auto offset = TheContext.getLocalOffset(C.getStrOperand());
+  WriteLine("li $t0,", C.getConstOperand());
+  WriteLine("sw $t0,", offset, "($fp)");
+}
+
+void ByteCodeToMipsTranslator::visitIncrementLocal(const ByteCode &C) {
+  auto offset = TheContext.getLocalOffset(C.getStrOperand());
+  WriteLine("lw $t0,", offset, "($fp)");
+  AddConst(C.getConstOperand());
+  WriteLine("sw $t0,", offset, "($fp)");
+}
+
+void ByteCodeToMipsTranslator::visitAddLocalConst(const ByteCode &C) {
+  auto offset = TheContext.getLocalOffset(C.getStrOperand());
+  WriteLine("lw $t0,", offset, "($fp)");
+  AddConst(C.getConstOperand());
+  PUSH("$t0");
+}
+
+void ByteCodeToMipsTranslator::visitBinaryJumpIfConst(const char *Op,
+                                                      const ByteCode &C) {
+  POP("$t1"); // TOS
+  WriteLine("li $t0,", C.getConstOperand());
+  JumpTargetLabel Label(TheContext.getFuncName(), C.getIntOperand(),
+                        /* NeedColon */ false);
+  WriteLine(Op, "$t1, $t0,", Label);
+}
+
+void ByteCodeToMipsTranslator::visitJumpIfEqualConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("beq", C);
+}
+void ByteCodeToMipsTranslator::visitJumpIfNotEqualConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("bne", C);
+}
+void ByteCodeToMipsTranslator::visitJumpIfGreaterConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("bgt", C);
+}
+void ByteCodeToMipsTranslator::visitJumpIfGreaterEqualConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("bge", C);
+}
+void ByteCodeToMipsTranslator::visitJumpIfLessConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("blt", C);
+}
+void ByteCodeToMipsTranslator::visitJumpIfLessEqualConst(const ByteCode &C) {
+  visitBinaryJumpIfConst("ble", C);
+}
@@ -0,0 +1,392 @@
+#include "simplecc/Target/IRToMipsTranslator.h"
+#include "simplecc/IR/IRFunction.h"
+
+#include <algorithm>
+
+using namespace simplecc;
+
+namespace {
+/// A memory operand Off(Base).
+struct MemOperand {
+  int Off;
+  const char *Base;
+};
+
+inline std::ostream &operator<<(std::ostream &O, const MemOperand &M) {
+  return O << M.Off << "(" << M.Base << ")";
+}
+
+/// Return if Val fits the 16-bit immediate of an instruction.
+inline bool FitsImmediate(int64_t Val) { return Val >= -32768 && Val <= 32767; }
+
+/// Return the branch instruction of a condition.
+const char *getBranchName(IRInstruction::Condition Cond) {
+  static const char *const Names[] = {"beq", "bne", "bgt",
+                                      "bge", "blt", "ble"};
+  return Names[Cond];
+}
+
+/// Return log2(Val) if Val is a power of 2, or -1.
+int getLog2(int Val) {
+  if (Val <= 0 || (Val & (Val - 1)))
+    return -1;
+  int N = 0;
+  while (Val >>= 1)
+    ++N;
+  return N;
+}
+} // namespace
+
+JumpTargetLabel IRToMipsTranslator::getBlockLabel(unsigned B,
+                                                  bool NeedColon) const {
+  return JumpTargetLabel(TheFunction->getName(), B, NeedColon);
+}
+
+void IRToMipsTranslator::Write(const IRFunction &F) {
+  TheFunction = &F;
+  TheAllocator.Allocate(F);
+  ComputeFrame();
+  WritePrologue();
+  for (unsigned B = 0, E = F.getNumBlocks(); B < E; ++B)
+    WriteBlock(B);
+  WriteEpilogue();
+}
+
+void IRToMipsTranslator::ComputeFrame() {
+  unsigned MaxOutArgs = 0;
+  SavesRA = false;
+  for (const IRBasicBlock &BB : *TheFunction) {
+    for (const IRInstruction &I : BB) {
+      if (I.getOpcode() != IRInstruction::Call)
+        continue;
+      SavesRA = true;
+      MaxOutArgs = std::max(MaxOutArgs, I.getNumOperands());
+    }
+  }
+
+  int Offset = BytesFromEntries(MaxOutArgs);
+  SpillBase = Offset;
+  Offset += BytesFromEntries(TheAllocator.getNumSpillSlots());
+  ArrayOffsets.clear();
+  for (const IRFunction::LocalArray &A : TheFunction->getLocalArrays()) {
+    ArrayOffsets.emplace(A.Name, Offset);
+    Offset += BytesFromEntries(A.Size);
+  }
+  SavedBase = Offset;
+  Offset += BytesFromEntries(TheAllocator.getUsedSavedRegisters().size());
+  if (SavesRA)
+    Offset += BytesFromEntries(1);
+  FrameSize = Offset;
+}
+
+void IRToMipsTranslator::WritePrologue() {
+  WriteLine(GlobalLabel(TheFunction->getName(), /* NeedColon */ true));
+  WriteLine("# Prologue");
+  if (FrameSize)
+    AddImmediate("$sp", "$sp", -FrameSize);
+  if (SavesRA)
+    WriteInstr("sw", "$ra", MemOperand{FrameSize - 4, "$sp"});
+  int Off = SavedBase;
+  for (const char *Reg : TheAllocator.getUsedSavedRegisters()) {
+    WriteInstr("sw", Reg, MemOperand{Off, "$sp"});
+    Off += 4;
+  }
+  // Load the arguments that live in registers.
+  const RegisterSet &LiveIn = TheAllocator.getLiveness().getLiveIn(0);
+  for (unsigned I = 0, E = TheFunction->getNumArguments(); I < E; ++I) {
+    const char *Reg = TheAllocator.getRegister(I);
+    if (Reg && LiveIn.test(I))
+      WriteInstr("lw", Reg, MemOperand{getSpillOffset(I), "$sp"});
+  }
+  WriteLine();
+}
+
+void IRToMipsTranslator::WriteEpilogue() {
+  WriteLine("# Epilogue");
+  WriteLine(ReturnLabel(TheFunction->getName(), /* NeedColon */ true));
+  int Off = SavedBase;
+  for (const char *Reg : TheAllocator.getUsedSavedRegisters()) {
+    WriteInstr("lw", Reg, MemOperand{Off, "$sp"});
+    Off += 4;
+  }
+  if (SavesRA)
+    WriteInstr("lw", "$ra", MemOperand{FrameSize - 4, "$sp"});
+  if (FrameSize)
+    AddImmediate("$sp", "$sp", FrameSize);
+  WriteInstr("jr", "$ra");
+}
+
+int IRToMipsTranslator::getSpillOffset(unsigned Reg) const {
+  if (Reg < TheFunction->getNumArguments())
+    return FrameSize + BytesFromEntries(Reg);
+  return SpillBase + BytesFromEntries(TheAllocator.getSpillSlot(Reg));
+}
+
+const char *IRToMipsTranslator::getOperand(const IROperand &Op,
+                                           const char *Scratch) {
+  if (Op.IsImmediate()) {
+    if (Op.getImmediate() == 0)
+      return "$zero";
+    WriteInstr("li", Scratch, Op.getImmediate());
+    return Scratch;
+  }
+  unsigned Reg = Op.getRegister();
+  if (const char *R = TheAllocator.getRegister(Reg))
+    return R;
+  // Never defined, so any value does.
+  if (!TheAllocator.IsSpilled(Reg))
+    return "$zero";
+  WriteInstr("lw", Scratch, MemOperand{getSpillOffset(Reg), "$sp"});
+  return Scratch;
+}
+
+void IRToMipsTranslator::LoadOperand(const char *Dst, const IROperand &Op) {
+  if (Op.IsImmediate()) {
+    WriteInstr("li", Dst, Op.getImmediate());
+    return;
+  }
+  const char *Src = getOperand(Op, Dst);
+  if (Src != Dst)
+    WriteInstr("move", Dst, Src);
+}
+
+const char *IRToMipsTranslator::getDest(const IRInstruction &I) {
+  const char *R = TheAllocator.getRegister(I.getDest());
+  return R ? R : "$t0";
+}
+
+void IRToMipsTranslator::StoreDest(const IRInstruction &I) {
+  if (TheAllocator.IsSpilled(I.getDest()))
+    WriteInstr("sw", "$t0", MemOperand{getSpillOffset(I.getDest()), "$sp"});
+}
+
+void IRToMipsTranslator::AddImmediate(const char *Dst, const char *Src,
+                                      int Val) {
+  if (FitsImmediate(Val)) {
+    WriteInstr("addiu", Dst, Src, Val);
+    return;
+  }
+  WriteInstr("li", "$t1", Val);
+  WriteInstr("addu", Dst, Src, "$t1");
+}
+
+void IRToMipsTranslator::WriteBlock(unsigned B) {
+  NextBlock = B + 1;
+  WriteLine(getBlockLabel(B, /* NeedColon */ true));
+  for (const IRInstruction &I : TheFunction->getBlock(B)) {
+    if (I.getOpcode() == IRInstruction::Branch)
+      WriteBranch(I);
+    else
+      WriteInstruction(I);
+  }
+}
+
+void IRToMipsTranslator::WriteBranch(const IRInstruction &I) {
+  IRInstruction::Condition Cond = I.getCondition();
+  IROperand A = I.getOperand(0), Op2 = I.getOperand(1);
+  unsigned True = I.getTarget(0), False = I.getTarget(1);
+  if (A.IsImmediate() && Op2.IsImmediate()) {
+    unsigned Target = IRInstruction::Evaluate(Cond, A.getImmediate(),
+                                              Op2.getImmediate())
+                          ? True
+                          : False;
+    if (Target != NextBlock)
+      WriteInstr("j", getBlockLabel(Target, /* NeedColon */ false));
+    return;
+  }
+  // Keep an immediate on the right.
+  if (A.IsImmediate()) {
+    std::swap(A, Op2);
+    Cond = IRInstruction::getSwapped(Cond);
+  }
+  // Fall through to the next block if it is a target.
+  if (True == NextBlock) {
+    std::swap(True, False);
+    Cond = IRInstruction::getInverse(Cond);
+  }
+  const char *RA = getOperand(A, "$t0");
+  const char *RB = getOperand(Op2, "$t1");
+  WriteInstr(getBranchName(Cond), RA, RB,
+             getBlockLabel(True, /* NeedColon */ false));
+  if (False != NextBlock)
+    WriteInstr("j", getBlockLabel(False, /* NeedColon */ false));
+}
+
+void IRToMipsTranslator::WriteInstruction(const IRInstruction &I) {
+  using IR = IRInstruction;
+  switch (I.getOpcode()) {
+  case IR::Copy: {
+    const IROperand &Src = I.getOperand(0);
+    if (TheAllocator.IsSpilled(I.getDest())) {
+      WriteInstr("sw", getOperand(Src, "$t0"),
+                 MemOperand{getSpillOffset(I.getDest()), "$sp"});
+      return;
+    }
+    if (const char *Dst = TheAllocator.getRegister(I.getDest()))
+      LoadOperand(Dst, Src);
+    return;
+  }
+
+  case IR::Add:
+  case IR::Sub: {
+    IROperand A = I.getOperand(0), B = I.getOperand(1);
+    const char *Dst = getDest(I);
+    if (A.IsImmediate() && B.IsImmediate()) {
+      int64_t Val = I.getOpcode() == IR::Add
+                        ? int64_t(A.getImmediate()) + B.getImmediate()
+                        : int64_t(A.getImmediate()) - B.getImmediate();
+      WriteInstr("li", Dst, static_cast<int>(static_cast<uint32_t>(Val)));
+    } else if (I.getOpcode() == IR::Add && A.IsImmediate()) {
+      AddImmediate(Dst, getOperand(B, "$t0"), A.getImmediate());
+    } else if (B.IsImmediate()) {
+      int64_t Val = I.getOpcode() == IR::Add ? int64_t(B.getImmediate())
+                                             : -int64_t(B.getImmediate());
+      if (FitsImmediate(Val))
+        AddImmediate(Dst, getOperand(A, "$t0"), static_cast<int>(Val));
+      else
+        WriteInstr(I.getOpcode() == IR::Add ? "addu" : "subu", Dst,
+                   getOperand(A, "$t0"), getOperand(B, "$t1"));
+    } else {
+      const char *RA = getOperand(A, "$t0");
+      const char *RB = getOperand(B, "$t1");
+      WriteInstr(I.getOpcode() == IR::Add ? "addu" : "subu", Dst, RA, RB);
+    }
+    StoreDest(I);
+    return;
+  }
+
+  case IR::Mul:
+  case IR::Div: {
+    IROperand A = I.getOperand(0), B = I.getOperand(1);
+    const char *Dst = getDest(I);
+    if (I.getOpcode() == IR::Mul && A.IsImmediate())
+      std::swap(A, B);
+    int Shift = I.getOpcode() == IR::Mul && B.IsImmediate()
+                    ? getLog2(B.getImmediate())
+                    : -1;
+    if (Shift >= 0 && !A.IsImmediate()) {
+      WriteInstr("sll", Dst, getOperand(A, "$t0"), Shift);
+    } else {
+      const char *RA = getOperand(A, "$t0");
+      const char *RB = getOperand(B, "$t1");
+      WriteInstr(I.getOpcode() == IR::Mul ? "mul" : "div", Dst, RA, RB);
+    }
+    StoreDest(I);
+    return;
+  }
+
+  case IR::Neg: {
+    const char *Dst = getDest(I);
+    WriteInstr("subu", Dst, "$zero", getOperand(I.getOperand(0), "$t0"));
+    StoreDest(I);
+    return;
+  }
+
+  case IR::LoadGlobal:
+    WriteInstr("lw", getDest(I),
+               GlobalLabel(I.getName(), /* NeedColon */ false));
+    StoreDest(I);
+    return;
+  case IR::StoreGlobal:
+    WriteInstr("sw", getOperand(I.getOperand(0), "$t0"),
+               GlobalLabel(I.getName(), /* NeedColon */ false));
+    return;
+  case IR::GlobalAddress:
+    WriteInstr("la", getDest(I),
+               GlobalLabel(I.getName(), /* NeedColon */ false));
+    StoreDest(I);
+    return;
+  case IR::LocalAddress:
+    AddImmediate(getDest(I), "$sp", ArrayOffsets[I.getName()]);
+    StoreDest(I);
+    return;
+
+  case IR::LoadElement:
+  case IR::StoreElement: {
+    const IROperand &Index = I.getOperand(1);
+    const char *Val = I.getOpcode() == IR::StoreElement
+                          ? getOperand(I.getOperand(2), "$v1")
+                          : getDest(I);
+    const char *Base = getOperand(I.getOperand(0), "$t0");
+    const char *Op = I.getOpcode() == IR::StoreElement ? "sw" : "lw";
+    if (Index.IsImmediate() &&
+        FitsImmediate(BytesFromEntries(int64_t(Index.getImmediate())))) {
+      WriteInstr(Op, Val,
+                 MemOperand{BytesFromEntries(Index.getImmediate()), Base});
+    } else {
+      WriteInstr("sll", "$t1", getOperand(Index, "$t1"), "2");
+      WriteInstr("addu", "$t1", Base, "$t1");
+      WriteInstr(Op, Val, MemOperand{0, "$t1"});
+    }
+    if (I.getOpcode() == IR::LoadElement)
+      StoreDest(I);
+    return;
+  }
+
+  case IR::Call: {
+    for (unsigned Arg = 0, E = I.getNumOperands(); Arg < E; ++Arg)
+      WriteInstr("sw", getOperand(I.getOperand(Arg), "$t0"),
+                 MemOperand{BytesFromEntries(Arg), "$sp"});
+    WriteInstr("jal", GlobalLabel(I.getName(), /* NeedColon */ false));
+    if (!I.HasDest())
+      return;
+    if (TheAllocator.IsSpilled(I.getDest()))
+      WriteInstr("sw", "$v0", MemOperand{getSpillOffset(I.getDest()), "$sp"});
+    else if (const char *Dst = TheAllocator.getRegister(I.getDest()))
+      WriteInstr("move", Dst, "$v0");
+    return;
+  }
+
+  case IR::ReadInteger:
+  case IR::ReadCharacter: {
+    WriteInstr("li", "$v0",
+               I.getOpcode() == IR::ReadInteger
+                   ? MipsSyscallCode::READ_INTEGER
+                   : MipsSyscallCode::READ_CHARACTER);
+    WriteInstr("syscall");
+    if (TheAllocator.IsSpilled(I.getDest()))
+      WriteInstr("sw", "$v0", MemOperand{getSpillOffset(I.getDest()), "$sp"});
+    else if (const char *Dst = TheAllocator.getRegister(I.getDest()))
+      WriteInstr("move", Dst, "$v0");
+    return;
+  }
+
+  case IR::PrintString:
+    WriteInstr("la", "$a0",
+               AsciizLabel(I.getOperand(0).getImmediate(),
+                           /* NeedColon */ false));
+    WriteInstr("li", "$v0", MipsSyscallCode::PRINT_STRING);
+    WriteInstr("syscall");
+    return;
+  case IR::PrintCharacter:
+  case IR::PrintInteger:
+    LoadOperand("$a0", I.getOperand(0));
+    WriteInstr("li", "$v0",
+               I.getOpcode() == IR::PrintInteger
+                   ? MipsSyscallCode::PRINT_INTEGER
+                   : MipsSyscallCode::PRINT_CHARACTER);
+    WriteInstr("syscall");
+    return;
+  case IR::PrintNewline:
+    WriteInstr("li", "$a0", static_cast<int>('\n'));
+    WriteInstr("li", "$v0", MipsSyscallCode::PRINT_CHARACTER);
+    WriteInstr("syscall");
+    return;
+
+  case IR::Jump:
+    if (I.getTarget(0) != NextBlock)
+      WriteInstr("j", getBlockLabel(I.getTarget(0), /* NeedColon */ false));
+    return;
+  case IR::Return:
+    if (I.getNumOperands())
+      LoadOperand("$v0", I.getOperand(0));
+    // The epilogue follows the last block.
+    if (NextBlock != TheFunction->getNumBlocks())
+      WriteInstr("j",
+                 ReturnLabel(TheFunction->getName(), /* NeedColon */ false));
+    return;
+  case IR::Branch:
+    assert(false && "Branch is written by WriteBranch()");
+    return;
+  }
+}
@@ -45,22 +45,22 @@ void LocalContext::InitializeJumpTargets() {
 }
 
 // Return the offset of local name related to frame pointer
-signed int LocalContext::getLocalOffset(const char *Name) const {
+signed int LocalContext::getLocalOffset(Identifier Name) const {
   assert(LocalOffsets.count(Name) && "Undefined Name");
   return LocalOffsets.find(Name)->second;
 }
 
 // Return whether a name is a variable
-bool LocalContext::IsVariable(const char *Name) const {
+bool LocalContext::IsVariable(Identifier Name) const {
   return TheFunction->getLocalTable()[Name].IsVariable();
 }
 
 // Return whether a name is an array
-bool LocalContext::IsArray(const char *Name) const {
+bool LocalContext::IsArray(Identifier Name) const {
   return TheFunction->getLocalTable()[Name].IsArray();
 }
 
-const std::string &LocalContext::getFuncName() const {
+Identifier LocalContext::getFuncName() const {
   return TheFunction->getName();
 }
 
@@ -2,9 +2,15 @@
 #include "simplecc/Analysis/Types.h" // SymbolEntry
 #include "simplecc/CodeGen/ByteCodeFunction.h"
 #include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/IR/IRModule.h"
+#include "simplecc/Support/ThreadPool.h"
 #include "simplecc/Target/ByteCodeToMipsTranslator.h"
+#include "simplecc/Target/IRToMipsTranslator.h"
 
 #include <numeric> // accumulate()
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace simplecc;
 
@@ -24,9 +30,35 @@ void MipsAssemblyWriter::WriteData(Printer &W, const ByteCodeModule &Module) {
   W.WriteLine();
   W.WriteLine("# String literals");
 
-  for (const auto &Item : Module.getStringLiteralTable()) {
-    W.WriteLine(AsciizLabel(Item.second, /* NeedColon */ true), ".asciiz",
-                EscapedString(Item.first));
+  const std::vector<std::string> &Strings = Module.getStringLiterals();
+  for (unsigned I = 0, E = Strings.size(); I < E; ++I) {
+    W.WriteLine(AsciizLabel(I, /* NeedColon */ true), ".asciiz",
+                EscapedString(Strings[I]));
+  }
+
+  W.WriteLine("# End of data segment");
+}
+
+void MipsAssemblyWriter::WriteData(Printer &W, const IRModule &Module) {
+  W.WriteLine(".data");
+  W.WriteLine("# Global objects");
+
+  for (const IRModule::GlobalVariable &G : Module.getGlobalVariables()) {
+    GlobalLabel GL(G.Name, /* NeedColon */ true);
+    if (!G.IsArray()) {
+      W.WriteLine(GL, ".word", 0);
+      continue;
+    }
+    W.WriteLine(GL, ".space", BytesFromEntries(G.Size));
+  }
+
+  W.WriteLine();
+  W.WriteLine("# String literals");
+
+  const std::vector<std::string> &Strings = Module.getStringLiterals();
+  for (unsigned I = 0, E = Strings.size(); I < E; ++I) {
+    W.WriteLine(AsciizLabel(I, /* NeedColon */ true), ".asciiz",
+                EscapedString(Strings[I]));
   }
 
   W.WriteLine("# End of data segment");
@@ -51,13 +83,18 @@ void MipsAssemblyWriter::WriteFunction(Printer &W,
   ByteCodeToMipsTranslator TheTranslator(W.getOuts(), TheContext);
 
   WritePrologue(W, TheFunction);
-  for (const ByteCode &C : TheFunction) {
-    TheTranslator.Write(C);
+  for (unsigned I = 0, E = TheFunction.size(); I < E; ++I) {
+    TheTranslator.Write(TheFunction.getByteCodeAt(I), I);
   }
   WriteEpilogue(W, TheFunction);
 }
 
-void MipsAssemblyWriter::WriteText(Printer &W, const ByteCodeModule &Module) {
+void MipsAssemblyWriter::WriteFunction(Printer &W,
+                                       const IRFunction &TheFunction) {
+  IRToMipsTranslator(W.getOuts()).Write(TheFunction);
+}
+
+void MipsAssemblyWriter::WriteTextHeader(Printer &W) {
   W.WriteLine(".text");
   W.WriteLine(".globl main");
   W.WriteLine("jal main");
@@ -65,7 +102,10 @@ void MipsAssemblyWriter::WriteText(Printer &W, const ByteCodeModule &Module) {
   W.WriteLine("syscall");
   W.WriteLine();
   W.WriteLine("# User defined functions");
+}
 
+void MipsAssemblyWriter::WriteText(Printer &W, const ByteCodeModule &Module) {
+  WriteTextHeader(W);
   for (const ByteCodeFunction *Fn : Module) {
     WriteFunction(W, *Fn);
     W.WriteLine();
@@ -73,6 +113,56 @@ void MipsAssemblyWriter::WriteText(Printer &W, const ByteCodeModule &Module) {
   W.WriteLine("# End of text segment");
 }
 
+void MipsAssemblyWriter::WriteText(Printer &W, const ByteCodeModule &Module,
+                                   ThreadPool &Pool) {
+  WriteTextHeader(W);
+  // Each function is written by a writer of its own into a buffer,
+  // and the buffers are written out in order.
+  std::vector<std::string> Texts(Module.size());
+  for (unsigned I = 0, E = Module.size(); I < E; ++I) {
+    Pool.async([I, &Module, &Texts]() {
+      std::ostringstream O;
+      Printer TextPrinter(O);
+      MipsAssemblyWriter().WriteFunction(TextPrinter,
+                                         *Module.getFunctionList()[I]);
+      TextPrinter.WriteLine();
+      Texts[I] = O.str();
+    });
+  }
+  Pool.wait();
+  for (const std::string &Text : Texts)
+    W.getOuts() << Text;
+  W.WriteLine("# End of text segment");
+}
+
+void MipsAssemblyWriter::WriteText(Printer &W, const IRModule &Module) {
+  WriteTextHeader(W);
+  for (const auto &Fn : Module.getFunctionList()) {
+    WriteFunction(W, *Fn);
+    W.WriteLine();
+  }
+  W.WriteLine("# End of text segment");
+}
+
+void MipsAssemblyWriter::WriteText(Printer &W, const IRModule &Module,
+                                   ThreadPool &Pool) {
+  WriteTextHeader(W);
+  std::vector<std::string> Texts(Module.size());
+  for (unsigned I = 0, E = Module.size(); I < E; ++I) {
+    Pool.async([I, &Module, &Texts]() {
+      std::ostringstream O;
+      Printer TextPrinter(O);
+      MipsAssemblyWriter().WriteFunction(TextPrinter, Module.getFunction(I));
+      TextPrinter.WriteLine();
+      Texts[I] = O.str();
+    });
+  }
+  Pool.wait();
+  for (const std::string &Text : Texts)
+    W.getOuts() << Text;
+  W.WriteLine("# End of text segment");
+}
+
 void MipsAssemblyWriter::WritePrologue(Printer &W,
                                        const ByteCodeFunction &TheFunction) {
   W.WriteLine(GlobalLabel(TheFunction.getName(), /* NeedColon */ true));
@@ -125,4 +215,27 @@ void MipsAssemblyWriter::Write(const ByteCodeModule &M, std::ostream &O) {
   WriteData(ThePrinter, M);
   ThePrinter.WriteLine();
   WriteText(ThePrinter, M);
-}
\ No newline at end of file
+}
+
+void MipsAssemblyWriter::Write(const ByteCodeModule &M, std::ostream &O,
+                               ThreadPool &Pool) {
+  Printer ThePrinter(O);
+  WriteData(ThePrinter, M);
+  ThePrinter.WriteLine();
+  WriteText(ThePrinter, M, Pool);
+}
+
+void MipsAssemblyWriter::Write(const IRModule &M, std::ostream &O) {
+  Printer ThePrinter(O);
+  WriteData(ThePrinter, M);
+  ThePrinter.WriteLine();
+  WriteText(ThePrinter, M);
+}
+
+void MipsAssemblyWriter::Write(const IRModule &M, std::ostream &O,
+                               ThreadPool &Pool) {
+  Printer ThePrinter(O);
+  WriteData(ThePrinter, M);
+  ThePrinter.WriteLine();
+  WriteText(ThePrinter, M, Pool);
+}
@@ -0,0 +1,143 @@
+#include "simplecc/Target/MipsRegisterAllocator.h"
+#include "simplecc/IR/IRFunction.h"
+
+#include <algorithm>
+#include <climits>
+
+using namespace simplecc;
+
+constexpr int MipsRegisterAllocator::NumSavedRegisters;
+constexpr int MipsRegisterAllocator::NumRegisters;
+constexpr int MipsRegisterAllocator::Spilled;
+constexpr int MipsRegisterAllocator::NoInterval;
+
+const char *MipsRegisterAllocator::getRegisterName(int Index) {
+  static const char *const Names[NumRegisters] = {
+      "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+      "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$t8", "$t9"};
+  return Names[Index];
+}
+
+void MipsRegisterAllocator::BuildIntervals(const IRFunction &F) {
+  unsigned N = F.getNumRegisters();
+  std::vector<int> Start(N, INT_MAX), End(N, -1);
+  auto Extend = [&Start, &End](unsigned Reg, int Pos) {
+    Start[Reg] = std::min(Start[Reg], Pos);
+    End[Reg] = std::max(End[Reg], Pos);
+  };
+
+  // Instruction I uses its operands at 2I and defines its Dest at 2I + 1,
+  // so an operand that dies there can share a register with the Dest.
+  std::vector<int> Calls;
+  int Pos = 0;
+  for (unsigned B = 0, E = F.getNumBlocks(); B < E; ++B) {
+    const IRBasicBlock &BB = F.getBlock(B);
+    int From = 2 * Pos;
+    int To = 2 * (Pos + static_cast<int>(BB.size())) - 1;
+    TheLiveness.getLiveIn(B).forEach(
+        [&Extend, From](unsigned Reg) { Extend(Reg, From); });
+    TheLiveness.getLiveOut(B).forEach(
+        [&Extend, To](unsigned Reg) { Extend(Reg, To); });
+    for (const IRInstruction &I : BB) {
+      for (unsigned Op = 0, NumOps = I.getNumOperands(); Op < NumOps; ++Op) {
+        if (I.getOperand(Op).IsRegister())
+          Extend(I.getOperand(Op).getRegister(), 2 * Pos);
+      }
+      if (I.HasDest())
+        Extend(I.getDest(), 2 * Pos + 1);
+      if (I.getOpcode() == IRInstruction::Call)
+        Calls.push_back(2 * Pos);
+      ++Pos;
+    }
+  }
+
+  Intervals.clear();
+  for (unsigned Reg = 0; Reg < N; ++Reg) {
+    if (End[Reg] < 0)
+      continue;
+    // A call in between clobbers the temporary registers.
+    auto Call = std::upper_bound(Calls.begin(), Calls.end(), Start[Reg]);
+    bool CrossesCall = Call != Calls.end() && *Call + 1 < End[Reg];
+    Intervals.push_back(Interval{Reg, Start[Reg], End[Reg], CrossesCall});
+  }
+  std::stable_sort(Intervals.begin(), Intervals.end(),
+                   [](const Interval &L, const Interval &R) {
+                     return L.Start < R.Start;
+                   });
+}
+
+void MipsRegisterAllocator::Spill(const Interval &I) {
+  Assigned[I.Reg] = Spilled;
+  // An argument is spilled to where it is passed.
+  if (I.Reg >= NumArguments)
+    SpillSlots[I.Reg] = NumSpillSlots++;
+}
+
+void MipsRegisterAllocator::Allocate(const IRFunction &F) {
+  TheLiveness.Compute(F);
+  BuildIntervals(F);
+  Assigned.assign(F.getNumRegisters(), NoInterval);
+  SpillSlots.assign(F.getNumRegisters(), 0);
+  NumSpillSlots = 0;
+  NumArguments = F.getNumArguments();
+  UsedSavedRegisters.clear();
+
+  bool IsFree[NumRegisters];
+  std::fill(IsFree, IsFree + NumRegisters, true);
+  bool IsSavedUsed[NumSavedRegisters] = {};
+  std::vector<const Interval *> Active;
+
+  for (const Interval &Cur : Intervals) {
+    // Free the registers of the intervals that have ended.
+    auto Ended = std::remove_if(
+        Active.begin(), Active.end(), [&Cur, &IsFree, this](const Interval *I) {
+          if (I->End >= Cur.Start)
+            return false;
+          IsFree[Assigned[I->Reg]] = true;
+          return true;
+        });
+    Active.erase(Ended, Active.end());
+
+    // Prefer a temporary register unless a call is in the way.
+    int Reg = -1;
+    if (!Cur.CrossesCall) {
+      for (int R = NumSavedRegisters; R < NumRegisters && Reg < 0; ++R) {
+        if (IsFree[R])
+          Reg = R;
+      }
+    }
+    for (int R = 0; R < NumSavedRegisters && Reg < 0; ++R) {
+      if (IsFree[R])
+        Reg = R;
+    }
+
+    if (Reg < 0) {
+      // Spill the one that ends last among those Cur could take over.
+      auto Victim = Active.end();
+      for (auto I = Active.begin(), E = Active.end(); I != E; ++I) {
+        if (Cur.CrossesCall && Assigned[(*I)->Reg] >= NumSavedRegisters)
+          continue;
+        if (Victim == Active.end() || (*I)->End > (*Victim)->End)
+          Victim = I;
+      }
+      if (Victim == Active.end() || (*Victim)->End <= Cur.End) {
+        Spill(Cur);
+        continue;
+      }
+      Reg = Assigned[(*Victim)->Reg];
+      Spill(**Victim);
+      Active.erase(Victim);
+    }
+
+    Assigned[Cur.Reg] = Reg;
+    IsFree[Reg] = false;
+    if (Reg < NumSavedRegisters)
+      IsSavedUsed[Reg] = true;
+    Active.push_back(&Cur);
+  }
+
+  for (int R = 0; R < NumSavedRegisters; ++R) {
+    if (IsSavedUsed[R])
+      UsedSavedRegisters.push_back(getRegisterName(R));
+  }
+}
@@ -6,4 +6,16 @@ void AssembleMips(const ByteCodeModule &M, std::ostream &O) {
   MipsAssemblyWriter().Write(M, O);
 }
 
+void AssembleMips(const ByteCodeModule &M, std::ostream &O, ThreadPool &Pool) {
+  MipsAssemblyWriter().Write(M, O, Pool);
+}
+
+void AssembleMips(const IRModule &M, std::ostream &O) {
+  MipsAssemblyWriter().Write(M, O);
+}
+
+void AssembleMips(const IRModule &M, std::ostream &O, ThreadPool &Pool) {
+  MipsAssemblyWriter().Write(M, O, Pool);
+}
+
 } // namespace simplecc
@@ -1,10 +1,15 @@
 #include "simplecc/Transform/Transform.h"
 #include "simplecc/Transform/DeadCodeEliminator.h"
 #include "simplecc/Transform/TrivialConstantFolder.h"
+#include "simplecc/Support/TimeReport.h"
 
 namespace simplecc {
-void TransformProgram(ProgramAST *P, SymbolTable &S) {
-  TrivialConstantFolder().Transform(P, S);
+void TransformProgram(ProgramAST *P, SymbolTable &S, TimeReport *Report) {
+  {
+    TimeRegion R(Report, "TrivialConstantFolder");
+    TrivialConstantFolder().Transform(P, S);
+  }
+  TimeRegion R(Report, "DeadCodeEliminator");
   DeadCodeEliminator().Transform(P);
 }
 
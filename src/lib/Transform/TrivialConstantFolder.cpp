@@ -21,18 +21,18 @@ ExprAST *TrivialConstantFolder::FoldBinOpExpr(BinOpExpr *B) {
             static_cast<NameExpr *>(R)->getName()) {
       switch (B->getOp()) {
         // Case-1-1: X - X == 0
-      case BinaryOpKind::Sub:return new NumExpr(0, B->getLocation());
+      case BinaryOpKind::Sub:return new (*TheContext) NumExpr(0, B->getLocation());
         // Case-1-2: Since X might be zero, which will cause a ZeroDivisor, we
         // lose an opportunity.
       case BinaryOpKind::Div:return B;
         // Case-1-3: X == X == 1, X >= X == 1, X <= X == 1
       case BinaryOpKind::GtE:
       case BinaryOpKind::LtE: // Fall through
-      case BinaryOpKind::Eq:return new NumExpr(1, B->getLocation());
+      case BinaryOpKind::Eq:return new (*TheContext) NumExpr(1, B->getLocation());
         // Case-1-4: X != X == 0, X < X == 0, X > X == 0
       case BinaryOpKind::Lt:
       case BinaryOpKind::Gt: // Fall through
-      case BinaryOpKind::NotEq:return new NumExpr(0, B->getLocation());
+      case BinaryOpKind::NotEq:return new (*TheContext) NumExpr(0, B->getLocation());
       default:return B;
       }
     }
@@ -52,9 +52,10 @@ ExprAST *TrivialConstantFolder::FoldBinOpExpr(BinOpExpr *B) {
     default:assert(false && "Unhandled Enum Value");
 #define HANDLE_OPERATOR(VAL, OP, FUNC)                                         \
   case BinaryOpKind::VAL:                                                      \
-    return new NumExpr(Compute(std::FUNC<int>(), L->getConstantValue(),        \
-                               R->getConstantValue()),                         \
-                       B->getLocation());
+    return new (*TheContext)                                                   \
+        NumExpr(Compute(std::FUNC<int>(), L->getConstantValue(),               \
+                        R->getConstantValue()),                                \
+                B->getLocation());
 #include "simplecc/AST/Enums.def"
     }
   }
@@ -71,7 +72,7 @@ ExprAST *TrivialConstantFolder::FoldBinOpExpr(BinOpExpr *B) {
   case BinaryOpKind::Sub:
     // 0 - X == -X
     if (L->isZeroVal())
-      return new UnaryOpExpr(
+      return new (*TheContext) UnaryOpExpr(
           UnaryOpKind::USub,
           (std::move(*B).getRight().release()),
           B->getLocation());
@@ -79,7 +80,7 @@ ExprAST *TrivialConstantFolder::FoldBinOpExpr(BinOpExpr *B) {
   case BinaryOpKind::Mult:
     // 0 * X == X * 0 == 0
     if (L->isZeroVal() || R->isZeroVal())
-      return new NumExpr(0, B->getLocation());
+      return new (*TheContext) NumExpr(0, B->getLocation());
     // 1 * X == X * 1 == X
     if (L->isOneVal())
       return std::move(*B).getRight().release();
@@ -105,7 +106,8 @@ ExprAST *TrivialConstantFolder::FoldUnaryOpExpr(UnaryOpExpr *U) {
   assert(U->getOp() == UnaryOpKind::USub);
   auto Operand = U->getOperand();
   if (Operand->isConstant()) {
-    return new NumExpr(-Operand->getConstantValue(), U->getLocation());
+    return new (*TheContext) NumExpr(-Operand->getConstantValue(),
+                                     U->getLocation());
   }
 
   // Case-3: fold double negate into noop, --X => X
@@ -123,14 +125,14 @@ ExprAST *TrivialConstantFolder::FoldParenExpr(ParenExpr *P) {
 }
 
 ExprAST *TrivialConstantFolder::FoldNameExpr(NameExpr *N) {
-  auto Entry = getSymbolEntry(N->getName());
+  auto Entry = getSymbolEntry(N);
   if (!Entry.IsConstant()) {
     return N;
   }
   auto CT = Entry.AsConstant();
   switch (CT.getType()) {
-  case BasicTypeKind::Int:return new NumExpr(CT.getValue(), N->getLocation());
-  case BasicTypeKind::Character:return new CharExpr(CT.getValue(), N->getLocation());
+  case BasicTypeKind::Int:return new (*TheContext) NumExpr(CT.getValue(), N->getLocation());
+  case BasicTypeKind::Character:return new (*TheContext) CharExpr(CT.getValue(), N->getLocation());
   default:assert(false && "Invalid Enum Value");
   }
 }
@@ -0,0 +1,42 @@
+#include "Testing.h"
+#include "simplecc/Support/BumpPtrAllocator.h"
+
+using namespace simplecc;
+
+/// Rewinding keeps the first slab and allocates from its start again.
+static void TestRewind() {
+  BumpPtrAllocator A;
+  A.Rewind();
+  EXPECT_EQ(0U, A.getNumSlabs());
+
+  void *First = A.Allocate(16, 8);
+  // Fill a few slabs and an oversized one.
+  for (unsigned I = 0; I < 3; ++I)
+    A.Allocate(40000, 8);
+  A.Allocate(1 << 20, 8);
+  EXPECT_EQ(4U, A.getNumSlabs());
+
+  A.Rewind();
+  EXPECT_EQ(1U, A.getNumSlabs());
+  EXPECT_EQ(0U, A.getBytesAllocated());
+  EXPECT_TRUE(A.Allocate(16, 8) == First);
+
+  A.Reset();
+  EXPECT_EQ(0U, A.getNumSlabs());
+}
+
+/// An oversized request does not end the current slab.
+static void TestOversized() {
+  BumpPtrAllocator A;
+  char *P = static_cast<char *>(A.Allocate(8, 8));
+  A.Allocate(1 << 20, 8);
+  char *Q = static_cast<char *>(A.Allocate(8, 8));
+  EXPECT_TRUE(Q == P + 8);
+  EXPECT_EQ(2U, A.getNumSlabs());
+}
+
+int main() {
+  TestRewind();
+  TestOversized();
+  return simplecc::testing::getNumFailures() != 0;
+}
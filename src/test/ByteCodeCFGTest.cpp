@@ -0,0 +1,69 @@
+#include "Testing.h"
+#include "simplecc/CodeGen/ByteCodeCFG.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include <vector>
+
+using namespace simplecc;
+
+/// Return a function of M with the code Codes.
+static ByteCodeFunction &MakeFunction(ByteCodeModule &M,
+                                      const std::vector<ByteCode> &Codes) {
+  ByteCodeFunction *F = ByteCodeFunction::Create(&M);
+  F->setName(Identifier::get("test"));
+  for (const ByteCode &C : Codes)
+    F->append(C, 1);
+  return *F;
+}
+
+/// The compiler ends each function with a return, so it never jumps to the
+/// end of the code. A ByteCodeFile may.
+static void TestJumpToEnd() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::JUMP_IF_FALSE, 5),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 1),
+                          ByteCode::Create(ByteCode::PRINT_INTEGER, 0),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 5),
+                      });
+  ByteCodeCFG CFG(F);
+  EXPECT_EQ(2U, CFG.getNumBlocks());
+  // Going to the end adds no edge.
+  EXPECT_EQ(1U, CFG.getBlock(0).Successors.size());
+  EXPECT_EQ(1U, CFG.getBlock(0).Successors[0]);
+  EXPECT_TRUE(CFG.getBlock(1).Successors.empty());
+  EXPECT_EQ(2U, CFG.getBlock(1).Begin);
+  EXPECT_EQ(5U, CFG.getBlock(1).End);
+  EXPECT_TRUE(CFG.Dominates(0, 1));
+  EXPECT_EQ(0U, CFG.getNumLoops());
+}
+
+/// A loop whose exit jumps to the end, followed by a block that cannot be
+/// reached.
+static void TestLoopToEnd() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::JUMP_IF_TRUE, 4),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  ByteCodeCFG CFG(F);
+  EXPECT_EQ(3U, CFG.getNumBlocks());
+  EXPECT_TRUE(CFG.IsReachable(1));
+  EXPECT_TRUE(!CFG.IsReachable(2));
+  EXPECT_TRUE(CFG.IsBackEdge(1, 0));
+  EXPECT_EQ(1U, CFG.getNumLoops());
+  EXPECT_EQ(0U, CFG.getLoop(0).Header);
+  EXPECT_EQ(1U, CFG.getLoopDepth(1));
+  EXPECT_EQ(0U, CFG.getLoopDepth(2));
+}
+
+int main() {
+  TestJumpToEnd();
+  TestLoopToEnd();
+  return simplecc::testing::getNumFailures() != 0;
+}
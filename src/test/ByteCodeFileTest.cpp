@@ -0,0 +1,146 @@
+#include "Testing.h"
+#include "simplecc/CodeGen/ByteCode.h"
+#include "simplecc/CodeGen/ByteCodeFile.h"
+#include "simplecc/Driver/Driver.h"
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+using namespace simplecc;
+
+/// The file emitted for the input, and where it is written as it is and as
+/// patched, which are not the same since the former stays mapped.
+static std::string Image;
+static std::string ImageFile;
+static std::string PatchedFile;
+
+/// Return the offset of a record in the file.
+static size_t getOffset(const ByteCodeFile &File, const void *Record) {
+  return static_cast<const char *>(Record) -
+         reinterpret_cast<const char *>(&File.getHeader());
+}
+
+/// Find the first code with Op in a file, setting its offset in the file.
+/// Return false if there is none.
+static bool FindCode(const ByteCodeFile &File, ByteCode::Opcode Op,
+                     size_t &Offset) {
+  for (size_t I = 0, E = File.getNumFunctions(); I < E; ++I) {
+    const ByteCodeFile::Function &F = File.getFunctions()[I];
+    const ByteCodeFile::Code *Codes = File.getCode(F);
+    for (uint32_t J = 0; J < F.NumCodes; ++J) {
+      if (Codes[J].Opcode == Op) {
+        Offset = getOffset(File, &Codes[J]);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// Open a copy of Image patched by Patch and return the diagnostics, or
+/// the empty string if it opens.
+static std::string
+OpenPatched(const std::function<void(std::string &)> &Patch) {
+  std::string Copy = Image;
+  Patch(Copy);
+  {
+    std::ofstream OS(PatchedFile, std::ios::out | std::ios::binary);
+    OS << Copy;
+  }
+  std::ostringstream Errs;
+  ErrsRedirect Redirect(Errs);
+  ByteCodeFile File;
+  if (!File.Open(PatchedFile))
+    return "";
+  std::string Str = Errs.str();
+  return Str.empty() ? "error" : Str;
+}
+
+/// Return if Str contains Part.
+static bool Contains(const std::string &Str, const char *Part) {
+  return Str.find(Part) != std::string::npos;
+}
+
+/// Set the field at Offset of a copy of the file.
+static void SetField(std::string &Copy, size_t Offset, int32_t Val) {
+  std::memcpy(&Copy[Offset], &Val, sizeof Val);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <input.c> <scratch-dir>\n";
+    return 1;
+  }
+  ImageFile = std::string(argv[2]) + "/ByteCodeFileTest.bc";
+  PatchedFile = std::string(argv[2]) + "/ByteCodeFileTest.patched.bc";
+
+  std::ostringstream Output;
+  Driver D;
+  D.setInputFile(argv[1]);
+  D.setOutputFile("-");
+  D.setStdOutput(&Output);
+  if (D.runCommand(Driver::CommandKind::EmitByteCode))
+    return 1;
+  Image = Output.str();
+  EXPECT_EQ("", OpenPatched([](std::string &) {}));
+
+  ByteCodeFile File;
+  {
+    std::ofstream OS(ImageFile, std::ios::out | std::ios::binary);
+    OS << Image;
+  }
+  if (File.Open(ImageFile))
+    return 1;
+  const ByteCodeFile::Header &H = File.getHeader();
+  // Where the fields of a Code are.
+  const size_t IntOperand = offsetof(ByteCodeFile::Code, IntOperand);
+  const size_t StrOperand = offsetof(ByteCodeFile::Code, StrOperand);
+  size_t Offset = 0;
+
+  // A local that is not defined.
+  EXPECT_TRUE(FindCode(File, ByteCode::LOAD_LOCAL, Offset));
+  uint32_t FunctionName = File.getFunctions()[0].Name;
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset + StrOperand, FunctionName);
+  }), "refers to undefined name"));
+
+  // A global that is not defined, or is an array stored to.
+  EXPECT_TRUE(FindCode(File, ByteCode::LOAD_GLOBAL, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset + StrOperand, FunctionName);
+  }), "refers to undefined name"));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset, ByteCode::STORE_GLOBAL);
+  }), "refers to undefined name"));
+
+  // A call with the wrong number of arguments.
+  EXPECT_TRUE(FindCode(File, ByteCode::CALL_FUNCTION, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset + IntOperand, 3);
+  }), "calls"));
+
+  // A string literal that is not defined.
+  EXPECT_TRUE(FindCode(File, ByteCode::LOAD_STRING, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset + IntOperand, H.NumStringLiterals);
+  }), "undefined string literal"));
+
+  // The operand stack popped when empty, or left with an operand at the
+  // end of a block.
+  EXPECT_TRUE(FindCode(File, ByteCode::STORE_LOCAL, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset, ByteCode::LOAD_CONST);
+  }), "is not empty at"));
+  EXPECT_TRUE(FindCode(File, ByteCode::LOAD_CONST, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset, ByteCode::POP_TOP);
+  }), "is popped when empty at"));
+  EXPECT_TRUE(FindCode(File, ByteCode::RETURN_NONE, Offset));
+  EXPECT_TRUE(Contains(OpenPatched([=](std::string &Copy) {
+    SetField(Copy, Offset, ByteCode::RETURN_VALUE);
+  }), "is popped when empty at"));
+
+  return simplecc::testing::getNumFailures() != 0;
+}
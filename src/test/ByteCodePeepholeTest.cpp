@@ -0,0 +1,238 @@
+#include "Testing.h"
+#include "simplecc/CodeGen/ByteCodeFunction.h"
+#include "simplecc/CodeGen/ByteCodeModule.h"
+#include "simplecc/CodeGen/ByteCodePeephole.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace simplecc;
+
+/// Return a function of M with the code Codes.
+static ByteCodeFunction &MakeFunction(ByteCodeModule &M,
+                                      const std::vector<ByteCode> &Codes) {
+  ByteCodeFunction *F = ByteCodeFunction::Create(&M);
+  F->setName(Identifier::get("test"));
+  for (const ByteCode &C : Codes)
+    F->append(C, 1);
+  return *F;
+}
+
+/// Return the code of F, one ByteCode a line with its operands.
+static std::string Dump(const ByteCodeFunction &F) {
+  std::ostringstream O;
+  for (const ByteCode &C : F) {
+    O << C.getOpcodeName();
+    if (C.HasStrOperand())
+      O << " " << C.getStrOperand();
+    if (C.HasIntOperand())
+      O << " " << C.getIntOperand();
+    O << "\n";
+  }
+  return O.str();
+}
+
+/// Return the options with every rewrite disabled.
+static PeepholeOptions NoRewrites() {
+  PeepholeOptions Opts;
+  Opts.ThreadJumps = false;
+  Opts.RemoveJumpsToNext = false;
+  Opts.RemoveIdentities = false;
+  Opts.RemoveDeadStores = false;
+  Opts.RemoveUnreachable = false;
+  return Opts;
+}
+
+static Identifier A() { return Identifier::get("a"); }
+static Identifier T() { return Identifier::get("t"); }
+
+static void TestThreadJumps() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::JUMP_IF_FALSE, 4),
+                          ByteCode::Create(ByteCode::PRINT_NEWLINE, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 5),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 6),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  PeepholeOptions Opts = NoRewrites();
+  Opts.ThreadJumps = true;
+  ByteCodePeephole P(Opts);
+  // Only the target changes, since nothing is removed.
+  EXPECT_TRUE(!P.Optimize(F));
+  EXPECT_EQ("LOAD_LOCAL a\n"
+            "JUMP_IF_FALSE 6\n"
+            "PRINT_NEWLINE 0\n"
+            "RETURN_NONE\n"
+            "JUMP_FORWARD 6\n"
+            "JUMP_FORWARD 6\n"
+            "RETURN_NONE\n",
+            Dump(F));
+}
+
+static void TestThreadJumpsCycle() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 1),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 0),
+                      });
+  PeepholeOptions Opts = NoRewrites();
+  Opts.ThreadJumps = true;
+  ByteCodePeephole P(Opts);
+  P.Optimize(F);
+  EXPECT_EQ("JUMP_FORWARD 1\n"
+            "JUMP_FORWARD 0\n",
+            Dump(F));
+}
+
+static void TestRemoveJumpsToNext() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::JUMP_IF_FALSE, 4),
+                          ByteCode::Create(ByteCode::PRINT_NEWLINE, 0),
+                          ByteCode::Create(ByteCode::JUMP_FORWARD, 4),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  ByteCodePeephole P;
+  EXPECT_TRUE(P.Optimize(F));
+  // The jump over the removed one is remapped.
+  EXPECT_EQ("LOAD_LOCAL a\n"
+            "JUMP_IF_FALSE 3\n"
+            "PRINT_NEWLINE 0\n"
+            "RETURN_NONE\n",
+            Dump(F));
+  EXPECT_EQ(1U, P.getNumRemoved());
+}
+
+static void TestRemoveIdentities() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::BINARY_ADD),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::BINARY_SUB),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 1),
+                          ByteCode::Create(ByteCode::BINARY_MULTIPLY),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 1),
+                          ByteCode::Create(ByteCode::BINARY_DIVIDE),
+                          ByteCode::Create(ByteCode::UNARY_POSITIVE),
+                          ByteCode::Create(ByteCode::PRINT_INTEGER, 0),
+                          // These change the value.
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::BINARY_SUB),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 0),
+                          ByteCode::Create(ByteCode::BINARY_MULTIPLY),
+                          ByteCode::Create(ByteCode::LOAD_CONST, 1),
+                          ByteCode::Create(ByteCode::BINARY_ADD),
+                          ByteCode::Create(ByteCode::RETURN_VALUE),
+                      });
+  ByteCodePeephole P;
+  EXPECT_TRUE(P.Optimize(F));
+  EXPECT_EQ("LOAD_LOCAL a\n"
+            "PRINT_INTEGER 0\n"
+            "LOAD_CONST 0\n"
+            "LOAD_LOCAL a\n"
+            "BINARY_SUB\n"
+            "LOAD_CONST 0\n"
+            "BINARY_MULTIPLY\n"
+            "LOAD_CONST 1\n"
+            "BINARY_ADD\n"
+            "RETURN_VALUE 0\n",
+            Dump(F));
+}
+
+static void TestRemoveDeadStores() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::STORE_LOCAL, T()),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, T()),
+                          ByteCode::Create(ByteCode::PRINT_INTEGER, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  ByteCodePeephole P;
+  EXPECT_TRUE(P.Optimize(F));
+  EXPECT_EQ("LOAD_LOCAL a\n"
+            "PRINT_INTEGER 0\n"
+            "RETURN_NONE\n",
+            Dump(F));
+}
+
+/// The store is kept if the variable is loaded again, later in the block or
+/// in a successor.
+static void TestKeepLiveStores() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::STORE_LOCAL, T()),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, T()),
+                          ByteCode::Create(ByteCode::JUMP_IF_FALSE, 6),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, T()),
+                          ByteCode::Create(ByteCode::PRINT_INTEGER, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  std::string Before = Dump(F);
+  ByteCodePeephole P;
+  EXPECT_TRUE(!P.Optimize(F));
+  EXPECT_EQ(Before, Dump(F));
+
+  ByteCodeFunction &G =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::STORE_LOCAL, T()),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, T()),
+                          ByteCode::Create(ByteCode::PRINT_INTEGER, 0),
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, T()),
+                          ByteCode::Create(ByteCode::RETURN_VALUE),
+                      });
+  Before = Dump(G);
+  EXPECT_TRUE(!P.Optimize(G));
+  EXPECT_EQ(Before, Dump(G));
+}
+
+static void TestRemoveUnreachable() {
+  ByteCodeModule M;
+  ByteCodeFunction &F =
+      MakeFunction(M, {
+                          ByteCode::Create(ByteCode::LOAD_LOCAL, A()),
+                          ByteCode::Create(ByteCode::JUMP_IF_FALSE, 5),
+                          ByteCode::Create(ByteCode::PRINT_NEWLINE, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                          ByteCode::Create(ByteCode::PRINT_NEWLINE, 0),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                          ByteCode::Create(ByteCode::RETURN_NONE),
+                      });
+  ByteCodePeephole P;
+  EXPECT_TRUE(P.Optimize(F));
+  EXPECT_EQ("LOAD_LOCAL a\n"
+            "JUMP_IF_FALSE 4\n"
+            "PRINT_NEWLINE 0\n"
+            "RETURN_NONE\n"
+            "RETURN_NONE\n",
+            Dump(F));
+  EXPECT_EQ(1U, P.getStats().size());
+  EXPECT_EQ(7U, P.getStats()[0].Before);
+  EXPECT_EQ(5U, P.getStats()[0].After);
+}
+
+int main() {
+  TestThreadJumps();
+  TestThreadJumpsCycle();
+  TestRemoveJumpsToNext();
+  TestRemoveIdentities();
+  TestRemoveDeadStores();
+  TestKeepLiveStores();
+  TestRemoveUnreachable();
+  return simplecc::testing::getNumFailures() != 0;
+}
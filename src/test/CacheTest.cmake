@@ -0,0 +1,85 @@
+# Run simplecc with a fresh cache more than once and check what the cache
+# does. Used as
+#
+#   cmake -DNAME=<test> -DSIMPLECC=<path> -DARGS=<arg|arg|...>
+#         -DMODE=<hit|corrupt|evict> -P CacheTest.cmake
+#
+# The output goes to the file NAME.out, and NAME.cache is the cache.
+#
+# - hit: the second run is a hit.
+# - corrupt: a truncated entry is a miss and is written again.
+# - evict: with a cache of size 0 the entry is evicted once stored.
+#
+# Every run must write what a run without the cache writes, byte for byte.
+
+if (NOT NAME OR NOT SIMPLECC OR NOT DEFINED ARGS OR NOT MODE)
+    message(FATAL_ERROR "NAME, SIMPLECC, ARGS and MODE are required")
+endif ()
+
+string(REPLACE "|" ";" ARGS "${ARGS}")
+set(CacheDir ${CMAKE_CURRENT_BINARY_DIR}/${NAME}.cache)
+set(OutputFile ${CMAKE_CURRENT_BINARY_DIR}/${NAME}.out)
+file(REMOVE_RECURSE ${CacheDir})
+
+# Run simplecc with ExtraArgs and set Out to the hex of its output, Status
+# to its exit status and Stats to what --cache-stats prints.
+function(run_simplecc ExtraArgs Out Status Stats)
+    file(REMOVE ${OutputFile})
+    execute_process(COMMAND ${SIMPLECC} ${ARGS} -o ${OutputFile} ${ExtraArgs}
+            OUTPUT_QUIET
+            ERROR_VARIABLE Errors
+            RESULT_VARIABLE Result)
+    set(Output)
+    if (EXISTS ${OutputFile})
+        file(READ ${OutputFile} Output HEX)
+    endif ()
+    string(REGEX MATCH "Cache: [^\n]*" CacheStats "${Errors}")
+    set(${Out} "${Output}" PARENT_SCOPE)
+    set(${Status} "${Result}" PARENT_SCOPE)
+    set(${Stats} "${CacheStats}" PARENT_SCOPE)
+endfunction()
+
+run_simplecc("" Expected ExpectedStatus Unused)
+
+# Run with the cache and check its output and stats.
+function(run_cached ExpectedStats)
+    run_simplecc("--cache-dir;${CacheDir};--cache-stats;${ARGN}"
+            Actual ActualStatus Stats)
+    if (NOT Stats MATCHES "${ExpectedStats}")
+        message(FATAL_ERROR "expected ${ExpectedStats}, got '${Stats}'")
+    endif ()
+    if (NOT ActualStatus STREQUAL ExpectedStatus OR
+            NOT Actual STREQUAL Expected)
+        message(FATAL_ERROR "the output with the cache differs after "
+                "'${Stats}'")
+    endif ()
+endfunction()
+
+if (MODE STREQUAL hit)
+    run_cached("0 hits, 1 misses")
+    run_cached("1 hits, 0 misses")
+elseif (MODE STREQUAL corrupt)
+    run_cached("0 hits, 1 misses")
+    file(GLOB Entries ${CacheDir}/*.entry)
+    if (NOT Entries)
+        message(FATAL_ERROR "no entry is stored")
+    endif ()
+    foreach (Entry ${Entries})
+        file(READ ${Entry} Text)
+        string(LENGTH "${Text}" Length)
+        math(EXPR Length "${Length} / 2")
+        string(SUBSTRING "${Text}" 0 ${Length} Text)
+        file(WRITE ${Entry} "${Text}")
+    endforeach ()
+    run_cached("0 hits, 1 misses")
+    run_cached("1 hits, 0 misses")
+elseif (MODE STREQUAL evict)
+    run_cached("0 hits, 1 misses, 1 evictions" --cache-size 0)
+    file(GLOB Entries ${CacheDir}/*.entry)
+    if (Entries)
+        message(FATAL_ERROR "${Entries} is not evicted")
+    endif ()
+    run_cached("0 hits, 1 misses, 1 evictions" --cache-size 0)
+else ()
+    message(FATAL_ERROR "unknown MODE ${MODE}")
+endif ()
@@ -0,0 +1,93 @@
+# Run simplecc and compare what it prints with a golden file, or with what it
+# prints given other arguments. Used as
+#
+#   cmake -DNAME=<test> -DSIMPLECC=<path> -DARGS=<arg|arg|...>
+#         [-DINPUT=<file>] [-DPIPE=ON] [-DEXPECTED=<file>] [-DEXPECTED_STATUS=<n>]
+#         [-DSKIP_LINES=<n>] [-DOTHER_ARGS=<arg|arg|...>] [-DMATCH=<regex>]
+#         [-DABSENT=<file>] -P RunTest.cmake
+#
+# The arguments are separated by | since a ; would split them on the way in.
+# stdout followed by stderr is compared, ignoring trailing white spaces.
+# With PIPE, INPUT is piped in rather than redirected, so stdin is a pipe.
+# SKIP_LINES drops the first lines of EXPECTED, like the header MARS prints.
+# With OTHER_ARGS the exit status is compared as well. MATCH is a regex the
+# output must match when it is not all known, and ABSENT is a file the run
+# must not leave.
+
+if (NOT NAME OR NOT SIMPLECC OR NOT DEFINED ARGS)
+    message(FATAL_ERROR "NAME, SIMPLECC and ARGS are required")
+endif ()
+
+# Run simplecc with Args and set Out and Status in the parent scope.
+function(run_simplecc Args Out Status)
+    string(REPLACE "|" ";" Args "${Args}")
+    set(Input)
+    set(Pipe)
+    if (INPUT AND PIPE)
+        set(Pipe COMMAND ${CMAKE_COMMAND} -E cat ${INPUT})
+    elseif (INPUT)
+        set(Input INPUT_FILE ${INPUT})
+    endif ()
+    execute_process(${Pipe}
+            COMMAND ${SIMPLECC} ${Args}
+            ${Input}
+            OUTPUT_VARIABLE Output
+            ERROR_VARIABLE Errors
+            RESULT_VARIABLE Result)
+    # The two are not interleaved as they are written.
+    set(Output "${Output}${Errors}")
+    string(REGEX REPLACE "[ \t\r\n]+$" "" Output "${Output}")
+    set(${Out} "${Output}" PARENT_SCOPE)
+    set(${Status} "${Result}" PARENT_SCOPE)
+endfunction()
+
+if (ABSENT AND EXISTS ${ABSENT})
+    file(REMOVE ${ABSENT})
+endif ()
+run_simplecc("${ARGS}" Actual ActualStatus)
+if (ABSENT AND EXISTS ${ABSENT})
+    message(FATAL_ERROR "${ABSENT} is written\n${Actual}")
+endif ()
+if (DEFINED EXPECTED_STATUS AND NOT ActualStatus STREQUAL EXPECTED_STATUS)
+    message(FATAL_ERROR "exit status ${ActualStatus}, "
+            "expected ${EXPECTED_STATUS}\n${Actual}")
+endif ()
+if (MATCH)
+    if (NOT Actual MATCHES "${MATCH}")
+        message(FATAL_ERROR "output does not match ${MATCH}\n${Actual}")
+    endif ()
+    return()
+endif ()
+
+if (DEFINED OTHER_ARGS)
+    run_simplecc("${OTHER_ARGS}" Expected ExpectedStatus)
+    if (NOT ActualStatus STREQUAL ExpectedStatus)
+        message(FATAL_ERROR "exit status ${ActualStatus} of ${ARGS} differs "
+                "from ${ExpectedStatus} of ${OTHER_ARGS}")
+    endif ()
+else ()
+    if (NOT EXPECTED)
+        message(FATAL_ERROR "one of EXPECTED, OTHER_ARGS and MATCH is required")
+    endif ()
+    file(READ ${EXPECTED} Expected)
+    if (SKIP_LINES)
+        foreach (I RANGE 1 ${SKIP_LINES})
+            string(FIND "${Expected}" "\n" NewLine)
+            if (NewLine EQUAL -1)
+                set(Expected "")
+            else ()
+                math(EXPR NewLine "${NewLine} + 1")
+                string(SUBSTRING "${Expected}" ${NewLine} -1 Expected)
+            endif ()
+        endforeach ()
+    endif ()
+    string(REGEX REPLACE "[ \t\r\n]+$" "" Expected "${Expected}")
+endif ()
+
+if (NOT Actual STREQUAL Expected)
+    # Both are kept in the working directory for a closer look.
+    file(WRITE ${NAME}.expected "${Expected}\n")
+    file(WRITE ${NAME}.actual "${Actual}\n")
+    message(FATAL_ERROR "output differs, see ${NAME}.expected and "
+            "${NAME}.actual\n${Actual}")
+endif ()
@@ -0,0 +1,35 @@
+#ifndef SIMPLECC_TEST_TESTING_H
+#define SIMPLECC_TEST_TESTING_H
+#include <iostream>
+
+/// The checks of the unit tests, each of which reports a failure with its
+/// location and goes on. A test returns getNumFailures() != 0 from main().
+
+namespace simplecc {
+namespace testing {
+/// Return the number of checks failed so far.
+inline unsigned &getNumFailures() {
+  static unsigned NumFailures = 0;
+  return NumFailures;
+}
+} // namespace testing
+} // namespace simplecc
+
+#define EXPECT_TRUE(Cond)                                                      \
+  do {                                                                         \
+    if (!(Cond)) {                                                             \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": expected " #Cond "\n";    \
+      ++simplecc::testing::getNumFailures();                                   \
+    }                                                                          \
+  } while (0)
+
+#define EXPECT_EQ(Expected, Actual)                                            \
+  do {                                                                         \
+    if (!((Expected) == (Actual))) {                                           \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": expected " #Actual        \
+                << " to be " << (Expected) << ", got " << (Actual) << "\n";    \
+      ++simplecc::testing::getNumFailures();                                   \
+    }                                                                          \
+  } while (0)
+
+#endif // SIMPLECC_TEST_TESTING_H